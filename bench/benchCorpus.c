@@ -0,0 +1,374 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/* Generator of the benchmark corpora: compactor input files of typical
+   read-only data, reproducible by fixed seeds. The names of the corpora
+   are written to the list file used by benchRun. 
+   usage: benchCorpus <directory> */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define BENCH_MAX_ARRAY_SIZE 4096
+/* size of the file of zeros for the large zero-filled regions */
+#define BENCH_ZERO_FILE_SIZE 4096
+
+typedef struct {
+  const char *pName;
+  /* generator of the arrays */
+  void (*pGenerate)(FILE *fp, unsigned long numberArrays, unsigned long size);
+  unsigned long numberArrays;
+  /* (maximal) array size */
+  unsigned long size;
+} tBenchCorpus;
+
+static unsigned long long benchRandomState;
+
+void benchSeed(unsigned long long seed){
+  benchRandomState = seed*0x9E3779B97F4A7C15ULL+1;
+}
+
+/* xorshift, the same numbers on every platform */
+unsigned long benchRandom(unsigned long range){
+  benchRandomState ^= benchRandomState<<13;
+  benchRandomState ^= benchRandomState>>7;
+  benchRandomState ^= benchRandomState<<17;
+  return (unsigned long)((benchRandomState>>16)%range);
+}
+
+void benchWriteBytes(FILE *fp, const unsigned char *pData, unsigned long size){
+  unsigned long i;
+
+  fprintf(fp, "!byte ");
+  for(i=0; i<size; i++){
+    fprintf(fp, (i+1<size) ? "%u, " : "%u\n", pData[i]);
+  }
+}
+
+/* uniform random bytes, few overlaps */
+void benchRandomArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  unsigned char data[BENCH_MAX_ARRAY_SIZE];
+  unsigned long i, j, length;
+
+  for(i=0; i<numberArrays; i++){
+    length = size/4 + benchRandom(size-size/4+1);
+    for(j=0; j<length; j++){
+      data[j] = (unsigned char)benchRandom(256);
+    }
+    fprintf(fp, "random%lu\n", i);
+    benchWriteBytes(fp, data, length);
+  }
+}
+
+/* parts of a common source, many overlaps and contained arrays */
+void benchOverlapArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  unsigned char *pSource;
+  unsigned long sourceSize;
+  unsigned long i, length;
+
+  sourceSize = numberArrays*size/2+size;
+  pSource = (unsigned char *)malloc(sourceSize);
+  if(pSource==NULL){
+    fprintf(stderr, "Can not allocate memory for the corpus.\n");
+    exit(1);
+  }
+  for(i=0; i<sourceSize; i++){
+    pSource[i] = (unsigned char)benchRandom(256);
+  }
+  for(i=0; i<numberArrays; i++){
+    length = size/4 + benchRandom(size-size/4+1);
+    fprintf(fp, "part%lu\n", i);
+    benchWriteBytes(fp, &pSource[benchRandom(sourceSize-length+1)], length);
+  }
+  free(pSource);
+}
+
+/* animation frames of 24x21 pixel sprites, 63 bytes with alignment 64,
+   frames of an animation are shifted images of the same shape */
+void benchSpriteArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  unsigned char shape[21];
+  unsigned char sprite[63];
+  unsigned long i, row, shift;
+  unsigned long value;
+
+  for(i=0; i<numberArrays; i++){
+    if((i%8)==0){
+      for(row=0; row<21; row++){
+        shape[row] = (unsigned char)((benchRandom(4)==0) ? 0 : benchRandom(256));
+      }
+    }
+    shift = i%8;
+    memset(sprite, 0, sizeof(sprite));
+    for(row=0; row<21; row++){
+      /* the shape moves to the right by one pixel per frame */
+      value = (unsigned long)shape[row]<<(8-shift);
+      sprite[row*3] = (unsigned char)(value>>8);
+      sprite[row*3+1] = (unsigned char)value;
+      sprite[row*3+2] = (unsigned char)((row+i)%size==0 ? 0x80 : 0);
+    }
+    fprintf(fp, "sprite%lu 64\n", i);
+    benchWriteBytes(fp, sprite, sizeof(sprite));
+  }
+}
+
+/* colour RAM of scrolling screens of 25 rows: 4 bit colours, the upper nibble
+   is not used and random, every screen is the previous one scrolled by some rows */
+void benchColourRamArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  unsigned char colours[BENCH_MAX_ARRAY_SIZE];
+  unsigned char mask[BENCH_MAX_ARRAY_SIZE];
+  unsigned long i, j, run;
+  unsigned long rowSize, start;
+  unsigned char colour;
+
+  memset(mask, 0xF0, sizeof(mask));
+  memset(colours, 0, sizeof(colours));
+  rowSize = size/25;
+  for(i=0; i<numberArrays; i++){
+    start = (i==0) ? 0 : size-rowSize*(1+benchRandom(3));
+    memmove(colours, &colours[size-start], start);
+    /* new rows: runs of equal colours */
+    j = start;
+    while(j<size){
+      colour = (unsigned char)benchRandom(16);
+      run = 1+benchRandom(rowSize);
+      while((run>0)&&(j<size)){
+        colours[j++] = colour;
+        run--;
+      }
+    }
+    for(j=0; j<size; j++){
+      colours[j] = (unsigned char)((colours[j]&0x0F) | (benchRandom(16)<<4));
+    }
+    fprintf(fp, "colourRam%lu\n", i);
+    benchWriteBytes(fp, colours, size);
+    benchWriteBytes(fp, mask, size);
+  }
+}
+
+/* sine tables of different amplitudes and lengths, quarter tables,
+   and lookup tables of screen line addresses and multiplications */
+void benchTableArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  unsigned char table[BENCH_MAX_ARRAY_SIZE];
+  unsigned long i, j, length;
+  unsigned long amplitude;
+  unsigned long factor;
+
+  for(i=0; i<numberArrays; i++){
+    switch(i%4){
+    case 0:
+      /* full sine */
+      amplitude = 16+benchRandom(112);
+      for(j=0; j<size; j++){
+        table[j] = (unsigned char)(128+(long)floor(amplitude*sin(2.0*3.14159265358979*j/size)+0.5));
+      }
+      length = size;
+      fprintf(fp, "sine%lu\n", i);
+      break;
+    case 1:
+      /* quarter of a sine, part of the full sine of the same amplitude */
+      amplitude = 16+benchRandom(112);
+      length = size/4;
+      for(j=0; j<length; j++){
+        table[j] = (unsigned char)(128+(long)floor(amplitude*sin(2.0*3.14159265358979*j/size)+0.5));
+      }
+      fprintf(fp, "quarterSine%lu\n", i);
+      break;
+    case 2:
+      /* low or high bytes of the screen line addresses */
+      length = 25;
+      for(j=0; j<length; j++){
+        table[j] = (unsigned char)((benchRandom(2)==0) ? ((0x400+j*40)&0xFF) : ((0x400+j*40)>>8));
+      }
+      fprintf(fp, "lineAddress%lu\n", i);
+      break;
+    default:
+      /* multiplication table */
+      factor = 1+benchRandom(16);
+      length = size/2;
+      for(j=0; j<length; j++){
+        table[j] = (unsigned char)(j*factor);
+      }
+      fprintf(fp, "multiply%lu\n", i);
+      break;
+    }
+    benchWriteBytes(fp, table, length);
+  }
+}
+
+/* short arrays with padding bits and aligned arrays, the first four arrays
+   are fixed: after their first merge the greedy step reached an array smaller
+   than the current overlap */
+static const unsigned char benchMaskedData[4][16] = {
+  {1, 1, 255, 241, 1, 157, 0, 0, 2, 0, 1, 1, 2, 13, 188, 255},
+  {0},
+  {255, 0, 2, 0, 0, 255, 255},
+  {2, 1}
+};
+static const unsigned char benchMaskedMask[4][16] = {
+  {15, 255, 0, 255, 255, 0, 0, 255, 0, 0, 0, 255, 0, 0, 240, 255},
+  {240},
+  {0, 240, 15, 255, 0, 240, 0},
+  {15, 240}
+};
+static const unsigned long benchMaskedSize[4] = {16, 1, 7, 2};
+static const unsigned long benchMaskedAlignment[4] = {2, 4, 1, 4};
+
+void benchMaskedArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  static const unsigned char values[] = {0, 1, 2, 255};
+  static const unsigned char masks[] = {0, 0, 0x0F, 0xF0, 0xFF};
+  unsigned char data[BENCH_MAX_ARRAY_SIZE];
+  unsigned char mask[BENCH_MAX_ARRAY_SIZE];
+  unsigned long i, j, length;
+
+  for(i=0; i<numberArrays; i++){
+    if(i<4){
+      length = benchMaskedSize[i];
+      memcpy(data, benchMaskedData[i], length);
+      memcpy(mask, benchMaskedMask[i], length);
+    } else {
+      length = 1+benchRandom(size);
+      for(j=0; j<length; j++){
+        data[j] = (benchRandom(4)==0) ? (unsigned char)benchRandom(256) : values[benchRandom(sizeof(values))];
+        mask[j] = masks[benchRandom(sizeof(masks))];
+      }
+    }
+    fprintf(fp, "masked%lu %lu\n", i, benchMaskedAlignment[i%4]);
+    benchWriteBytes(fp, data, length);
+    benchWriteBytes(fp, mask, length);
+  }
+}
+
+/* zero terminated messages of a few words */
+void benchStringArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  static const char *pWords[] = {"GAME", "OVER", "PLAYER", "ONE", "TWO", "PRESS", "FIRE", "TO",
+                                 "START", "LEVEL", "HIGH", "SCORE", "BONUS", "LIVES", "LEFT", "GET",
+                                 "READY", "WELL", "DONE", "THE", "END", "TIME", "UP", "PAUSED"};
+  char text[BENCH_MAX_ARRAY_SIZE];
+  unsigned long i, j, numberWords;
+  size_t length;
+
+  for(i=0; i<numberArrays; i++){
+    text[0] = '\0';
+    numberWords = 1+benchRandom(size);
+    for(j=0; j<numberWords; j++){
+      if(j>0){
+        strcat(text, " ");
+      }
+      strcat(text, pWords[benchRandom(sizeof(pWords)/sizeof(pWords[0]))]);
+    }
+    length = strlen(text);
+    fprintf(fp, "message%lu\n", i);
+    benchWriteBytes(fp, (const unsigned char *)text, (unsigned long)length+1);
+  }
+}
+
+/* large regions of zeros (buffers) read from a binary file, and small data arrays */
+void benchZeroArrays(FILE *fp, unsigned long numberArrays, unsigned long size){
+  unsigned char data[64];
+  unsigned long i, j, length;
+
+  for(i=0; i<numberArrays; i++){
+    if((i%2)==0){
+      length = size/8 + benchRandom(size-size/8+1);
+      fprintf(fp, "buffer%lu\n", i);
+      /* the file is shorter, the rest is filled up with zeros */
+      fprintf(fp, "!binary \"zero.bin\", %lu\n", length);
+    } else {
+      length = 8+benchRandom(56);
+      for(j=0; j<length; j++){
+        data[j] = (unsigned char)((benchRandom(3)==0) ? benchRandom(256) : 0);
+      }
+      fprintf(fp, "data%lu\n", i);
+      benchWriteBytes(fp, data, length);
+    }
+  }
+}
+
+static const tBenchCorpus benchCorpora[] = {
+  {"random-100", benchRandomArrays, 100, 64},
+  {"random-1000", benchRandomArrays, 1000, 64},
+  {"overlap-300", benchOverlapArrays, 300, 256},
+  {"overlap-2000", benchOverlapArrays, 2000, 48},
+  {"sprites-64", benchSpriteArrays, 64, 7},
+  {"sprites-512", benchSpriteArrays, 512, 7},
+  {"colourram-16", benchColourRamArrays, 16, 1000},
+  {"colourram-64", benchColourRamArrays, 64, 1000},
+  {"tables-64", benchTableArrays, 64, 256},
+  {"tables-1000", benchTableArrays, 1000, 128},
+  {"strings-300", benchStringArrays, 300, 4},
+  {"strings-3000", benchStringArrays, 3000, 6},
+  {"zero-16", benchZeroArrays, 16, 16384},
+  {"zero-200", benchZeroArrays, 200, 65536},
+  {"masked-4", benchMaskedArrays, 4, 16},
+  {"masked-400", benchMaskedArrays, 400, 24}
+};
+
+int main(int argc, char **argv){
+  char fileName[4096];
+  FILE *fp;
+  FILE *fpList;
+  unsigned long i;
+
+  if(argc!=2){
+    fprintf(stderr, "usage: benchCorpus <directory>\n");
+    return 1;
+  }
+  snprintf(fileName, sizeof(fileName), "%s/zero.bin", argv[1]);
+  fp = fopen(fileName, "wb");
+  if(fp==NULL){
+    fprintf(stderr, "Can not open file %s.\n", fileName);
+    return 1;
+  }
+  for(i=0; i<BENCH_ZERO_FILE_SIZE; i++){
+    fputc(0, fp);
+  }
+  fclose(fp);
+
+  snprintf(fileName, sizeof(fileName), "%s/list.txt", argv[1]);
+  fpList = fopen(fileName, "w");
+  if(fpList==NULL){
+    fprintf(stderr, "Can not open file %s.\n", fileName);
+    return 1;
+  }
+  for(i=0; i<sizeof(benchCorpora)/sizeof(benchCorpora[0]); i++){
+    snprintf(fileName, sizeof(fileName), "%s/%s.txt", argv[1], benchCorpora[i].pName);
+    fp = fopen(fileName, "w");
+    if(fp==NULL){
+      fprintf(stderr, "Can not open file %s.\n", fileName);
+      return 1;
+    }
+    benchSeed((unsigned long long)i+1);
+    fprintf(fp, "; benchmark corpus %s\n", benchCorpora[i].pName);
+    benchCorpora[i].pGenerate(fp, benchCorpora[i].numberArrays, benchCorpora[i].size);
+    fclose(fp);
+    fprintf(fpList, "%s\n", benchCorpora[i].pName);
+  }
+  fclose(fpList);
+  return 0;
+}
@@ -0,0 +1,509 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/* Microbenchmark of the roadC kernels: time per call and throughput of the
+   compares, the overlap check, the search of an array, the alignment merge
+   calculation and the concatenation, for several array lengths and shares
+   of bytes with padding bits, with warm caches (repeated calls on the same
+   arrays) and cold caches (caches overwritten before every call). The
+   variants of a kernel run on the same arrays and must give the same result.
+   usage: benchKernels [<minimal time per measurement in ms>]
+   return: 0: ok, 1: error, 2: the variants of a kernel do not agree */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "roadcInternal.h"
+
+/* number of concatenated arrays */
+#define BENCH_NUMBER_PARTS 16
+/* bytes written to overwrite the caches */
+#define BENCH_COLD_BYTES (64UL*1024UL*1024UL)
+#define BENCH_COLD_CALLS 16
+#define BENCH_CACHE_LINE 64
+
+/* arrays of one length and padding bit share */
+struct tBenchSetStruct{
+  tRoadcUInt32 length;
+  /* random data */
+  tRoadcDataEntryPtr pLeft;
+  /* equal to pLeft, other padding bits */
+  tRoadcDataEntryPtr pEqual;
+  /* prefix equal to the suffix of pLeft of half its length */
+  tRoadcDataEntryPtr pRight;
+  /* part of pLeft near its end */
+  tRoadcDataEntryPtr pPattern;
+  tRoadcDataEntryPtr ppParts[BENCH_NUMBER_PARTS];
+  tRoadcBytePtr pLeftMask;
+  tRoadcBytePtr pEqualMask;
+  tRoadcUInt64 *pLengths;
+  /* context for the concatenation, prepared before the call */
+  tRoadcPtr pRoadc;
+  /* context with the overlap memo of pLeft and pPattern */
+  tRoadcPtr pMemoRoadc;
+};
+
+typedef struct tBenchSetStruct tBenchSet;
+typedef tBenchSet* tBenchSetPtr;
+
+struct tBenchKernelStruct{
+  const char *pKernel;
+  const char *pVariant;
+  tRoadcUInt32 (*pCall)(tBenchSetPtr pSet);
+  /* not timed before every call, NULL: none */
+  void (*pPrepare)(tBenchSetPtr pSet);
+  /* processed bytes per call */
+  tRoadcUInt32 (*pBytes)(tBenchSetPtr pSet);
+};
+
+typedef struct tBenchKernelStruct tBenchKernel;
+
+static tRoadcUInt64 benchRandomState = 1;
+static volatile tRoadcUInt32 benchSink;
+static tRoadcBytePtr pBenchColdBuffer;
+
+tRoadcUInt32 benchRandom(tRoadcUInt32 range){
+  benchRandomState ^= benchRandomState<<13;
+  benchRandomState ^= benchRandomState>>7;
+  benchRandomState ^= benchRandomState<<17;
+  return (tRoadcUInt32)((benchRandomState>>16)%range);
+}
+
+tRoadcFloat64 benchNow(void){
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (tRoadcFloat64)now.tv_sec + (tRoadcFloat64)now.tv_nsec*1.0e-9;
+}
+
+void benchEvictCaches(void){
+  tRoadcUInt32 i;
+
+  for(i=0; i<BENCH_COLD_BYTES; i+=BENCH_CACHE_LINE){
+    pBenchColdBuffer[i]++;
+  }
+}
+
+tRoadcUInt32 benchChecksum(tRoadcBytePtr pData, tRoadcUInt32 size){
+  tRoadcUInt32 hash;
+  tRoadcUInt32 i;
+
+  hash = 2166136261UL;
+  for(i=0; i<size; i++){
+    hash = ((hash^pData[i])*16777619UL)&0xFFFFFFFFUL;
+  }
+  return hash;
+}
+
+/* padding byte mask with the share of bytes with padding bits, NULL: none */
+tRoadcBytePtr benchNewMask(tRoadcUInt32 size, tRoadcUInt32 sharePercent){
+  static const tRoadcByte masks[] = {0x0F, 0xF0, 0x01, 0x80};
+  tRoadcBytePtr pMask;
+  tRoadcUInt32 i;
+
+  if(sharePercent==0){
+    return NULL;
+  }
+  pMask = (tRoadcBytePtr)malloc(size);
+  if(pMask==NULL){
+    return NULL;
+  }
+  for(i=0; i<size; i++){
+    pMask[i] = (benchRandom(100)<sharePercent) ? masks[benchRandom(4)] : 0;
+  }
+  return pMask;
+}
+
+tRoadcDataEntryPtr benchNewEntry(tRoadcBytePtr pData, tRoadcUInt32 size, tRoadcBytePtr pMask){
+  tRoadcDataEntryPtr pEntry;
+
+  pEntry = roadcNewRoadcDataEntry(pData, size, pMask, 1);
+  if(pEntry==NULL){
+    fprintf(stderr, "Can not allocate memory for the arrays.\n");
+    exit(1);
+  }
+  return pEntry;
+}
+
+tBenchSetPtr benchNewSet(tRoadcUInt32 length, tRoadcUInt32 sharePercent){
+  tBenchSetPtr pSet;
+  tRoadcBytePtr pData;
+  tRoadcBytePtr pMask;
+  tRoadcUInt32 patternSize;
+  tRoadcUInt32 i, k;
+
+  pSet = (tBenchSetPtr)calloc(1, sizeof(tBenchSet));
+  pData = (tRoadcBytePtr)malloc(length+BENCH_NUMBER_PARTS);
+  pSet->pLengths = (tRoadcUInt64 *)malloc((length/64+1)*sizeof(tRoadcUInt64));
+  if((pSet==NULL)||(pData==NULL)||(pSet->pLengths==NULL)){
+    fprintf(stderr, "Can not allocate memory for the arrays.\n");
+    exit(1);
+  }
+  pSet->length = length;
+  for(i=0; i<length; i++){
+    pData[i] = (tRoadcByte)benchRandom(256);
+  }
+  pSet->pLeftMask = benchNewMask(length, sharePercent);
+  pSet->pLeft = benchNewEntry(pData, length, pSet->pLeftMask);
+  pSet->pEqualMask = benchNewMask(length, sharePercent);
+  pSet->pEqual = benchNewEntry(pData, length, pSet->pEqualMask);
+  patternSize = (length/16<4) ? 4 : length/16;
+  pMask = benchNewMask(patternSize, sharePercent);
+  pSet->pPattern = benchNewEntry(&pData[length-patternSize-1], patternSize, pMask);
+  free(pMask);
+  memmove(pData, &pData[length-length/2], length/2);
+  for(i=length/2; i<length; i++){
+    pData[i] = (tRoadcByte)benchRandom(256);
+  }
+  pMask = benchNewMask(length, sharePercent);
+  pSet->pRight = benchNewEntry(pData, length, pMask);
+  free(pMask);
+  /* decreasing sizes, the list order of the concatenation */
+  for(k=0; k<BENCH_NUMBER_PARTS; k++){
+    for(i=0; i<length+BENCH_NUMBER_PARTS-k; i++){
+      pData[i] = (tRoadcByte)benchRandom(256);
+    }
+    pMask = benchNewMask(length+BENCH_NUMBER_PARTS-k, sharePercent);
+    pSet->ppParts[k] = benchNewEntry(pData, length+BENCH_NUMBER_PARTS-k, pMask);
+    free(pMask);
+  }
+  free(pData);
+  return pSet;
+}
+
+void benchDeleteSet(tBenchSetPtr pSet){
+  tRoadcUInt32 k;
+
+  roadcFreeRoadcDataEntry(pSet->pLeft);
+  roadcFreeRoadcDataEntry(pSet->pEqual);
+  roadcFreeRoadcDataEntry(pSet->pRight);
+  roadcFreeRoadcDataEntry(pSet->pPattern);
+  for(k=0; k<BENCH_NUMBER_PARTS; k++){
+    roadcFreeRoadcDataEntry(pSet->ppParts[k]);
+  }
+  free(pSet->pLeftMask);
+  free(pSet->pEqualMask);
+  free(pSet->pLengths);
+  roadcDelete(pSet->pRoadc);
+  if(pSet->pMemoRoadc!=NULL){
+    roadcOverlapMemoDelete(pSet->pMemoRoadc);
+  }
+  roadcDelete(pSet->pMemoRoadc);
+  free(pSet);
+}
+
+tRoadcUInt32 benchBytes(tBenchSetPtr pSet){
+  return pSet->length;
+}
+
+tRoadcUInt32 benchBytesOverlap(tBenchSetPtr pSet){
+  return pSet->length/2;
+}
+
+tRoadcUInt32 benchBytesParts(tBenchSetPtr pSet){
+  return BENCH_NUMBER_PARTS*pSet->length+BENCH_NUMBER_PARTS*(BENCH_NUMBER_PARTS+1)/2;
+}
+
+tRoadcUInt32 benchArraysEqual(tBenchSetPtr pSet){
+  return roadcArraysEqual(pSet->pLeft->pData, pSet->pLeftMask, 
+                          pSet->pEqual->pData, pSet->pEqualMask, pSet->length);
+}
+
+tRoadcUInt32 benchDataEntriesEqual(tBenchSetPtr pSet){
+  return roadcDataEntriesEqual(pSet->pLeft, 0, pSet->pEqual, 0, pSet->length);
+}
+
+tRoadcUInt32 benchIsOverlap(tBenchSetPtr pSet){
+  return roadcIsOverlap(pSet->pLeft, pSet->pRight, pSet->length/2);
+}
+
+/* an overlap larger than the left array is never found */
+tRoadcUInt32 benchIsOverlapLarger(tBenchSetPtr pSet){
+  return roadcIsOverlap(pSet->pPattern, pSet->pLeft, pSet->pPattern->size+1);
+}
+
+void benchPrepareOverlapMemo(tBenchSetPtr pSet){
+  tRoadcDataEntryPtr pEntry;
+
+  if(pSet->pMemoRoadc!=NULL){
+    return;
+  }
+  pSet->pMemoRoadc = roadcNew();
+  if(pSet->pMemoRoadc==NULL){
+    fprintf(stderr, "Can not allocate memory for the arrays.\n");
+    exit(1);
+  }
+  pEntry = roadcNewRoadcDataEntryByCopy(pSet->pLeft);
+  if(pEntry==NULL){
+    fprintf(stderr, "Can not allocate memory for the arrays.\n");
+    exit(1);
+  }
+  roadcInsertDataEntry(pSet->pMemoRoadc, pEntry);
+  pEntry = roadcNewRoadcDataEntryByCopy(pSet->pPattern);
+  if(pEntry==NULL){
+    fprintf(stderr, "Can not allocate memory for the arrays.\n");
+    exit(1);
+  }
+  roadcInsertDataEntry(pSet->pMemoRoadc, pEntry);
+  roadcIndexDataEntries(pSet->pMemoRoadc);
+  roadcOverlapMemoNew(pSet->pMemoRoadc);
+}
+
+/* the same by the overlap memo of the greedy, arrays without padding bits are not in the memo */
+tRoadcUInt32 benchOverlapMemoLarger(tBenchSetPtr pSet){
+  tRoadcDataEntryPtr pLeft;
+  tRoadcDataEntryPtr pPattern;
+
+  pLeft = pSet->pMemoRoadc->pRoadcFirstDataEntry;
+  pPattern = pSet->pMemoRoadc->pRoadcLastDataEntry;
+  if(pSet->pMemoRoadc->pRoadcOverlapMemo==NULL){
+    return roadcIsOverlap(pPattern, pLeft, pPattern->size+1);
+  }
+  return roadcOverlapMemoIsOverlap(pSet->pMemoRoadc, pPattern, pLeft, pPattern->size+1);
+}
+
+/* all overlap lengths up to the half length by the Shift-And, the bit of the half length */
+tRoadcUInt32 benchOverlapLengths(tBenchSetPtr pSet){
+  tRoadcUInt32 length;
+
+  length = pSet->length/2;
+  if(roadcOverlapLengths(pSet->pLeft, pSet->pRight, length, pSet->pLengths)){
+    return 2;
+  }
+  return (tRoadcUInt32)((pSet->pLengths[(length-1)/64]>>((length-1)%64))&1);
+}
+
+tRoadcUInt32 benchArrayGetPosition(tBenchSetPtr pSet){
+  return roadcArrayGetPosition(pSet->pPattern, pSet->pLeft);
+}
+
+tRoadcUInt32 benchWildcardMatch(tBenchSetPtr pSet){
+  tRoadcUInt32 position;
+
+  if(roadcWildcardMatchGetPosition(pSet->pPattern, pSet->pLeft, &position)){
+    return pSet->pLeft->size+1;
+  }
+  return position;
+}
+
+tRoadcUInt32 benchCompareScan(tBenchSetPtr pSet){
+  tRoadcUInt32 i;
+
+  for(i=0; i+pSet->pPattern->size<=pSet->pLeft->size; i++){
+    if(roadcDataEntriesEqual(pSet->pPattern, 0, pSet->pLeft, i, pSet->pPattern->size)&&
+       roadcAlignmentPositionInResultCheck(pSet->pLeft->alignment, pSet->pPattern->alignment, i)){
+      return i;
+    }
+  }
+  return pSet->pLeft->size;
+}
+
+/* left array with alignment 4, right array with alignment 64 starting in the middle
+   at an odd position: there is no solution, all offsets up to the concatenation are checked */
+tRoadcUInt32 benchAlignmentMerge(tBenchSetPtr pSet){
+  tRoadcDataEntry left;
+  tRoadcDataEntry right;
+  tRoadcDataEntry result;
+
+  roadcInitDataEntry(&left);
+  roadcInitDataEntry(&right);
+  roadcInitDataEntry(&result);
+  left.size = pSet->length;
+  left.alignment = 4;
+  right.size = pSet->length;
+  right.alignment = 64;
+  if(roadcAlignmentMergeCalculation(&left, &right, pSet->length/2+1, &result)==0){
+    return 0;
+  }
+  return result.alignmentOffset;
+}
+
+void benchPrepareConcatenation(tBenchSetPtr pSet){
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt32 k;
+
+  roadcDelete(pSet->pRoadc);
+  pSet->pRoadc = roadcNew();
+  if(pSet->pRoadc==NULL){
+    fprintf(stderr, "Can not allocate memory for the arrays.\n");
+    exit(1);
+  }
+  for(k=0; k<BENCH_NUMBER_PARTS; k++){
+    pEntry = roadcNewRoadcDataEntryByCopy(pSet->ppParts[k]);
+    if(pEntry==NULL){
+      fprintf(stderr, "Can not allocate memory for the arrays.\n");
+      exit(1);
+    }
+    roadcInsertDataEntry(pSet->pRoadc, pEntry);
+  }
+}
+
+/* planned copy of all arrays into the result */
+tRoadcUInt32 benchConcatenation(tBenchSetPtr pSet){
+  if(roadcConcatenation(pSet->pRoadc)){
+    return 0;
+  }
+  return benchChecksum(pSet->pRoadc->pRoadcFirstDataEntry->pData, pSet->pRoadc->pRoadcFirstDataEntry->size);
+}
+
+/* copy of the arrays merged so far for every array, as by the greedy merges */
+tRoadcUInt32 benchPairwiseConcatenation(tBenchSetPtr pSet){
+  tRoadcDataEntryPtr pResult;
+  tRoadcDataEntryPtr pNext;
+  tRoadcUInt32 checksum;
+  tRoadcUInt32 k;
+
+  pResult = roadcNewRoadcDataEntryByCopy(pSet->ppParts[0]);
+  for(k=1; (k<BENCH_NUMBER_PARTS)&&(pResult!=NULL); k++){
+    pNext = roadcNewRoadcDataEntryByConcatenation(pResult, pSet->ppParts[k], 1, 0, 0);
+    roadcFreeRoadcDataEntry(pResult);
+    pResult = pNext;
+  }
+  if(pResult==NULL){
+    return 0;
+  }
+  checksum = benchChecksum(pResult->pData, pResult->size);
+  roadcFreeRoadcDataEntry(pResult);
+  return checksum;
+}
+
+static const tBenchKernel benchKernels[] = {
+  {"arraysEqual", "roadcArraysEqual", benchArraysEqual, NULL, benchBytes},
+  {"arraysEqual", "roadcDataEntriesEqual", benchDataEntriesEqual, NULL, benchBytes},
+  {"isOverlap", "roadcIsOverlap", benchIsOverlap, NULL, benchBytesOverlap},
+  {"isOverlap", "roadcOverlapLengths", benchOverlapLengths, NULL, benchBytesOverlap},
+  {"isOverlapLarger", "roadcIsOverlap", benchIsOverlapLarger, NULL, benchBytesOverlap},
+  {"isOverlapLarger", "roadcOverlapMemoIsOverlap", benchOverlapMemoLarger, benchPrepareOverlapMemo, benchBytesOverlap},
+  {"arrayGetPosition", "roadcArrayGetPosition", benchArrayGetPosition, NULL, benchBytes},
+  {"arrayGetPosition", "wildcardMatch", benchWildcardMatch, NULL, benchBytes},
+  {"arrayGetPosition", "compareScan", benchCompareScan, NULL, benchBytes},
+  {"alignmentMerge", "roadcAlignmentMergeCalculation", benchAlignmentMerge, NULL, benchBytes},
+  {"concatenation", "roadcConcatenation", benchConcatenation, benchPrepareConcatenation, benchBytesParts},
+  {"concatenation", "pairwise", benchPairwiseConcatenation, NULL, benchBytesParts}
+};
+
+/* time per call in seconds, warm: repeated calls until the minimal time,
+   cold: single calls after the caches are overwritten */
+tRoadcFloat64 benchMeasure(const tBenchKernel *pKernel, tBenchSetPtr pSet, int cold,
+                           tRoadcFloat64 minTime, tRoadcUInt32 *pResult){
+  tRoadcFloat64 startTime;
+  tRoadcFloat64 time;
+  tRoadcUInt32 numberCalls;
+  tRoadcUInt32 calls;
+  tRoadcUInt32 i;
+
+  if(pKernel->pPrepare!=NULL){
+    pKernel->pPrepare(pSet);
+  }
+  /* warm up, result for the comparison of the variants */
+  *pResult = pKernel->pCall(pSet);
+  time = 0.0;
+  numberCalls = 0;
+  if(cold || (pKernel->pPrepare!=NULL)){
+    while((numberCalls<BENCH_COLD_CALLS) || (!cold && (time<minTime))){
+      if(pKernel->pPrepare!=NULL){
+        pKernel->pPrepare(pSet);
+      }
+      if(cold){
+        benchEvictCaches();
+      }
+      startTime = benchNow();
+      benchSink += pKernel->pCall(pSet);
+      time += benchNow()-startTime;
+      numberCalls++;
+    }
+    return time/numberCalls;
+  }
+  calls = 1;
+  while(time<minTime){
+    startTime = benchNow();
+    for(i=0; i<calls; i++){
+      benchSink += pKernel->pCall(pSet);
+    }
+    time += benchNow()-startTime;
+    numberCalls += calls;
+    calls *= 2;
+  }
+  return time/numberCalls;
+}
+
+int main(int argc, char **argv){
+  static const tRoadcUInt32 lengths[] = {16, 64, 256, 1024, 4096, 65536};
+  static const tRoadcUInt32 shares[] = {0, 6, 50, 100};
+  tBenchSetPtr pSet;
+  tRoadcFloat64 minTime;
+  tRoadcFloat64 time;
+  tRoadcUInt32 result;
+  tRoadcUInt32 firstResult;
+  tRoadcUInt32 numberDifferent;
+  tRoadcUInt32 l, s, k;
+  int cold;
+
+  minTime = 0.02;
+  if(argc>1){
+    minTime = atof(argv[1])/1000.0;
+  }
+  pBenchColdBuffer = (tRoadcBytePtr)calloc(BENCH_COLD_BYTES, 1);
+  if(pBenchColdBuffer==NULL){
+    fprintf(stderr, "Can not allocate memory for the cache buffer.\n");
+    return 1;
+  }
+  numberDifferent = 0;
+  printf("%-17s %-31s %6s %8s %5s %12s %12s %6s\n",
+         "kernel", "variant", "length", "padding", "cache", "ns/call", "MB/s", "result");
+  for(l=0; l<sizeof(lengths)/sizeof(lengths[0]); l++){
+    for(s=0; s<sizeof(shares)/sizeof(shares[0]); s++){
+      pSet = benchNewSet(lengths[l], shares[s]);
+      for(cold=0; cold<2; cold++){
+        firstResult = 0;
+        for(k=0; k<sizeof(benchKernels)/sizeof(benchKernels[0]); k++){
+          time = benchMeasure(&benchKernels[k], pSet, cold, minTime, &result);
+          if((k==0)||(strcmp(benchKernels[k].pKernel, benchKernels[k-1].pKernel)!=0)){
+            firstResult = result;
+          }
+          printf("%-17s %-31s %6lu %7lu%% %5s %12.1f %12.1f %6lu%s\n",
+                 benchKernels[k].pKernel, benchKernels[k].pVariant, lengths[l], shares[s],
+                 cold ? "cold" : "warm", time*1.0e9,
+                 (tRoadcFloat64)benchKernels[k].pBytes(pSet)/time/1.0e6, 
+                 result, (result!=firstResult) ? "  DIFFERENT" : "");
+          if(result!=firstResult){
+            numberDifferent++;
+          }
+        }
+      }
+      fflush(stdout);
+      benchDeleteSet(pSet);
+    }
+  }
+  free(pBenchColdBuffer);
+  if(numberDifferent>0){
+    printf("%lu results of kernel variants differ.\n", numberDifferent);
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,303 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+/* SPDX-License-Identifier: MIT */
+
+/* Benchmark of compactor: runs compactor on every corpus of the list file
+   of benchCorpus, records the time of every phase, the peak resident set 
+   size and the compaction rate as JSON, and compares the results with a 
+   baseline file written by an earlier run.
+   usage: benchRun <compactor> <corpus directory> <result file> [<baseline file> [<compactor options>...]]
+   return: 0: ok, 1: error, 2: a compacted size is larger than in the baseline */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#define BENCH_MAX_LINE_SIZE 4096
+#define BENCH_MAX_NAME_SIZE 256
+#define BENCH_MAX_PHASES 32
+/* slower than the baseline by this factor is reported */
+#define BENCH_TIME_FACTOR 1.5
+
+typedef struct {
+  char name[BENCH_MAX_NAME_SIZE];
+  unsigned long numberArrays;
+  unsigned long originalSize;
+  unsigned long compactedSize;
+  double timeInSeconds;
+  long peakRssKb;
+  char phaseNames[BENCH_MAX_PHASES][BENCH_MAX_NAME_SIZE];
+  double phaseTimes[BENCH_MAX_PHASES];
+  int numberPhases;
+} tBenchResult;
+
+double benchNow(void){
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec*1.0e-9;
+}
+
+/* phase times of the verbose output: "<phase> time (s): <seconds>" */
+void benchParseLine(tBenchResult *pResult, char *pLine){
+  char *pFound;
+  unsigned long value;
+
+  pFound = strstr(pLine, " time (s): ");
+  if((pFound!=NULL)&&(pResult->numberPhases<BENCH_MAX_PHASES)&&
+     (pFound-pLine<BENCH_MAX_NAME_SIZE)){
+    memcpy(pResult->phaseNames[pResult->numberPhases], pLine, (size_t)(pFound-pLine));
+    pResult->phaseNames[pResult->numberPhases][pFound-pLine] = '\0';
+    pResult->phaseTimes[pResult->numberPhases] = atof(pFound+strlen(" time (s): "));
+    pResult->numberPhases++;
+  } else if(sscanf(pLine, "Original data size: %lu", &value)==1){
+    pResult->originalSize = value;
+  } else if(sscanf(pLine, "Compacted data size: %lu", &value)==1){
+    pResult->compactedSize = value;
+  } else if(sscanf(pLine, "number arrays before compaction: %lu", &value)==1){
+    pResult->numberArrays = value;
+  }
+}
+
+/* compactor in verbose mode with verification in the corpus directory */
+int benchRunCorpus(tBenchResult *pResult, const char *pCompactor, const char *pDirectory,
+                   char **ppOptions, int numberOptions){
+  char fileIn[BENCH_MAX_LINE_SIZE];
+  char line[BENCH_MAX_LINE_SIZE];
+  char *ppArguments[64];
+  int pipeFds[2];
+  int numberArguments;
+  int status;
+  int i;
+  pid_t pid;
+  struct rusage usage;
+  double startTime;
+  FILE *fp;
+
+  snprintf(fileIn, sizeof(fileIn), "%s.txt", pResult->name);
+  numberArguments = 0;
+  ppArguments[numberArguments++] = (char *)pCompactor;
+  ppArguments[numberArguments++] = (char *)"-v";
+  ppArguments[numberArguments++] = (char *)"-y";
+  for(i=0; (i<numberOptions)&&(numberArguments<58); i++){
+    ppArguments[numberArguments++] = ppOptions[i];
+  }
+  ppArguments[numberArguments++] = (char *)"-o";
+  ppArguments[numberArguments++] = (char *)"bench_output.txt";
+  ppArguments[numberArguments++] = (char *)"-b";
+  ppArguments[numberArguments++] = (char *)"bench_output.bin";
+  ppArguments[numberArguments++] = fileIn;
+  ppArguments[numberArguments] = NULL;
+
+  if(pipe(pipeFds)!=0){
+    fprintf(stderr, "Can not create pipe.\n");
+    return 1;
+  }
+  startTime = benchNow();
+  pid = fork();
+  if(pid<0){
+    fprintf(stderr, "Can not start %s.\n", pCompactor);
+    return 1;
+  }
+  if(pid==0){
+    /* binary input files are relative to the corpus directory */
+    close(pipeFds[0]);
+    dup2(pipeFds[1], STDOUT_FILENO);
+    close(pipeFds[1]);
+    if(chdir(pDirectory)!=0){
+      _exit(127);
+    }
+    execv(pCompactor, ppArguments);
+    _exit(127);
+  }
+  close(pipeFds[1]);
+  fp = fdopen(pipeFds[0], "r");
+  if(fp==NULL){
+    close(pipeFds[0]);
+    waitpid(pid, &status, 0);
+    return 1;
+  }
+  while(fgets(line, sizeof(line), fp)!=NULL){
+    benchParseLine(pResult, line);
+  }
+  fclose(fp);
+  if(wait4(pid, &status, 0, &usage)<0){
+    return 1;
+  }
+  pResult->timeInSeconds = benchNow()-startTime;
+  pResult->peakRssKb = usage.ru_maxrss;
+  if((!WIFEXITED(status))||(WEXITSTATUS(status)!=0)||(pResult->compactedSize==0)){
+    fprintf(stderr, "compactor failed for corpus %s.\n", pResult->name);
+    return 1;
+  }
+  return 0;
+}
+
+/* one line per corpus, read by benchReadBaseline */
+void benchWriteResult(FILE *fp, tBenchResult *pResult, int last){
+  int i;
+
+  fprintf(fp, "    {\"corpus\": \"%s\", \"arrays\": %lu, \"originalSize\": %lu, \"compactedSize\": %lu, "
+          "\"ratio\": %.6f, \"timeSeconds\": %.6f, \"peakRssKb\": %ld, \"phases\": {",
+          pResult->name, pResult->numberArrays, pResult->originalSize, pResult->compactedSize,
+          (pResult->originalSize>0) ? (double)pResult->compactedSize/(double)pResult->originalSize : 0.0,
+          pResult->timeInSeconds, pResult->peakRssKb);
+  for(i=0; i<pResult->numberPhases; i++){
+    fprintf(fp, "%s\"%s\": %.6f", (i>0) ? ", " : "", pResult->phaseNames[i], pResult->phaseTimes[i]);
+  }
+  fprintf(fp, "}}%s\n", last ? "" : ",");
+}
+
+/* compacted size and time of the corpus in the baseline file, 0: not found */
+int benchReadBaseline(FILE *fp, const char *pName, unsigned long *pCompactedSize, double *pTimeInSeconds){
+  char line[BENCH_MAX_LINE_SIZE];
+  char key[BENCH_MAX_NAME_SIZE+16];
+  char *pFound;
+
+  snprintf(key, sizeof(key), "\"corpus\": \"%s\"", pName);
+  rewind(fp);
+  while(fgets(line, sizeof(line), fp)!=NULL){
+    if(strstr(line, key)==NULL){
+      continue;
+    }
+    pFound = strstr(line, "\"compactedSize\": ");
+    if(pFound==NULL){
+      return 0;
+    }
+    *pCompactedSize = strtoul(pFound+strlen("\"compactedSize\": "), NULL, 10);
+    pFound = strstr(line, "\"timeSeconds\": ");
+    if(pFound==NULL){
+      return 0;
+    }
+    *pTimeInSeconds = atof(pFound+strlen("\"timeSeconds\": "));
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv){
+  char fileName[BENCH_MAX_LINE_SIZE];
+  char compactor[PATH_MAX];
+  char names[64][BENCH_MAX_NAME_SIZE];
+  tBenchResult result;
+  FILE *fpList;
+  FILE *fpResult;
+  FILE *fpBaseline;
+  unsigned long baselineSize;
+  double baselineTime;
+  int numberCorpora;
+  int numberLarger;
+  int i;
+
+  if(argc<4){
+    fprintf(stderr, "usage: benchRun <compactor> <corpus directory> <result file> [<baseline file> [<compactor options>...]]\n");
+    return 1;
+  }
+  /* compactor is started in the corpus directory */
+  if(realpath(argv[1], compactor)==NULL){
+    fprintf(stderr, "Can not find %s.\n", argv[1]);
+    return 1;
+  }
+  snprintf(fileName, sizeof(fileName), "%s/list.txt", argv[2]);
+  fpList = fopen(fileName, "r");
+  if(fpList==NULL){
+    fprintf(stderr, "Can not open file %s.\n", fileName);
+    return 1;
+  }
+  numberCorpora = 0;
+  while((numberCorpora<64)&&(fgets(names[numberCorpora], BENCH_MAX_NAME_SIZE, fpList)!=NULL)){
+    names[numberCorpora][strcspn(names[numberCorpora], "\r\n")] = '\0';
+    if(names[numberCorpora][0]!='\0'){
+      numberCorpora++;
+    }
+  }
+  fclose(fpList);
+
+  fpBaseline = NULL;
+  if((argc>4)&&(strcmp(argv[4], "")!=0)){
+    fpBaseline = fopen(argv[4], "r");
+    if(fpBaseline==NULL){
+      fprintf(stderr, "No baseline file %s, results are not compared.\n", argv[4]);
+    }
+  }
+  fpResult = fopen(argv[3], "w");
+  if(fpResult==NULL){
+    fprintf(stderr, "Can not open file %s.\n", argv[3]);
+    return 1;
+  }
+  fprintf(fpResult, "{\n  \"options\": \"");
+  for(i=5; i<argc; i++){
+    fprintf(fpResult, "%s%s", (i>5) ? " " : "", argv[i]);
+  }
+  fprintf(fpResult, "\",\n  \"results\": [\n");
+
+  printf("%-16s %8s %10s %10s %8s %10s %10s\n", "corpus", "arrays", "original", "compacted", "ratio", "time (s)", "rss (kB)");
+  numberLarger = 0;
+  for(i=0; i<numberCorpora; i++){
+    memset(&result, 0, sizeof(result));
+    strcpy(result.name, names[i]);
+    if(benchRunCorpus(&result, compactor, argv[2], &argv[5], (argc>5) ? argc-5 : 0)){
+      fclose(fpResult);
+      return 1;
+    }
+    benchWriteResult(fpResult, &result, i+1==numberCorpora);
+    printf("%-16s %8lu %10lu %10lu %8.4f %10.3f %10ld",
+           result.name, result.numberArrays, result.originalSize, result.compactedSize,
+           (double)result.compactedSize/(double)result.originalSize, result.timeInSeconds, result.peakRssKb);
+    if((fpBaseline!=NULL)&&benchReadBaseline(fpBaseline, result.name, &baselineSize, &baselineTime)){
+      if(result.compactedSize>baselineSize){
+        printf("  LARGER than baseline %lu", baselineSize);
+        numberLarger++;
+      } else if(result.compactedSize<baselineSize){
+        printf("  smaller than baseline %lu", baselineSize);
+      }
+      if(result.timeInSeconds>baselineTime*BENCH_TIME_FACTOR){
+        printf("  SLOWER than baseline %.3f s", baselineTime);
+      } else if(result.timeInSeconds*BENCH_TIME_FACTOR<baselineTime){
+        printf("  faster than baseline %.3f s", baselineTime);
+      }
+    }
+    printf("\n");
+    fflush(stdout);
+  }
+  fprintf(fpResult, "  ]\n}\n");
+  fclose(fpResult);
+  if(fpBaseline!=NULL){
+    fclose(fpBaseline);
+  }
+  if(numberLarger>0){
+    printf("%d compacted sizes larger than baseline.\n", numberLarger);
+    return 2;
+  }
+  return 0;
+}
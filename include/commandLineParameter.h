@@ -33,14 +33,38 @@ THE SOFTWARE.
 #define CL_FORMAT_OCT 2 
 #define CL_FORMAT_BIN 3 
 
+#define CL_STATS_NONE 0
+#define CL_STATS_JSON 1
+
 extern char *clCompressedDataName;
 extern int clCompressedDataFormat;
 extern int clCompilerType;
 extern char *clArraySizePrefix;
 extern char *clFileIn;
+extern char **clFilesIn;
+extern int clNumberFilesIn;
+extern char *clFileManifest;
+extern char *clFileServer;
 extern char *clFileOut;
 extern char *clFileOutBinary;
+extern int clJobs;
 extern tRoadcUInt32 clTimeout;
+extern tRoadcUInt32 clMaxMemory;
+extern int clEstimate;
+extern int clVerify;
+extern int clStats;
+extern int clLocalSearch;
+extern int clExact;
+extern int clPortfolio;
+extern int clShards;
+extern double clTargetGap;
+extern int clEngine;
+extern char *clFileOverlapGraph;
+extern char *clFileOrder;
+extern char *clFileTrace;
+extern char *clFileProgress;
 extern int clVerbose;
 
 void commandLineParameter (int argc, char **argv);
+int clIsBatchMode(void);
+int clIsServerMode(void);
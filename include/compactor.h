@@ -24,9 +24,50 @@ THE SOFTWARE.
 
 /* SPDX-License-Identifier: MIT */
 
+#ifndef COMPACTOR_H_
+#define COMPACTOR_H_
+
 #include "roadc.h"
+#include "readInput.h"
+
+/* phases of compactor outside of roadC in the statistics */
+#define COMPACTOR_PHASE_READ 0
+#define COMPACTOR_PHASE_WRITE 1
+#define COMPACTOR_NUMBER_PHASES 2
+
+/* steps of a job in the progress report */
+#define COMPACTOR_STEP_READ 0
+#define COMPACTOR_STEP_CALCULATION 1
+#define COMPACTOR_STEP_POSITIONS 2
+#define COMPACTOR_STEP_WRITE 3
+#define COMPACTOR_STEP_DONE 4
+
+/* one compaction: input file, roadC context, and output files */
+struct tCompactorJobStruct{
+  char *pFileIn;
+  char *pFileOut;
+  char *pFileOutBinary;
+  /* 0: no messages, e.g. for jobs running in parallel */
+  int verbose;
+  tInputData input;
+  tRoadcPtr pRoadc;
+  tRoadcBytePtr compactedData;
+  tRoadcUInt32 compactedDataSize;
+  /* positions of the input arrays in the compacted data, searched by the writer if NULL */
+  tRoadcUInt32 *pPositions;
+  /* wall clock and processor time in seconds of reading the input and writing the output */
+  double wallTime[COMPACTOR_NUMBER_PHASES];
+  double cpuTime[COMPACTOR_NUMBER_PHASES];
+  /* progress read by the progress thread with atomic loads: step, positions searched so far */
+  int progressStep;
+  tRoadcUInt32 progressPositions;
+};
+
+typedef struct tCompactorJobStruct tCompactorJob;
+typedef tCompactorJob* tCompactorJobPtr;
 
-extern tRoadcPtr pRoadc;
-extern tRoadcBytePtr compactedData;
-extern tRoadcUInt32 compactedDataSize;
+void compactorNewRoadc(tCompactorJobPtr pJob);
+void compactorCalculation(tCompactorJobPtr pJob);
+void compactorEstimate(tCompactorJobPtr pJob);
 
+#endif /* COMPACTOR_H_ */
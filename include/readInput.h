@@ -24,16 +24,38 @@ THE SOFTWARE.
 
 /* SPDX-License-Identifier: MIT */
 
-#include "roadc.h"
-
-void readInput(void);
-void readInputFreeArrays(void);
+#ifndef READ_INPUT_H_
+#define READ_INPUT_H_
 
-tRoadcBytePtr getInputArray(tRoadcUInt32 index);
-tRoadcBytePtr getInputPaddingByteMaskArray(tRoadcUInt32 index);
-char * getInputArrayName(tRoadcUInt32 index);
-tRoadcUInt32 getInputArraySize(tRoadcUInt32 index);
-tRoadcUInt32 getInputArrayAlignment(tRoadcUInt32 index);
+#include "roadc.h"
 
-tRoadcUInt32 getInputNumArrays(void);
-tRoadcUInt32 getInputNumBytes(void);
+/* arrays of one input file */
+struct tInputDataStruct{
+  tRoadcBytePtr *inputArrays;
+  tRoadcBytePtr *inputPaddingByteMaskArrays;
+  char **inputArraysAddressName;
+  tRoadcUInt32 *inputArraysSize;
+  tRoadcUInt32 *inputArraysAlignment;
+  tRoadcUInt32 numInputArrays;
+  tRoadcUInt32 numInputBytes;
+  tRoadcUInt32 maxNumInputArrays;
+};
+
+typedef struct tInputDataStruct tInputData;
+typedef tInputData* tInputDataPtr;
+
+void readInput(tInputDataPtr pInput, char *pFileName);
+/* return: 0: ok, 1: error in the input file, see getReadInputErrorMessage() */
+int readInputChecked(tInputDataPtr pInput, char *pFileName);
+void readInputFreeArrays(tInputDataPtr pInput);
+
+tRoadcBytePtr getInputArray(tInputDataPtr pInput, tRoadcUInt32 index);
+tRoadcBytePtr getInputPaddingByteMaskArray(tInputDataPtr pInput, tRoadcUInt32 index);
+char * getInputArrayName(tInputDataPtr pInput, tRoadcUInt32 index);
+tRoadcUInt32 getInputArraySize(tInputDataPtr pInput, tRoadcUInt32 index);
+tRoadcUInt32 getInputArrayAlignment(tInputDataPtr pInput, tRoadcUInt32 index);
+
+tRoadcUInt32 getInputNumArrays(tInputDataPtr pInput);
+tRoadcUInt32 getInputNumBytes(tInputDataPtr pInput);
+
+#endif /* READ_INPUT_H_ */
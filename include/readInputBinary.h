@@ -24,8 +24,11 @@ THE SOFTWARE.
 
 /* SPDX-License-Identifier: MIT */
 
+#include "roadc.h"
+
 #define RIB_FILL_VALUE 0
 unsigned int isBinaryArray(void);
 void consumeKeywordBinaryAndInit(void);
 void binaryClose(void);
+tRoadcBytePtr binaryTakeData(tRoadcUInt32 *pSize);
 int getNextValueBinary(void);
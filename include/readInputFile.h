@@ -24,14 +24,27 @@ THE SOFTWARE.
 
 /* SPDX-License-Identifier: MIT */
 
-void openInputFile(void);
+#include <stddef.h>
+#include <setjmp.h>
+
+#define READ_INPUT_MAX_ERROR_SIZE 1024
+
+/* error while reading the input: stops compactor, or jumps back if an error jump is set */
+void readInputError(const char *pFormat, ...) __attribute__((format(printf, 1, 2), noreturn));
+void setReadInputErrorJump(jmp_buf *pErrorJump);
+const char *getReadInputErrorMessage(void);
+
+void openInputFile(char *pFileName);
 void closeInputFile(void);
 
 char getChar(void);
 char *getString(void);
-int extractString(char *to, unsigned int consumeFlag);
-int extractNextNumberAsString(char *to, unsigned int consumeFlag);
-int extractFilename(char *to, unsigned int consumeFlag);
+char *getLineEnd(void);
+void setLinePosition(char *pNew);
+/* toSize: size of the buffer to */
+int extractString(char *to, size_t toSize, unsigned int consumeFlag);
+int extractNextNumberAsString(char *to, size_t toSize, unsigned int consumeFlag);
+int extractFilename(char *to, size_t toSize, unsigned int consumeFlag);
 int nextIsComma(unsigned int consumeFlag);
 int skipLine(void);
 
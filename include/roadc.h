@@ -56,6 +56,8 @@ THE SOFTWARE.
 
 /*! roadC unsigned integer type with size 32 bit */
 typedef unsigned long tRoadcUInt32;
+/*! roadC unsigned integer type with size 64 bit */
+typedef unsigned long long tRoadcUInt64;
 /*! roadC byte type with size 8 bit */
 typedef unsigned char tRoadcByte;
 /*! roadC byte pointer type */
@@ -63,14 +65,166 @@ typedef unsigned char* tRoadcBytePtr;
 /*! roadC float type size 64 bit */
 typedef double tRoadcFloat64;
 
+/*! Block size of the internal padding byte mask representation.
+    Padding byte masks are stored as a table of blocks of this size,
+    blocks without any padding bit are not allocated at all.
+ */
+#define ROADC_PADDING_BLOCK_SIZE 64
+
+/*! Exact calculation mode: exact calculation for small inputs only (default) */
+#define ROADC_EXACT_AUTO 0
+/*! Exact calculation mode: exact calculation whenever possible */
+#define ROADC_EXACT_ALWAYS 1
+/*! Exact calculation mode: no exact calculation */
+#define ROADC_EXACT_NEVER 2
+
+/*! Greedy strategy: equal sized arrays in the order given (default) */
+#define ROADC_STRATEGY_LARGEST_FIRST 0
+/*! Greedy strategy: equal sized arrays with the larger alignment first */
+#define ROADC_STRATEGY_ALIGNMENT_FIRST 1
+/*! Greedy strategy: equal sized arrays in random order */
+#define ROADC_STRATEGY_RANDOM 2
+/*! Greedy strategy flag: check the overlap to the right before the overlap to the left */
+#define ROADC_STRATEGY_RIGHT_FIRST 4
+
+/*! Calculation engine: greedy calculation (default) */
+#define ROADC_ENGINE_GREEDY 0
+/*! Calculation engine: cycle cover calculation */
+#define ROADC_ENGINE_CYCLE_COVER 1
+/*! Calculation engine: greedy and cycle cover calculation, the smaller result is used */
+#define ROADC_ENGINE_BEST 2
+/*! Calculation engine: greedy calculation in near linear time for arrays without padding bits and alignment */
+#define ROADC_ENGINE_SUFFIX 3
+/*! Calculation engine: selected by the number, sizes and padding bits of the arrays */
+#define ROADC_ENGINE_AUTO 4
+
+/*! Log level of the logging function: notification, in verbose mode only */
+#define ROADC_LOG_NOTIFICATION 0
+/*! Log level of the logging function: error */
+#define ROADC_LOG_ERROR 1
+
+/*! Target gap value: improve the result until the timeout (default) */
+#define ROADC_NO_TARGET_GAP (-1.0)
+
+/*! Logging function of a roadC context: user data as given by roadcSetLogFunction(),
+    log level ROADC_LOG_NOTIFICATION or ROADC_LOG_ERROR, zero terminated message */
+typedef void (*tRoadcLogFunction)(void *pUserData, tRoadcByte level, const char *pMessage);
+
+/*! Phase of roadcCalculation() in the statistics: shards */
+#define ROADC_PHASE_SHARDS 0
+/*! Phase of roadcCalculation() in the statistics: removal of multiple arrays */
+#define ROADC_PHASE_MULTIPLE 1
+/*! Phase of roadcCalculation() in the statistics: lower bound */
+#define ROADC_PHASE_LOWER_BOUND 2
+/*! Phase of roadcCalculation() in the statistics: order of the arrays (engine, local search, portfolio) */
+#define ROADC_PHASE_ORDER 3
+/*! Phase of roadcCalculation() in the statistics: concatenation */
+#define ROADC_PHASE_CONCATENATION 4
+/*! Number of phases of roadcCalculation() in the statistics */
+#define ROADC_NUMBER_PHASES 5
+/*! Phase of roadcCalculation() in the progress: no calculation running */
+#define ROADC_PHASE_NONE 0xff
+/*! Number of overlap levels in the statistics, level i counts overlaps of 2^i up to 2^(i+1)-1 bytes */
+#define ROADC_NUMBER_OVERLAP_LEVELS 32
+
+/*! Statistics of the last roadcCalculation(), see roadcGetStatistics().
+    The counters are collected only if roadC is compiled with ROADC_STATISTICS
+    defined, else they are 0. The times of the phases are always given. */
+struct tRoadcStatisticsStruct{
+  /*! 1: counters collected, 0: roadC compiled without ROADC_STATISTICS */
+  tRoadcByte counters;
+  /*! compares of bytes, arrays with padding bits are compared per padding byte mask block */
+  tRoadcUInt64 compares;
+  /*! compares failed at the first byte */
+  tRoadcUInt64 comparesRejected;
+  /*! bytes compared by all compares */
+  tRoadcUInt64 comparedBytes;
+  /*! overlaps found, by level of the overlap length */
+  tRoadcUInt64 overlapHits[ROADC_NUMBER_OVERLAP_LEVELS];
+  /*! calls of the calculation of the alignment of two merged arrays */
+  tRoadcUInt64 alignmentCalls;
+  /*! arrays merged into a new array */
+  tRoadcUInt64 merges;
+  /*! allocations of arrays and padding byte masks */
+  tRoadcUInt64 allocations;
+  /*! bytes of the allocations of arrays and padding byte masks */
+  tRoadcUInt64 allocatedBytes;
+  /*! peak bytes of all arrays and padding byte masks, for parallel threads the sum of their peaks */
+  tRoadcUInt64 peakEntryBytes;
+  /*! bytes of all arrays and padding byte masks, used for the peak */
+  tRoadcUInt64 liveEntryBytes;
+  /*! wall clock time in seconds per phase */
+  tRoadcFloat64 wallTime[ROADC_NUMBER_PHASES];
+  /*! processor time of all threads in seconds per phase */
+  tRoadcFloat64 cpuTime[ROADC_NUMBER_PHASES];
+};
+
+/*! statistics of roadcCalculation() */
+typedef struct tRoadcStatisticsStruct tRoadcStatistics;
+/*! pointer to statistics of roadcCalculation() */
+typedef tRoadcStatistics* tRoadcStatisticsPtr;
+
+/*! Progress of a running roadcCalculation(), see roadcGetProgress() */
+struct tRoadcProgressStruct{
+  /*! phase ROADC_PHASE_SHARDS ... ROADC_PHASE_CONCATENATION, ROADC_PHASE_NONE: no calculation running */
+  tRoadcByte phase;
+  /*! overlap length of the current greedy level, 0: no greedy calculation running */
+  tRoadcUInt32 overlapLevel;
+  /*! overlap length of the first greedy level */
+  tRoadcUInt32 maxOverlapLevel;
+  /*! number of arrays left */
+  tRoadcUInt32 entries;
+  /*! bytes of the arrays at the start of the calculation */
+  tRoadcUInt32 inputBytes;
+  /*! bytes of the arrays left, inputBytes-bytes are saved so far */
+  tRoadcUInt32 bytes;
+};
+
+/*! progress of roadcCalculation() */
+typedef struct tRoadcProgressStruct tRoadcProgress;
+/*! pointer to progress of roadcCalculation() */
+typedef tRoadcProgress* tRoadcProgressPtr;
+
+/*! Type of a trace event: begin of a span */
+#define ROADC_TRACE_BEGIN 'B'
+/*! Type of a trace event: end of a span */
+#define ROADC_TRACE_END 'E'
+/*! Type of a trace event: single point in time */
+#define ROADC_TRACE_INSTANT 'i'
+
+/*! Trace event recorded after roadcTraceStart(), see roadcTraceGetEvents() */
+struct tRoadcTraceEventStruct{
+  /*! name of the span or point, a string constant */
+  const char *pName;
+  /*! value of the event, e.g. overlap length of a greedy level or a merge */
+  tRoadcUInt32 value;
+  /*! number of the thread, unique in the process, starting with 1 for the first thread recording an event */
+  tRoadcUInt32 thread;
+  /*! wall clock time in seconds since roadcTraceStart() */
+  tRoadcFloat64 time;
+  /*! ROADC_TRACE_BEGIN, ROADC_TRACE_END, or ROADC_TRACE_INSTANT */
+  char type;
+};
+
+/*! trace event */
+typedef struct tRoadcTraceEventStruct tRoadcTraceEvent;
+/*! pointer to trace events */
+typedef tRoadcTraceEvent* tRoadcTraceEventPtr;
+
 /* no doxygen parsing for internal types */
 /*! \cond */
+typedef tRoadcBytePtr* tRoadcBytePtrPtr;
+
 struct tRoadcDataEntryStruct{
   tRoadcBytePtr pData;
-  tRoadcBytePtr pPaddingByteMask;
+  /* NULL: no padding bits at all
+     else: one block pointer per ROADC_PADDING_BLOCK_SIZE data bytes, NULL for blocks without padding bits */
+  tRoadcBytePtrPtr ppPaddingByteMaskBlocks;
   tRoadcUInt32 size;
   tRoadcUInt32 alignment;
   tRoadcUInt32 alignmentOffset;
+  /* index of the entry in the overlap memo of the greedy */
+  tRoadcUInt32 index;
   struct tRoadcDataEntryStruct *pPrevious;
   struct tRoadcDataEntryStruct *pNext;
 };
@@ -88,10 +242,35 @@ struct tRoadcStruct{
   tRoadcDataEntryPtr pRoadcGreedyCurrentDataEntrySmaller;
   tRoadcUInt32 roadcGreedyCurrentOverlapSize;
   tRoadcUInt32 roadcNumberDataEntries;
-  clock_t roadcStartTime;
-  clock_t roadcEndTime;
+  tRoadcFloat64 roadcStartTime;
+  tRoadcFloat64 roadcEndTime;
   tRoadcByte roadcStopedByTimeout;
   tRoadcUInt32 roadcCurrentInputSize;
+  tRoadcBytePtr pRoadcCompactedDataPaddingByteMask;
+  struct tRoadcOverlapMemoStruct *pRoadcOverlapMemo;
+  struct tRoadcLocalSearchStruct *pRoadcLocalSearch;
+  tRoadcByte roadcLocalSearchTimeShare;
+  tRoadcByte roadcExactMode;
+  tRoadcByte roadcVerbose;
+  tRoadcByte roadcStrategy;
+  tRoadcUInt64 roadcRandomState;
+  tRoadcUInt32 roadcPortfolioSize;
+  tRoadcUInt32 roadcLowerBound;
+  tRoadcFloat64 roadcTargetGap;
+  tRoadcByte roadcEngine;
+  tRoadcUInt32 *pRoadcOrder;
+  tRoadcUInt32 roadcOrderSize;
+  tRoadcByte roadcOrderError;
+  tRoadcUInt32 roadcNumberShards;
+  tRoadcLogFunction pRoadcLogFunction;
+  void *pRoadcLogUserData;
+  tRoadcUInt64 roadcMaxMemory;
+  tRoadcByte roadcMemoryError;
+  tRoadcStatistics roadcStatistics;
+  /* progress read by other threads, pRoadcProgress points to roadcProgress or
+     to the progress of the context the calculation is reported to */
+  tRoadcProgress roadcProgress;
+  tRoadcProgressPtr pRoadcProgress;
 };
 
 typedef struct tRoadcStruct tRoadc;
@@ -176,6 +355,371 @@ void roadcCalculation(tRoadcPtr pRoadc,
 		      tRoadcByte compressionLevel,
 		      tRoadcUInt32 maxTimeInSeconds);
 
+/*! \brief Enable the local search after the greedy calculation
+ 
+  The local search improves the order of the arrays found by the greedy calculation
+  by moving and reversing parts of the order. A change is only kept if the size of the
+  compacted data shrinks. 
+  The local search runs until no improving change is found or until the given share
+  of the timeout given to roadcCalculation() is elapsed. Without timeout the local
+  search always runs until no improving change is found.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] timeSharePercent 0: no local search (default); 
+                               else: share of the timeout in percent (at most 100)
+  \sa roadcCalculation
+*/
+void roadcSetLocalSearch(tRoadcPtr pRoadc,
+			 tRoadcByte timeSharePercent);
+
+/*! \brief Select the exact calculation
+ 
+  For a small number of arrays (after removing multiple arrays) the order of the
+  arrays with the largest sum of overlaps can be calculated exactly instead of 
+  using the greedy calculation only. The result of the exact calculation is used
+  if it is not larger than the greedy result. Time and memory grow exponentially
+  with the number of arrays, so the exact calculation is limited to at most 20 arrays 
+  (ROADC_EXACT_ALWAYS) or 16 arrays (ROADC_EXACT_AUTO).
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] exactMode ROADC_EXACT_AUTO (default), ROADC_EXACT_ALWAYS, or ROADC_EXACT_NEVER
+  \sa roadcCalculation
+*/
+void roadcSetExact(tRoadcPtr pRoadc,
+		   tRoadcByte exactMode);
+
+/*! \brief Select the calculation engine
+ 
+  The greedy calculation merges the arrays with the largest overlap first. 
+  The cycle cover calculation assigns a successor to every array with the largest
+  sum of overlaps, merges the arrays of every cycle of the assignment, and repeats
+  this for the merged arrays. Depending on the data either one gives the smaller
+  result. The successor of an array in the cycle cover calculation is one of 
+  the 16 arrays with the largest overlaps to it. The local search (see 
+  roadcSetLocalSearch()) improves the greedy result only.
+
+  The suffix greedy calculation (ROADC_ENGINE_SUFFIX) finds the greedy merge
+  order without comparing pairs of arrays, in time near linear in the sum of
+  the array sizes. It is intended for very many arrays. Only arrays without 
+  padding bits and with alignment 1 are merged by it, the other arrays are 
+  merged by the greedy calculation afterwards. Without such other arrays the
+  greedy calculation and the local search are not used.
+
+  ROADC_ENGINE_AUTO selects one of the engines at the begin of the calculation
+  of the order: the suffix greedy calculation for very many compares of mostly
+  arrays without padding bits and alignment, the greedy and cycle cover 
+  calculation for up to 256 arrays, and else the greedy calculation. The 
+  selection is notified in verbose mode.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] engine ROADC_ENGINE_GREEDY (default), ROADC_ENGINE_CYCLE_COVER, ROADC_ENGINE_BEST, ROADC_ENGINE_SUFFIX, or ROADC_ENGINE_AUTO
+  \sa roadcCalculation
+*/
+void roadcSetEngine(tRoadcPtr pRoadc,
+		    tRoadcByte engine);
+
+/*! \brief Select the strategy of the greedy calculation
+ 
+  The greedy calculation merges the arrays with the largest overlap first. 
+  The strategy selects the order of arrays with equal size and whether the 
+  overlap to the left or to the right of an array is checked first. 
+  Which strategy gives the smallest result depends on the data.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] strategy ROADC_STRATEGY_LARGEST_FIRST (default), ROADC_STRATEGY_ALIGNMENT_FIRST, 
+                      or ROADC_STRATEGY_RANDOM, optionally combined with ROADC_STRATEGY_RIGHT_FIRST
+  \param[in] seed seed of the random order for ROADC_STRATEGY_RANDOM
+  \sa roadcCalculation, roadcSetPortfolio
+*/
+void roadcSetStrategy(tRoadcPtr pRoadc,
+		      tRoadcByte strategy,
+		      tRoadcUInt32 seed);
+
+/*! \brief Select the number of greedy calculations running in parallel
+ 
+  With a portfolio of more than one calculation, the exact calculation, the greedy 
+  calculation, and the local search run in parallel threads, each with its own 
+  strategy (see roadcSetStrategy()). The smallest result is used. 
+  The first calculation always uses the strategy selected for the context, the 
+  exact calculation runs in the first calculation only.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] numberCalculations 0 or 1: no portfolio (default); 
+                                 else: number of calculations running in parallel
+  \sa roadcCalculation, roadcSetStrategy
+*/
+void roadcSetPortfolio(tRoadcPtr pRoadc,
+		       tRoadcUInt32 numberCalculations);
+
+/*! \brief Select the number of shards calculated in parallel
+ 
+  With more than one shard, the arrays are split into shards of similar arrays 
+  (MinHash of the contents) before removing multiple arrays. Every shard is 
+  calculated in its own thread, afterwards the merged arrays of all shards are
+  calculated again to find the overlaps between shards. This is much faster 
+  for very many arrays, but overlaps of arrays in different shards may be 
+  missed, so the result can be larger. At most 256 shards are used.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] numberShards 0 or 1: no shards (default); 
+                           else: number of shards calculated in parallel
+  \sa roadcCalculation, roadcSetPortfolio
+*/
+void roadcSetShards(tRoadcPtr pRoadc,
+		    tRoadcUInt32 numberShards);
+
+/*! \brief Stop improving the result at the given gap to the lower bound
+ 
+  A lower bound of the compacted data size is calculated after removing multiple 
+  arrays. The local search stops as soon as the size of the compacted data is 
+  at most the given percentage above the lower bound, e.g. a target gap of 5 
+  stops at a size of at most 105% of the lower bound. 
+  In verbose mode the lower bound and the gap of the result are always given.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] gapPercent ROADC_NO_TARGET_GAP (default), else gap to the lower bound in percent
+  \sa roadcCalculation, roadcSetLocalSearch
+*/
+void roadcSetTargetGap(tRoadcPtr pRoadc,
+		       tRoadcFloat64 gapPercent);
+
+/*! \brief Enable notification messages on stdout
+ 
+  The messages are given to the logging function instead if one is set 
+  by roadcSetLogFunction().
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] verbose 0: no messages (default); else: messages on stdout
+*/
+void roadcSetVerbose(tRoadcPtr pRoadc,
+		     tRoadcByte verbose);
+
+/*! \brief Set the logging function of a roadC context
+ 
+  Without logging function notifications (verbose mode, see roadcSetVerbose())
+  are written to stdout and errors to stderr. With a logging function all 
+  messages of this context are given to this function, e.g. to write them
+  into the log of an application running several contexts in parallel. 
+  The function is called in the thread which calls the roadC function.
+
+  roadC has no global state apart from the trace (see roadcTraceStart()): 
+  different contexts can be used by different threads at the same time, one 
+  context must be used by one thread at a time.
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] pLogFunction logging function, NULL: stdout and stderr (default)
+  \param[in] pUserData given to the logging function with every message
+*/
+void roadcSetLogFunction(tRoadcPtr pRoadc,
+			 tRoadcLogFunction pLogFunction,
+			 void *pUserData);
+
+/*! \brief Set the memory budget of roadcCalculation()
+ 
+  Calculation steps which need memory in addition to the arrays are skipped
+  if they do not fit into the budget: exact calculation, cycle cover, overlap
+  memo of the greedy, and local search. The number of parallel calculations 
+  of the portfolio is reduced. For the concatenation every array is freed 
+  after its copy into the compacted data if the arrays and the compacted data
+  do not fit together. The budget is a limit for these decisions, not for 
+  every single allocation. If an allocation fails anyway, the arrays merged 
+  so far are concatenated, see also roadcGetMemoryError().
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] maxMemoryInMegabytes 0: no budget (default), else budget in megabytes
+  \sa roadcCalculation, roadcGetMemoryError
+*/
+void roadcSetMaxMemory(tRoadcPtr pRoadc,
+		       tRoadcUInt32 maxMemoryInMegabytes);
+
+/*! \brief Check if the compacted data is not valid because of a failed allocation
+ 
+  \pre compress data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \return 0: ok; 1: not enough memory to add an array or to concatenate the
+          arrays, the compacted data is missing or incomplete
+  \sa roadcSetMaxMemory, roadcAddElement
+*/
+tRoadcByte roadcGetMemoryError(tRoadcPtr pRoadc);
+
+/*! \brief Get the statistics of the calculation
+ 
+  Wall clock and processor time of every phase of the last roadcCalculation(),
+  see ROADC_PHASE_SHARDS ... ROADC_PHASE_CONCATENATION. If roadC is compiled 
+  with ROADC_STATISTICS defined, also the counters of the calculation kernels:
+  compares and compared bytes, overlaps found by length, calls of the alignment 
+  calculation, merged arrays, allocations, and the peak memory of the arrays.
+  Without ROADC_STATISTICS the counters are not compiled at all, so they do not
+  slow down the calculation.
+
+  \pre compress data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[out] pStatistics statistics of the last roadcCalculation()
+  \sa roadcCalculation
+*/
+void roadcGetStatistics(tRoadcPtr pRoadc,
+			tRoadcStatisticsPtr pStatistics);
+
+/*! \brief Get the progress of a running calculation
+ 
+  May be called by another thread while roadcCalculation() runs, e.g. to
+  report the progress every second. The calculation updates the progress by
+  relaxed atomic stores at every phase, greedy level, and merge. The level 
+  and the arrays left are given for the greedy calculation and the removal of
+  multiple arrays, the other engines update them at their end. For a 
+  portfolio the first calculation is reported.
+
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[out] pProgress progress of the running calculation
+  \sa roadcCalculation
+*/
+void roadcGetProgress(tRoadcPtr pRoadc,
+                      tRoadcProgressPtr pProgress);
+
+/*! \brief Start recording trace events
+ 
+  The trace is recorded for all roadC contexts and all threads of the 
+  process: the phases of roadcCalculation(), every level of the greedy 
+  calculation, the merges of arrays, and the spans given by roadcTraceBegin()
+  and roadcTraceEnd() of the application. The trace is process-wide state,
+  there is one trace for all contexts: the events of contexts running at the
+  same time are mixed (each with the number of its thread), and a trace 
+  started before is deleted, also if it was started for another context.
+  On Linux with <sys/sdt.h> available, every event is also a USDT probe of
+  the provider roadc (begin, end, instant with the name and the value as
+  arguments), these probes are active without recording a trace.
+
+  \sa roadcTraceStop, roadcTraceGetEvents
+*/
+void roadcTraceStart(void);
+
+/*! \brief Stop recording trace events and delete the trace
+ 
+  \sa roadcTraceStart
+*/
+void roadcTraceStop(void);
+
+/*! \brief Begin of a span in the trace of the calling thread
+ 
+  \param[in] pName name of the span, a string constant
+  \param[in] value value of the span
+  \sa roadcTraceEnd, roadcTraceStart
+*/
+void roadcTraceBegin(const char *pName,
+                     tRoadcUInt32 value);
+
+/*! \brief End of a span in the trace of the calling thread
+ 
+  \param[in] pName name of the span as given by roadcTraceBegin()
+  \param[in] value value of the span
+  \sa roadcTraceBegin, roadcTraceStart
+*/
+void roadcTraceEnd(const char *pName,
+                   tRoadcUInt32 value);
+
+/*! \brief Get the trace events recorded since roadcTraceStart()
+ 
+  The events of all threads in the order they are recorded. If the memory
+  for further events could not be allocated, the recording stopped before.
+
+  \pre no thread records events while the events are read
+  \param[out] pNumberEvents number of events
+  \param[out] pComplete 1: all events recorded, 0: recording stopped because of a failed allocation
+  \return pointer to the events, valid until roadcTraceStart() or roadcTraceStop()
+  \sa roadcTraceStart
+*/
+tRoadcTraceEventPtr roadcTraceGetEvents(tRoadcUInt32 *pNumberEvents,
+                                        tRoadcByte *pComplete);
+
+/*! \brief Estimate the compacted data size and the calculation time
+ 
+  A fast estimate before roadcCalculation() with the same settings, e.g. to
+  select the timeout or the engine. The arrays are not changed. Some arrays
+  are sampled and compared to all arrays by hashes of their first bytes,
+  prefixes, and suffixes. The size saved by arrays contained in other arrays
+  and by overlaps is extrapolated from the sampled arrays. The time is 
+  extrapolated from the measured time of compares of the sampled arrays and
+  the number of compares of the selected engine. Both are rough estimates,
+  the estimate takes a small fraction of a second. In verbose mode the 
+  estimated time of every engine is given.
+
+  \pre add data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] maxTimeInSeconds timeout of roadcCalculation() in seconds, no timeout if 0
+  \param[out] pCompactedDataSize estimated compacted data size
+  \param[out] pTimeInSeconds estimated time of roadcCalculation() in seconds
+  \return 0: ok, 1: malloc failed
+  \sa roadcCalculation, roadcSetEngine
+*/
+tRoadcByte roadcEstimate(tRoadcPtr pRoadc,
+			 tRoadcUInt32 maxTimeInSeconds,
+			 tRoadcUInt32 *pCompactedDataSize,
+			 tRoadcFloat64 *pTimeInSeconds);
+
+/*! \brief Get the overlap graph as asymmetric traveling salesman problem
+ 
+  Multiple arrays are removed as done by roadcCalculation(). The order of the 
+  arrays left with the smallest compacted data is a shortest tour through the 
+  overlap graph: node 0 is the start and end of the tour, node i (1..n) is 
+  the i-th array left. The distance from node i to node j is the size of 
+  array j minus the largest alignment compatible overlap of array i followed
+  by array j, the distance from node 0 to node j is the size of array j, and
+  the distance to node 0 is 0. The distance from a node to itself is 
+  forbidden, i.e. larger than any tour.
+
+  \pre add data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] maxTimeInSeconds timeout in seconds, no timeout if 0
+  \param[out] pDimension number of nodes
+  \return distance matrix, distance from node i to node j at i*dimension+j,
+          has to be freed by the caller with free(); NULL if malloc failed, the
+          matrix exceeds the memory budget (see roadcSetMaxMemory()), or timeout
+  \sa roadcSetOrder
+*/
+tRoadcUInt32 *roadcGetOverlapGraph(tRoadcPtr pRoadc,
+				   tRoadcUInt32 maxTimeInSeconds,
+				   tRoadcUInt32 *pDimension);
+
+/*! \brief Set the order of the arrays for roadcCalculation()
+ 
+  The arrays left after removing multiple arrays are merged in the given order 
+  instead of the calculation of the order, e.g. for an order given by an 
+  external solver for the overlap graph of roadcGetOverlapGraph(). Every array
+  is merged with the largest alignment compatible overlap to the previous 
+  merged arrays. If the order does not contain every array once, the order is
+  not used (see roadcGetOrderError()).
+
+  \pre get roadc context data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \param[in] pOrder array numbers 0..numberArrays-1 (node numbers of 
+                    roadcGetOverlapGraph() minus 1), NULL for no order
+  \param[in] numberArrays number of arrays in pOrder
+  \return 0: ok, 1: malloc failed
+  \sa roadcGetOverlapGraph, roadcGetOrderError
+*/
+tRoadcByte roadcSetOrder(tRoadcPtr pRoadc,
+			 tRoadcUInt32 *pOrder,
+			 tRoadcUInt32 numberArrays);
+
+/*! \brief Check if the order given by roadcSetOrder() was not used
+ 
+  \pre compress data before calling this function
+  \param[in] pRoadc pointer to roadC context data as given by roadcNew()
+  \return 0: order used or no order given; 1: order does not match the arrays
+  \sa roadcSetOrder
+*/
+tRoadcByte roadcGetOrderError(tRoadcPtr pRoadc);
+
 /*! \brief Get the resulting array after roadC calculation
  
   \pre compress data before calling this function
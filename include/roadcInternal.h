@@ -0,0 +1,364 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcInternal.h
+ *  @brief Internal definitions shared by the roadC modules.
+ *
+ *  This contains defines and prototypes used by the roadC
+ *  implementation files only. It is not part of the roadC API.
+ */
+
+#ifndef ROADC_INTERNAL_H_
+#define ROADC_INTERNAL_H_
+
+#include "roadc.h"
+
+/* use next define for standard print output of some internal roadc information */
+#define ROADC_PRINTINTERNALS
+
+#ifdef ROADC_PRINTINTERNALS
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+#define ROADC_NOTIFICATION_MSG(pRoadc, ...) if((pRoadc)->roadcVerbose){roadcLog((pRoadc), ROADC_LOG_NOTIFICATION, __VA_ARGS__);}
+#define ROADC_ERROR_MSG(pRoadc, ...) roadcLog((pRoadc), ROADC_LOG_ERROR, __VA_ARGS__)
+#else
+#define ROADC_NOTIFICATION_MSG(pRoadc, ...)
+#define ROADC_ERROR_MSG(pRoadc, ...)
+#endif /* ROADC_PRINTINTERNALS */
+
+/* define ROADC_STATISTICS (make STATISTICS=1) to count in the kernels for roadcGetStatistics(),
+   without it the counters are not compiled at all */
+#ifdef ROADC_STATISTICS
+/* statistics of the calculation running in the thread, NULL: none */
+extern __thread tRoadcStatisticsPtr pRoadcStatisticsThread;
+#define ROADC_STATISTICS_ADD(counter, value) if(pRoadcStatisticsThread!=NULL){pRoadcStatisticsThread->counter += (value);}
+#define ROADC_STATISTICS_COMPARE(bytes, equal) if(pRoadcStatisticsThread!=NULL){roadcStatisticsCompare(pRoadcStatisticsThread, (bytes), (equal));}
+#define ROADC_STATISTICS_OVERLAP_HIT(overlap) if(pRoadcStatisticsThread!=NULL){roadcStatisticsOverlapHit(pRoadcStatisticsThread, (overlap));}
+#define ROADC_STATISTICS_ALLOCATION(bytes) if(pRoadcStatisticsThread!=NULL){roadcStatisticsAllocation(pRoadcStatisticsThread, (bytes));}
+#define ROADC_STATISTICS_FREE(bytes) if(pRoadcStatisticsThread!=NULL){pRoadcStatisticsThread->liveEntryBytes -= (bytes);}
+#else
+#define ROADC_STATISTICS_ADD(counter, value)
+#define ROADC_STATISTICS_COMPARE(bytes, equal)
+#define ROADC_STATISTICS_OVERLAP_HIT(overlap)
+#define ROADC_STATISTICS_ALLOCATION(bytes)
+#define ROADC_STATISTICS_FREE(bytes)
+#endif /* ROADC_STATISTICS */
+
+/* progress of a merge or removal for roadcGetProgress() of another thread, relaxed atomic access */
+#define ROADC_PROGRESS_SAVED(pRoadc, savedBytes) do{ \
+  __atomic_fetch_sub(&(pRoadc)->pRoadcProgress->bytes, (tRoadcUInt32)(savedBytes), __ATOMIC_RELAXED); \
+  __atomic_store_n(&(pRoadc)->pRoadcProgress->entries, (pRoadc)->roadcNumberDataEntries, __ATOMIC_RELAXED); \
+  }while(0)
+
+#ifdef __cplusplus
+#include <cstdlib>
+#else
+#include <stdlib.h>
+#endif /* __cplusplus */
+
+#ifndef __cplusplus
+#ifndef NULL
+#define NULL ((void *)0)
+#endif /* NULL */
+#endif /* __cplusplus */
+
+/* value to calculate without timeout in roadcCalculation() */ 
+#define ROADC_NO_TIMEOUT 0
+/* Define for padding byte mask values: is no padding byte */
+#define ROADC_NO_PADDING_BITS 0
+/* Define for padding byte mask values: all bits are padding bits */
+#define ROADC_ALL_PADDING_BITS 255
+/* number of padding byte mask blocks for a data entry of the given size */
+#define ROADC_PADDING_BLOCK_NUMBER(size) (((size)+ROADC_PADDING_BLOCK_SIZE-1)/ROADC_PADDING_BLOCK_SIZE)
+/* overlap found in a greedy step: none, smaller array right of larger array (left), 
+   smaller array left of larger array (right) */
+#define ROADC_GREEDY_OVERLAP_NONE 0
+#define ROADC_GREEDY_OVERLAP_LEFT 1
+#define ROADC_GREEDY_OVERLAP_RIGHT 2
+
+/* overlap memo of the greedy, two values per ordered pair of the arrays 
+   with padding bits, the other pairs are compared directly */
+struct tRoadcOverlapMemoStruct{
+  tRoadcUInt32 numberIndices;
+  /* memo index by array index, numberIndices: not in the memo */
+  tRoadcUInt32 *pIndex;
+  tRoadcUInt32 numberEntries;
+  /* overlaps up to this length are known, 0: nothing known */
+  tRoadcUInt32 *pBound;
+  /* largest overlap length up to pBound, 0: no overlap, all bits set: checked by compares */
+  tRoadcUInt32 *pLargest;
+  /* buffer for the overlap lengths of a pair */
+  tRoadcUInt64 *pLengths;
+  tRoadcUInt32 numberLengthWords;
+};
+
+typedef struct tRoadcOverlapMemoStruct tRoadcOverlapMemo;
+typedef tRoadcOverlapMemo* tRoadcOverlapMemoPtr;
+
+/* local search data, recorded during the greedy */
+struct tRoadcLocalSearchStruct{
+  tRoadcUInt32 numberEntries;
+  /* copies of the arrays before the greedy, by index */
+  tRoadcDataEntryPtrPtr ppEntries;
+  /* next index in the merge chain, numberEntries: end of chain */
+  tRoadcUInt32 *pChainNext;
+  /* last index of the merge chain starting with this index */
+  tRoadcUInt32 *pChainLast;
+};
+
+typedef struct tRoadcLocalSearchStruct tRoadcLocalSearch;
+typedef tRoadcLocalSearch* tRoadcLocalSearchPtr;
+
+/* statistics of the arrays for the selection of the calculation kernels */
+struct tRoadcProfileStruct{
+  tRoadcUInt32 numberEntries;
+  /* number of different array sizes */
+  tRoadcUInt32 numberSizes;
+  /* number of arrays without padding bits and alignment */
+  tRoadcUInt32 numberPlain;
+  /* number of arrays with padding bits */
+  tRoadcUInt32 numberMasked;
+  tRoadcUInt64 sumSizes;
+  /* number of compares of the greedy calculation, of all arrays and of the
+     arrays left by the suffix greedy calculation */
+  tRoadcFloat64 compares;
+  tRoadcFloat64 suffixCompares;
+};
+
+typedef struct tRoadcProfileStruct tRoadcProfile;
+typedef tRoadcProfile* tRoadcProfilePtr;
+
+/* roadc.c */
+void roadcLog(tRoadcPtr pRoadc,
+              tRoadcByte level,
+              const char *pFormat,
+              ...);
+void roadcInitDataEntry(tRoadcDataEntryPtr pEntry);
+tRoadcBytePtr roadcPaddingByteMaskSegment(tRoadcDataEntryPtr pEntry,
+                                          tRoadcUInt32 index,
+                                          tRoadcUInt32 *pSegmentLength);
+tRoadcByte roadcPaddingByteMaskGet(tRoadcDataEntryPtr pEntry,
+                                   tRoadcUInt32 index);
+tRoadcByte roadcAlignmentPositionInResultCheck(tRoadcUInt32 alignmentResult, 
+                                               tRoadcUInt32 alignmentInputArray, 
+                                               tRoadcUInt32 positionInResult);
+tRoadcByte roadcArraysEqual(tRoadcBytePtr pArr1, 
+                            tRoadcBytePtr pArr1PaddingByteMask,
+                            tRoadcBytePtr pArr2, 
+                            tRoadcBytePtr pArr2PaddingByteMask,
+                            tRoadcUInt32 length);
+tRoadcByte roadcDataEntriesEqual(tRoadcDataEntryPtr pEntry1,
+                                 tRoadcUInt32 index1,
+                                 tRoadcDataEntryPtr pEntry2,
+                                 tRoadcUInt32 index2,
+                                 tRoadcUInt32 length);
+tRoadcByte roadcIsOverlap(tRoadcDataEntryPtr pLeftArray,
+                          tRoadcDataEntryPtr pRightArray,
+                          tRoadcUInt32 overlap);
+tRoadcUInt32 roadcArrayGetPosition(tRoadcDataEntryPtr pThisArray,
+                                   tRoadcDataEntryPtr pInThisArray);
+tRoadcByte roadcAlignmentMergeCalculation(tRoadcDataEntryPtr pLeft,
+                                          tRoadcDataEntryPtr pRight,
+                                          tRoadcUInt32 overlapBeginIndex,
+                                          tRoadcDataEntryPtr pResult);
+void roadcAdaptInPlacePaddingByteMaskForCaseOverlap(tRoadcDataEntryPtr pThisArrayAdaptInPlace, 
+                                                    tRoadcUInt32 position,
+                                                    tRoadcDataEntryPtr pWithThisArrayAdaptInPlace,
+                                                    tRoadcUInt32 size);
+tRoadcDataEntryPtr roadcNewRoadcDataEntry(tRoadcBytePtr pInputArray,
+                                          tRoadcUInt32 inputArraySize,
+                                          tRoadcBytePtr pInputPaddingByteMask,
+                                          tRoadcUInt32 inputAlignment);
+tRoadcDataEntryPtr roadcNewRoadcDataEntryByConcatenation(tRoadcDataEntryPtr pElem1, 
+                                                         tRoadcDataEntryPtr pElem2,
+                                                         tRoadcUInt32 newAlignment,
+                                                         tRoadcUInt32 newAlignmentOffset,
+                                                         tRoadcUInt32 elem2OverlapSize);
+tRoadcDataEntryPtr roadcNewRoadcDataEntryByCopy(tRoadcDataEntryPtr pFrom);
+void roadcFreeRoadcDataEntry(tRoadcDataEntryPtr pElem);
+void roadcInsertDataEntry(tRoadcPtr pRoadc,
+                          tRoadcDataEntryPtr pNewElem);
+void roadcRemoveDataEntry(tRoadcPtr pRoadc,
+                          tRoadcDataEntryPtr pElem);
+void roadcDeleteEntries(tRoadcPtr pRoadc);
+void roadcIndexDataEntries(tRoadcPtr pRoadc);
+tRoadcUInt32 roadcConcatenationSize(tRoadcDataEntryPtr pFirst);
+tRoadcByte roadcConcatenation(tRoadcPtr pRoadc);
+tRoadcByte roadcCopyDataEntries(tRoadcPtr pRoadc,
+                                tRoadcPtr pTo);
+void roadcReplaceDataEntries(tRoadcPtr pRoadc,
+                             tRoadcPtr pFrom);
+tRoadcFloat64 roadcTimerNow(void);
+tRoadcFloat64 roadcTimerCpuNow(void);
+void roadcTimerStart(tRoadcPtr pRoadc);
+tRoadcUInt32 roadcTimerRead(tRoadcPtr pRoadc);
+void roadcCalculationMultiple(tRoadcPtr pRoadc,
+                              tRoadcUInt32 maxTimeInSeconds);
+tRoadcByte roadcCalculationOrder(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds);
+tRoadcByte roadcTargetGapReached(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 size);
+tRoadcUInt64 roadcDataEntriesMemory(tRoadcPtr pRoadc);
+tRoadcByte roadcMemoryAvailable(tRoadcPtr pRoadc,
+                                tRoadcUInt64 memory,
+                                const char *pUsage);
+
+/* roadcBound.c */
+tRoadcUInt32 roadcLowerBound(tRoadcPtr pRoadc,
+                             tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcDispatch.c */
+const char *roadcDispatchEngineName(tRoadcByte engine);
+void roadcProfile(tRoadcPtr pRoadc,
+                  tRoadcProfilePtr pProfile);
+tRoadcByte roadcDispatchEngineSelect(tRoadcProfilePtr pProfile);
+tRoadcByte roadcDispatchEngine(tRoadcPtr pRoadc);
+tRoadcByte roadcDispatchMultipleIsHash(tRoadcProfilePtr pProfile);
+tRoadcByte roadcDispatchMultiple(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcMultipleHash.c */
+tRoadcByte roadcMultipleHashCalculation(tRoadcPtr pRoadc,
+                                        tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcStatistics.c */
+void roadcStatisticsInit(tRoadcStatisticsPtr pStatistics);
+tRoadcStatisticsPtr roadcStatisticsStart(tRoadcPtr pRoadc);
+void roadcStatisticsStop(tRoadcStatisticsPtr pPrevious);
+tRoadcStatisticsPtr roadcStatisticsThreadSet(tRoadcStatisticsPtr pStatistics);
+void roadcStatisticsAddThread(tRoadcStatisticsPtr pTo,
+                              tRoadcStatisticsPtr pFrom,
+                              tRoadcUInt64 *pPeakThreads);
+void roadcStatisticsPeak(tRoadcStatisticsPtr pStatistics,
+                         tRoadcUInt64 bytes);
+void roadcStatisticsPhase(tRoadcStatisticsPtr pStatistics,
+                          tRoadcByte phase,
+                          tRoadcFloat64 wallTime,
+                          tRoadcFloat64 cpuTime);
+void roadcStatisticsCompare(tRoadcStatisticsPtr pStatistics,
+                            tRoadcUInt32 bytes,
+                            tRoadcByte equal);
+void roadcStatisticsOverlapHit(tRoadcStatisticsPtr pStatistics,
+                               tRoadcUInt32 overlap);
+void roadcStatisticsAllocation(tRoadcStatisticsPtr pStatistics,
+                               tRoadcUInt64 bytes);
+
+/* roadcProgress.c */
+void roadcProgressInit(tRoadcPtr pRoadc);
+void roadcProgressPhase(tRoadcPtr pRoadc,
+                        tRoadcByte phase);
+void roadcProgressStart(tRoadcPtr pRoadc);
+void roadcProgressLevel(tRoadcPtr pRoadc,
+                        tRoadcUInt32 level,
+                        tRoadcUInt32 maxLevel);
+
+/* roadcTrace.c */
+void roadcTraceRecord(char type,
+                      const char *pName,
+                      tRoadcUInt32 value);
+void roadcTraceInstant(const char *pName,
+                       tRoadcUInt32 value);
+
+/* roadcOverlapGraph.c */
+tRoadcByte roadcOverlapGraphOrderIsValid(tRoadcPtr pRoadc);
+tRoadcByte roadcOverlapGraphOrderCalculation(tRoadcPtr pRoadc);
+
+/* roadcPortfolio.c */
+tRoadcByte roadcPortfolioCalculation(tRoadcPtr pRoadc,
+                                     tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcShard.c */
+tRoadcByte roadcShardCalculation(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcSuffixGreedy.c */
+tRoadcByte roadcSuffixIsPossible(tRoadcDataEntryPtr pEntry);
+tRoadcByte roadcSuffixGreedyCalculation(tRoadcPtr pRoadc,
+                                        tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcCycleCover.c */
+tRoadcUInt64 roadcCycleCoverMemory(tRoadcPtr pRoadc);
+tRoadcByte roadcCycleCoverCalculation(tRoadcPtr pRoadc,
+                                      tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcExact.c */
+tRoadcUInt32 roadcExactMaxEntries(tRoadcPtr pRoadc);
+tRoadcByte roadcExactIsSelected(tRoadcPtr pRoadc);
+tRoadcByte roadcExactCalculation(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds,
+                                 tRoadcPtr pResult);
+
+/* roadcLocalSearch.c */
+void roadcLocalSearchNew(tRoadcPtr pRoadc);
+void roadcLocalSearchDelete(tRoadcPtr pRoadc);
+void roadcLocalSearchRecordMerge(tRoadcPtr pRoadc,
+                                 tRoadcDataEntryPtr pLeft,
+                                 tRoadcDataEntryPtr pRight);
+void roadcLocalSearchCalculation(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds);
+
+/* roadcWildcardMatch.c */
+tRoadcByte roadcWildcardMatchIsFaster(tRoadcDataEntryPtr pThisArray,
+                                      tRoadcDataEntryPtr pInThisArray);
+tRoadcByte roadcWildcardMatchGetPosition(tRoadcDataEntryPtr pThisArray,
+                                         tRoadcDataEntryPtr pInThisArray,
+                                         tRoadcUInt32 *pPosition);
+
+/* roadcOverlap.c */
+tRoadcByte roadcOverlapLengths(tRoadcDataEntryPtr pLeftArray,
+                               tRoadcDataEntryPtr pRightArray,
+                               tRoadcUInt32 maxLength,
+                               tRoadcUInt64 *pLengths);
+tRoadcUInt32 roadcOverlapLargest(tRoadcDataEntryPtr pLeftArray,
+                                 tRoadcDataEntryPtr pRightArray,
+                                 tRoadcUInt32 maxLength,
+                                 tRoadcDataEntryPtr pCalcResult,
+                                 tRoadcByte *pMallocError);
+tRoadcByte roadcOverlapMatrixRow(tRoadcDataEntryPtrPtr ppEntries,
+                                 tRoadcUInt32 numberEntries,
+                                 tRoadcUInt32 row,
+                                 tRoadcUInt32 *pOverlaps);
+tRoadcByte roadcOverlapRow(tRoadcDataEntryPtrPtr ppEntries,
+                           tRoadcUInt32 numberEntries,
+                           tRoadcUInt32 row,
+                           tRoadcUInt32 *pRowOverlaps);
+tRoadcByte roadcOverlapMergeOrder(tRoadcDataEntryPtrPtr ppEntries,
+                                  tRoadcUInt32 numberEntries,
+                                  tRoadcUInt32 *pOrder,
+                                  tRoadcPtr pResult);
+void roadcOverlapMemoNew(tRoadcPtr pRoadc);
+void roadcOverlapMemoDelete(tRoadcPtr pRoadc);
+void roadcOverlapMemoReplace(tRoadcPtr pRoadc,
+                             tRoadcDataEntryPtr pNewElem);
+tRoadcByte roadcOverlapMemoIsOverlap(tRoadcPtr pRoadc,
+                                     tRoadcDataEntryPtr pLeftArray,
+                                     tRoadcDataEntryPtr pRightArray,
+                                     tRoadcUInt32 overlap);
+
+#endif /* ROADC_INTERNAL_H_ */
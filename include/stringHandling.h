@@ -25,10 +25,20 @@ THE SOFTWARE.
 /* SPDX-License-Identifier: MIT */
 
 
+/* charDigitValue: no digit */
+#define CHAR_NO_DIGIT 0xff
+/* charClass: separator between values */
+#define CHAR_CLASS_SEPARATOR 1
+/* charClass: end of a value */
+#define CHAR_CLASS_VALUE_END 2
+/* larger values are not converted exactly */
+#define CONVERT_MAX_VALUE 0xffffff
+
+extern const unsigned char charDigitValue[256];
+extern const unsigned char charClass[256];
+
+int convertNumber(const char *pStart, const char *pEnd, int base);
 int convertPositiveDecimal(char *str);
-int convertNegativeDecimal(char *str);
-int convertHexadecimal(char *str);
-int convertBinary(char *str);
-int convertOctal(char *str);
+int convertNegativeDecimal(const char *pStart, const char *pEnd);
 /* handels only charset 1 */
 int convertChar(char *str);
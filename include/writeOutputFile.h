@@ -24,7 +24,8 @@ THE SOFTWARE.
 
 /* SPDX-License-Identifier: MIT */
 
-#include "roadc.h"
+#include "compactor.h"
 
-void writeOutputFile(void);
+tRoadcUInt32 getCompactedArrayPosition(tCompactorJobPtr pJob, tRoadcUInt32 index);
+void writeOutputFile(tCompactorJobPtr pJob);
 
@@ -0,0 +1,299 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/* printf() */
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "compactor.h"
+#include "commandLineParameter.h"
+#include "readInput.h"
+#include "writeOutputFile.h"
+#include "batchProcessing.h"
+
+#define BATCH_MAX_LINE_SIZE 4096
+
+struct tBatchEntryStruct{
+  tCompactorJob job;
+  long fileSize;
+  tRoadcUInt32 index;
+};
+
+typedef struct tBatchEntryStruct tBatchEntry;
+typedef tBatchEntry* tBatchEntryPtr;
+
+struct tBatchWorkerStruct{
+  int threadStarted;
+  pthread_t thread;
+};
+
+typedef struct tBatchWorkerStruct tBatchWorker;
+typedef tBatchWorker* tBatchWorkerPtr;
+
+static tBatchEntryPtr pBatchEntries = (tBatchEntryPtr)NULL;
+static tRoadcUInt32 numberBatchEntries = 0;
+static tRoadcUInt32 maxNumberBatchEntries = 0;
+/* next entry to calculate, the entries are sorted largest first */
+static tRoadcUInt32 nextBatchEntry = 0;
+static pthread_mutex_t batchQueueMutex = PTHREAD_MUTEX_INITIALIZER;
+/* the input reader keeps its state in static variables */
+static pthread_mutex_t batchReadMutex = PTHREAD_MUTEX_INITIALIZER;
+
+char *batchCopyString(const char *pString){
+  char *pCopy;
+
+  pCopy = (char *)malloc(strlen(pString)+1);
+  if(pCopy==(char *)NULL){
+    fprintf (stderr, "Can not allocate memory for batch job.\n");
+    exit(0);
+  }
+  strcpy(pCopy, pString);
+  return pCopy;
+}
+
+/* file name with appended extension as default output file name */
+char *batchDefaultFileName(const char *pFileIn, const char *pExtension){
+  char *pFileName;
+
+  pFileName = (char *)malloc(strlen(pFileIn)+strlen(pExtension)+1);
+  if(pFileName==(char *)NULL){
+    fprintf (stderr, "Can not allocate memory for batch job.\n");
+    exit(0);
+  }
+  strcpy(pFileName, pFileIn);
+  strcat(pFileName, pExtension);
+  return pFileName;
+}
+
+void batchAddEntry(const char *pFileIn, const char *pFileOut, const char *pFileOutBinary){
+  tBatchEntryPtr pEntry;
+  FILE *fp;
+
+  if(numberBatchEntries>=maxNumberBatchEntries){
+    maxNumberBatchEntries = maxNumberBatchEntries*2+16;
+    pBatchEntries = (tBatchEntryPtr)realloc(pBatchEntries, maxNumberBatchEntries*sizeof(tBatchEntry));
+    if(pBatchEntries==(tBatchEntryPtr)NULL){
+      fprintf (stderr, "Can not allocate memory for batch job.\n");
+      exit(0);
+    }
+  }
+  pEntry = &pBatchEntries[numberBatchEntries];
+
+  /* the file size is the estimation of the calculation effort */
+  fp = fopen(pFileIn, "rb");
+  if(fp==NULL){
+    fprintf (stderr, "Can not open input file %s.\n", pFileIn);
+    exit(0);
+  }
+  fseek(fp, 0, SEEK_END);
+  pEntry->fileSize = ftell(fp);
+  fclose(fp);
+
+  pEntry->index = numberBatchEntries;
+  pEntry->job.pFileIn = batchCopyString(pFileIn);
+  if(pFileOut!=NULL){
+    pEntry->job.pFileOut = batchCopyString(pFileOut);
+  } else {
+    pEntry->job.pFileOut = batchDefaultFileName(pFileIn, ".out");
+  }
+  if(pFileOutBinary!=NULL){
+    pEntry->job.pFileOutBinary = batchCopyString(pFileOutBinary);
+  } else {
+    pEntry->job.pFileOutBinary = batchDefaultFileName(pFileIn, ".bin");
+  }
+  /* messages of jobs running in parallel would be mixed */
+  pEntry->job.verbose = 0;
+  pEntry->job.pRoadc = (tRoadcPtr)NULL;
+  pEntry->job.compactedData = (tRoadcBytePtr)NULL;
+  pEntry->job.compactedDataSize = 0;
+  pEntry->job.pPositions = (tRoadcUInt32 *)NULL;
+  numberBatchEntries++;
+}
+
+/* manifest line: <input file> [<output file> [<binary output file>]], 
+   empty lines and lines starting with # are ignored */
+void batchReadManifest(void){
+  FILE *fp;
+  char line[BATCH_MAX_LINE_SIZE];
+  char *pToken[3];
+  int numberTokens;
+  int lineNumber;
+
+  fp = fopen(clFileManifest, "r");
+  if(fp==NULL){
+    fprintf (stderr, "Can not open manifest file %s.\n", clFileManifest);
+    exit(0);
+  }
+  lineNumber = 0;
+  while(fgets(line, BATCH_MAX_LINE_SIZE, fp)!=NULL){
+    lineNumber++;
+    numberTokens = 0;
+    pToken[0] = strtok(line, " \t\r\n");
+    if((pToken[0]==NULL) || (pToken[0][0]=='#')){
+      continue;
+    }
+    numberTokens = 1;
+    while(numberTokens<3){
+      pToken[numberTokens] = strtok(NULL, " \t\r\n");
+      if(pToken[numberTokens]==NULL){
+	break;
+      }
+      numberTokens++;
+    }
+    if(strtok(NULL, " \t\r\n")!=NULL){
+      fprintf (stderr, "Manifest file %s line %d: more than 3 file names.\n", clFileManifest, lineNumber);
+      exit(0);
+    }
+    batchAddEntry(pToken[0],
+		  (numberTokens>1)?pToken[1]:NULL,
+		  (numberTokens>2)?pToken[2]:NULL);
+  }
+  fclose(fp);
+}
+
+int batchCompareSize(const void *pA, const void *pB){
+  const tBatchEntry *pEntryA;
+  const tBatchEntry *pEntryB;
+
+  pEntryA = (const tBatchEntry *)pA;
+  pEntryB = (const tBatchEntry *)pB;
+  if(pEntryA->fileSize!=pEntryB->fileSize){
+    return (pEntryA->fileSize>pEntryB->fileSize)?-1:1;
+  }
+  return (pEntryA->index<pEntryB->index)?-1:((pEntryA->index>pEntryB->index)?1:0);
+}
+
+void batchCalculation(tBatchEntryPtr pEntry){
+  pthread_mutex_lock(&batchReadMutex);
+  readInput(&pEntry->job.input, pEntry->job.pFileIn);
+  pthread_mutex_unlock(&batchReadMutex);
+
+  compactorCalculation(&pEntry->job);
+  writeOutputFile(&pEntry->job);
+
+  if(clVerbose){
+    printf("%s: original data size %lu, compacted data size %lu\n",
+	   pEntry->job.pFileIn,
+	   getInputNumBytes(&pEntry->job.input),
+	   pEntry->job.compactedDataSize);
+  }
+  roadcDelete(pEntry->job.pRoadc);
+  pEntry->job.pRoadc = (tRoadcPtr)NULL;
+  readInputFreeArrays(&pEntry->job.input);
+}
+
+/* each worker takes the next largest job until all jobs are done */
+void *batchWorker(void *pArgument){
+  tRoadcUInt32 current;
+
+  (void)pArgument;
+  for(;;){
+    pthread_mutex_lock(&batchQueueMutex);
+    current = nextBatchEntry;
+    if(nextBatchEntry<numberBatchEntries){
+      nextBatchEntry++;
+    }
+    pthread_mutex_unlock(&batchQueueMutex);
+    if(current>=numberBatchEntries){
+      break;
+    }
+    batchCalculation(&pBatchEntries[current]);
+  }
+  return NULL;
+}
+
+void runBatch(void){
+  tBatchWorkerPtr pWorkers;
+  tRoadcUInt32 numberWorkers;
+  tRoadcUInt32 i;
+  long numberProcessors;
+
+  for(i=0; i<(tRoadcUInt32)clNumberFilesIn; i++){
+    batchAddEntry(clFilesIn[i], NULL, NULL);
+  }
+  if(strcmp((const char *)clFileManifest, "")!=0){
+    batchReadManifest();
+  }
+  if(numberBatchEntries==0){
+    fprintf (stderr, "No input file.\n");
+    exit(0);
+  }
+  qsort(pBatchEntries, numberBatchEntries, sizeof(tBatchEntry), batchCompareSize);
+
+  if(clJobs>0){
+    numberWorkers = (tRoadcUInt32)clJobs;
+  } else {
+    numberProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    numberWorkers = (numberProcessors>0)?(tRoadcUInt32)numberProcessors:1;
+  }
+  if(numberWorkers>numberBatchEntries){
+    numberWorkers = numberBatchEntries;
+  }
+  if(clVerbose){
+    printf("compactor version 2.0\n");
+    printf("Batch calculation of %lu input files with %lu jobs...\n", numberBatchEntries, numberWorkers);
+  }
+
+  pWorkers = (tBatchWorkerPtr)calloc(numberWorkers, sizeof(tBatchWorker));
+  if(pWorkers==(tBatchWorkerPtr)NULL){
+    fprintf (stderr, "Can not allocate memory for batch job.\n");
+    exit(0);
+  }
+  /* worker 0 is the calling thread */
+  for(i=1; i<numberWorkers; i++){
+    if(pthread_create(&pWorkers[i].thread, NULL, batchWorker, NULL)==0){
+      pWorkers[i].threadStarted = 1;
+    }
+  }
+  batchWorker(NULL);
+  for(i=1; i<numberWorkers; i++){
+    if(pWorkers[i].threadStarted){
+      pthread_join(pWorkers[i].thread, NULL);
+    }
+  }
+  free(pWorkers);
+
+  if(clVerbose){
+    printf("...batch calculation done.\n");
+  }
+  for(i=0; i<numberBatchEntries; i++){
+    free(pBatchEntries[i].job.pFileIn);
+    free(pBatchEntries[i].job.pFileOut);
+    free(pBatchEntries[i].job.pFileOutBinary);
+  }
+  free(pBatchEntries);
+  pBatchEntries = (tBatchEntryPtr)NULL;
+  numberBatchEntries = 0;
+  maxNumberBatchEntries = 0;
+  nextBatchEntry = 0;
+}
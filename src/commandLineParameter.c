@@ -42,35 +42,89 @@ int clCompressedDataFormat  = CL_FORMAT_INT;
 int clCompilerType  = CL_COMPILER_ACME;
 char *clArraySizePrefix    = (char *)"";
 char *clFileIn = (char *)"";
+char **clFilesIn = (char **)NULL;
+int clNumberFilesIn = 0;
+char *clFileManifest = (char *)"";
+char *clFileServer = (char *)"";
 char *clFileOut = (char *)"compactedData.txt";
+int clFileOutDefined = 0;
 char *clFileOutBinary = (char *)"compactedData.bin";
 int clFileOutBinaryDefined = 0;
+int clJobs = 0;
 tRoadcUInt32 clTimeout=0;
+tRoadcUInt32 clMaxMemory=0;
+int clEstimate = 0;
+int clVerify = 0;
+int clStats = CL_STATS_NONE;
+int clLocalSearch = 0;
+int clExact = ROADC_EXACT_AUTO;
+int clPortfolio = 1;
+int clShards = 1;
+double clTargetGap = ROADC_NO_TARGET_GAP;
+int clEngine = ROADC_ENGINE_GREEDY;
+char *clFileOverlapGraph = (char *)"";
+char *clFileOrder = (char *)"";
+char *clFileTrace = (char *)"";
+char *clFileProgress = (char *)"";
 int clVerbose = 0;
 
 /*
+a algorithm - calculation engine
 n name - compressed data name
 f format - output data format
+g target gap - gap to lower bound
 c compiler - compiler type
+e exact - exact calculation mode
 s size - array size prefix
 
 b binary outfile
+d serve - server mode on a local socket
+i import order
+j jobs - number of parallel jobs in batch mode
+k shards
+l local search
+m manifest - input and output files of batch mode
 o outfile
+p portfolio
+q progress - progress report to stderr or to a status file
+r estimate - estimate of compacted data size and calculation time
 t timeout 
+u max memory - memory budget in MB
 v verbose 
+w trace - trace event file of the phases
+y verify - check the positions of the input arrays in the compacted data
+x export overlap graph
+z stats - statistics report of the phases and the roadC kernels
 h help 
 */
 
 static const struct option clOptions[] = {
+  { "algorithm", required_argument, 0, 'a' },
   { "binary",   required_argument, 0, 'b' },
   { "compiler", required_argument, 0, 'c' },
+  { "serve",    required_argument, 0, 'd' },
+  { "exact",    required_argument, 0, 'e' },
   { "format",   required_argument, 0, 'f' },
   { "help",     no_argument,       0, 'h' },
+  { "shards",   required_argument, 0, 'k' },
+  { "import-order", required_argument, 0, 'i' },
+  { "jobs",     required_argument, 0, 'j' },
+  { "manifest", required_argument, 0, 'm' },
+  { "target-gap", required_argument, 0, 'g' },
+  { "local-search", required_argument, 0, 'l' },
   { "name",     required_argument, 0, 'n' },
   { "outfile",  required_argument, 0, 'o' },
+  { "portfolio", required_argument, 0, 'p' },
+  { "progress", required_argument, 0, 'q' },
+  { "estimate", no_argument,       0, 'r' },
   { "size",     required_argument, 0, 's' },
   { "timeout",  required_argument, 0, 't' },
+  { "max-memory", required_argument, 0, 'u' },
   { "verbose",  no_argument,       0, 'v' },
+  { "verify",   no_argument,       0, 'y' },
+  { "trace",    required_argument, 0, 'w' },
+  { "export-overlap-graph", required_argument, 0, 'x' },
+  { "stats",    required_argument, 0, 'z' },
   {0, 0, 0, 0}
 };
 
@@ -85,6 +139,14 @@ void setCompilerType(char *value){
   }
 }
 
+int clIsServerMode(void){
+  return (strcmp((const char *)clFileServer, "")!=0);
+}
+
+int clIsBatchMode(void){
+  return ((clNumberFilesIn>1) || (strcmp((const char *)clFileManifest, "")!=0));
+}
+
 void
 commandLineParameter (int argc, char **argv)
 {
@@ -96,7 +158,7 @@ commandLineParameter (int argc, char **argv)
   opterr = 0;
 
 
-  while ((c = getopt_long(argc, argv, "b:c:f:hn:o:s:t:v", clOptions, &index)) != -1){
+  while ((c = getopt_long(argc, argv, "a:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:rs:t:u:vw:x:yz:", clOptions, &index)) != -1){
     switch (c){
       case 'b':
         clFileOutBinary = optarg;
@@ -105,6 +167,37 @@ commandLineParameter (int argc, char **argv)
       case 'c':
 	setCompilerType(optarg);
         break;
+      case 'a':
+	if(strncmp((const char *)optarg, "greedy\n", 6)==0){
+	  clEngine = ROADC_ENGINE_GREEDY;
+	} else if(strncmp((const char *)optarg, "cycle\n", 5)==0){
+	  clEngine = ROADC_ENGINE_CYCLE_COVER;
+	} else if(strncmp((const char *)optarg, "best\n", 4)==0){
+	  clEngine = ROADC_ENGINE_BEST;
+	} else if(strncmp((const char *)optarg, "suffix\n", 6)==0){
+	  clEngine = ROADC_ENGINE_SUFFIX;
+	} else if(strncmp((const char *)optarg, "auto\n", 4)==0){
+	  clEngine = ROADC_ENGINE_AUTO;
+	} else {
+	  fprintf (stderr, "Invalid argument %s for option --algorithm.\n", optarg);
+	  exit(0);
+	}
+        break;
+      case 'd':
+        clFileServer = optarg;
+        break;
+      case 'e':
+	if(strncmp((const char *)optarg, "auto\n", 4)==0){
+	  clExact = ROADC_EXACT_AUTO;
+	} else if(strncmp((const char *)optarg, "on\n", 2)==0){
+	  clExact = ROADC_EXACT_ALWAYS;
+	} else if(strncmp((const char *)optarg, "off\n", 3)==0){
+	  clExact = ROADC_EXACT_NEVER;
+	} else {
+	  fprintf (stderr, "Invalid argument %s for option --exact.\n", optarg);
+	  exit(0);
+	}
+        break;
       case 'f':
 	if(strncmp((const char *)optarg, "hex\n", 3)==0){
 	  clCompressedDataFormat = CL_FORMAT_HEX;
@@ -125,16 +218,68 @@ commandLineParameter (int argc, char **argv)
 	  }
 	}
         break;
+      case 'g':
+        clTargetGap = atof(optarg);
+	if(clTargetGap<0.0){
+	  fprintf (stderr, "Invalid value %s for option --target-gap.\n", optarg);
+	  exit(0);
+	} 
+        break;
       case 'h':
 	printHelpFlag=1;
 	/* do not call printHelpText() here
 	   to ensure handling of parameter verbose needed for printing */
         break;
+      case 'i':
+        clFileOrder = optarg;
+        break;
+      case 'j':
+        val = atoi(optarg);
+	if(val<1){
+	  fprintf (stderr, "Invalid value %s for option --jobs.\n", optarg);
+	  exit(0);
+	} 
+        clJobs = val;
+        break;
+      case 'k':
+        val = atoi(optarg);
+	if(val<1){
+	  fprintf (stderr, "Invalid value %s for option --shards.\n", optarg);
+	  exit(0);
+	} 
+        clShards = val;
+        break;
+      case 'l':
+        val = atoi(optarg);
+	if((val<0)||(val>100)){
+	  fprintf (stderr, "Invalid value %s for option --local-search.\n", optarg);
+	  exit(0);
+	} 
+        clLocalSearch = val;
+        break;
+      case 'm':
+        clFileManifest = optarg;
+        break;
       case 'n':
         clCompressedDataName = optarg;
         break;
       case 'o':
         clFileOut = optarg;
+	clFileOutDefined = 1;
+        break;
+      case 'p':
+        val = atoi(optarg);
+	if(val<1){
+	  fprintf (stderr, "Invalid value %s for option --portfolio.\n", optarg);
+	  exit(0);
+	} 
+        clPortfolio = val;
+        break;
+      case 'q':
+        clFileProgress = optarg;
+        break;
+      case 'r':
+	clEstimate = 1;
         break;
       case 's':
         clArraySizePrefix = optarg;
@@ -147,16 +292,56 @@ commandLineParameter (int argc, char **argv)
 	} 
         clTimeout = (tRoadcUInt32) val;
         break;
+      case 'u':
+        val = atoi(optarg);
+	if(val<1){
+	  fprintf (stderr, "Invalid value %s for option --max-memory.\n", optarg);
+	  exit(0);
+	} 
+        clMaxMemory = (tRoadcUInt32) val;
+        break;
       case 'v':
 	clVerbose = 1;
         break;
+      case 'w':
+        clFileTrace = optarg;
+        break;
+      case 'y':
+	clVerify = 1;
+        break;
+      case 'x':
+        clFileOverlapGraph = optarg;
+        break;
+      case 'z':
+	if(strncmp((const char *)optarg, "json\n", 4)==0){
+	  clStats = CL_STATS_JSON;
+	} else {
+	  fprintf (stderr, "Invalid argument %s for option --stats.\n", optarg);
+	  exit(0);
+	}
+        break;
       case '?':
-        if ((optopt == 'n') || 
+        if ((optopt == 'a') || 
+	    (optopt == 'n') || 
 	    (optopt == 'f') || 
 	    (optopt == 'c') || 
+	    (optopt == 'd') || 
+	    (optopt == 'e') || 
+	    (optopt == 'g') || 
+	    (optopt == 'i') || 
+	    (optopt == 'j') || 
+	    (optopt == 'k') || 
+	    (optopt == 'm') || 
+	    (optopt == 'l') || 
 	    (optopt == 's') || 
 	    (optopt == 'o') || 
-	    (optopt == 't')){
+	    (optopt == 'p') || 
+	    (optopt == 'q') || 
+	    (optopt == 't') || 
+	    (optopt == 'u') || 
+	    (optopt == 'w') || 
+	    (optopt == 'x') || 
+	    (optopt == 'z')){
           fprintf (stderr, "Option -%c requires an argument.\n", optopt);
 	}
 	else{
@@ -175,20 +360,43 @@ commandLineParameter (int argc, char **argv)
     exit(0);
   }
   
-  /* process remaining command line arguments (not options). */
-  if (optind == argc){
+  /* in server mode the input files are given by the requests */
+  if(clIsServerMode()){
+    if((optind < argc) || clEstimate || (clStats!=CL_STATS_NONE) ||
+       (strcmp((const char *)clFileManifest, "")!=0) ||
+       clFileOutDefined || clFileOutBinaryDefined ||
+       (strcmp((const char *)clFileOverlapGraph, "")!=0) ||
+       (strcmp((const char *)clFileOrder, "")!=0) ||
+       (strcmp((const char *)clFileTrace, "")!=0) ||
+       (strcmp((const char *)clFileProgress, "")!=0)){
+      fprintf (stderr, "The option -d does not allow input files and the options -b, -i, -m, -o, -q, -r, -w, -x, and -z.\n");
+      exit(0);
+    }
+    return;
+  }
+
+  /* process remaining command line arguments (not options), 
+     several input files or a manifest file are calculated in batch mode */
+  if ((optind == argc) && (strcmp((const char *)clFileManifest, "")==0)){
     fprintf (stderr, "No input file.\n");
     fprintf (stderr, "Type 'compactor -h' for help.\n");
     exit(0);
   }
-  if (optind+1 == argc){
-      clFileIn = argv[optind];
-  } else if (optind+1 < argc) {
-    fprintf (stderr, "Too many arguments:\n");
-    while (optind < argc){
-      fprintf (stderr, "%s ", argv[optind++]);
-    }
-    fprintf (stderr, "\n");
+  if (optind < argc){
+    clFileIn = argv[optind];
+  }
+  clFilesIn = &argv[optind];
+  clNumberFilesIn = argc-optind;
+  if(clIsBatchMode() &&
+     (clFileOutDefined || clFileOutBinaryDefined || clEstimate || (clStats!=CL_STATS_NONE) ||
+      (strcmp((const char *)clFileOverlapGraph, "")!=0) ||
+      (strcmp((const char *)clFileOrder, "")!=0) ||
+      (strcmp((const char *)clFileProgress, "")!=0))){
+    fprintf (stderr, "The options -o, -b, -i, -q, -r, -x, and -z need a single input file, use a manifest file (-m) for output file names.\n");
+    exit(0);
+  }
+  if(clEstimate && (clStats!=CL_STATS_NONE)){
+    fprintf (stderr, "The option -z needs a calculation, it can not be used with -r.\n");
     exit(0);
   }
 
@@ -31,68 +31,178 @@ THE SOFTWARE.
 #include <stdio.h>
 #endif /* __cplusplus */
 
+#include <stdlib.h>
+#include <string.h>
 #include "compactor.h"
 #include "commandLineParameter.h"
 #include "readInput.h"
 #include "writeOutputFile.h"
+#include "overlapGraphFile.h"
+#include "batchProcessing.h"
+#include "serverMode.h"
+#include "statisticsOutput.h"
+#include "traceOutput.h"
+#include "progressOutput.h"
+
+/* roadC context of a job with the input arrays and the options */
+void compactorNewRoadc(tCompactorJobPtr pJob){
+  tRoadcUInt32 i;
+
+  pJob->pRoadc = roadcNew();
+  roadcSetVerbose(pJob->pRoadc, (tRoadcByte)pJob->verbose);
 
-tRoadcPtr pRoadc;
-tRoadcBytePtr compactedData;
-tRoadcUInt32 compactedDataSize;
+  for(i=0; i<getInputNumArrays(&pJob->input); i++){
+    roadcAddElement(pJob->pRoadc,
+		    getInputArray(&pJob->input, i),
+		    getInputPaddingByteMaskArray(&pJob->input, i),
+		    getInputArraySize(&pJob->input, i),
+		    getInputArrayAlignment(&pJob->input, i));
+    //printf("add array no:%d size:%d alignment:%d\n", (int)i, (int)getInputArraySize(&pJob->input, i), (int)getInputArrayAlignment(&pJob->input, i));
+  }
+
+  roadcSetLocalSearch(pJob->pRoadc, (tRoadcByte)clLocalSearch);
+  roadcSetExact(pJob->pRoadc, (tRoadcByte)clExact);
+  roadcSetPortfolio(pJob->pRoadc, (tRoadcUInt32)clPortfolio);
+  roadcSetShards(pJob->pRoadc, (tRoadcUInt32)clShards);
+  roadcSetTargetGap(pJob->pRoadc, (tRoadcFloat64)clTargetGap);
+  roadcSetEngine(pJob->pRoadc, (tRoadcByte)clEngine);
+  roadcSetMaxMemory(pJob->pRoadc, (tRoadcUInt32)clMaxMemory);
+}
+
+/* calculation of a job, the input is read before */
+void compactorCalculation(tCompactorJobPtr pJob){
+  if(pJob->verbose){
+    printf("Calculation start....\n");
+  }
+  compactorNewRoadc(pJob);
+  /* the progress thread reads the roadC context after the step */
+  __atomic_store_n(&pJob->progressStep, COMPACTOR_STEP_CALCULATION, __ATOMIC_RELEASE);
+  if(strcmp((const char *)clFileOverlapGraph, "")!=0){
+    writeOverlapGraphFile(pJob);
+  }
+  if(strcmp((const char *)clFileOrder, "")!=0){
+    readOrderFile(pJob);
+  }
+  roadcCalculation(pJob->pRoadc, 1, clTimeout);
+  if(roadcGetOrderError(pJob->pRoadc)){
+    fprintf (stderr, "The order of tour file %s does not match the input arrays.\n", clFileOrder);
+    exit(0);
+  }
+  if(roadcGetMemoryError(pJob->pRoadc)){
+    fprintf (stderr, "Not enough memory for the compacted data.\n");
+    exit(0);
+  }
+  if(pJob->verbose){
+    printf("...calculation done.\n");
+  }
+
+  pJob->compactedDataSize = roadcGetCompactedDataSize(pJob->pRoadc);
+  pJob->compactedData = roadcGetCompactedData(pJob->pRoadc);
+}
+
+/* estimate of the compacted data size and the calculation time instead of the calculation */
+void compactorEstimate(tCompactorJobPtr pJob){
+  tRoadcUInt32 size;
+  tRoadcFloat64 time;
+
+  compactorNewRoadc(pJob);
+  if(roadcEstimate(pJob->pRoadc, clTimeout, &size, &time)){
+    fprintf (stderr, "Not enough memory for the estimate.\n");
+    exit(0);
+  }
+  printf("Original data size:             %lu\n", getInputNumBytes(&pJob->input));
+  printf("Estimated compacted data size:  %lu\n", size);
+  if(getInputNumBytes(&pJob->input)>0){
+    printf("Estimated compaction rate:      %f\n", (float)size/(float)getInputNumBytes(&pJob->input));
+  }
+  printf("Estimated calculation time (s): %f\n", time);
+}
 
 int main(int argc, char **argv){
-  tRoadcUInt32 i;
-  /*int j;*/
+  tCompactorJob job;
 
   commandLineParameter (argc, argv);
+
+  if(clIsServerMode()){
+    runServer();
+    return 0;
+  }
+  if(strcmp((const char *)clFileTrace, "")!=0){
+    roadcTraceStart();
+  }
+  if(clIsBatchMode()){
+    runBatch();
+    if(strcmp((const char *)clFileTrace, "")!=0){
+      writeTrace(clFileTrace);
+    }
+    return 0;
+  }
+  job.pFileIn = clFileIn;
+  job.pFileOut = clFileOut;
+  job.pFileOutBinary = clFileOutBinary;
+  job.verbose = clVerbose;
+  job.pPositions = (tRoadcUInt32 *)NULL;
+  job.progressStep = COMPACTOR_STEP_READ;
+  job.progressPositions = 0;
+  if(strcmp((const char *)clFileProgress, "")!=0){
+    progressStart(&job);
+  }
     
   if(clVerbose){
     printf("compactor version 2.0\n");
     printf("Read input start...\n");
   }
-  readInput();
+  job.wallTime[COMPACTOR_PHASE_READ] = statisticsWallTime();
+  job.cpuTime[COMPACTOR_PHASE_READ] = statisticsCpuTime();
+  readInput(&job.input, job.pFileIn);
+  job.wallTime[COMPACTOR_PHASE_READ] = statisticsWallTime()-job.wallTime[COMPACTOR_PHASE_READ];
+  job.cpuTime[COMPACTOR_PHASE_READ] = statisticsCpuTime()-job.cpuTime[COMPACTOR_PHASE_READ];
   if(clVerbose){
     printf("...read input done.\n");
   }
 
-  if(clVerbose){
-    printf("Calculation start....\n");
-  }
-  pRoadc = roadcNew();
-
-  for(i=0; i<getInputNumArrays(); i++){
-    roadcAddElement(pRoadc,
-		    getInputArray(i),
-		    getInputPaddingByteMaskArray(i),
-		    getInputArraySize(i),
-		    getInputArrayAlignment(i));
-    //printf("add array no:%d size:%d alignment:%d\n", (int)i, (int)getInputArraySize(i), (int)getInputArrayAlignment(i));
+  if(clEstimate){
+    compactorEstimate(&job);
+    __atomic_store_n(&job.progressStep, COMPACTOR_STEP_DONE, __ATOMIC_RELEASE);
+    progressEnd();
+    if(strcmp((const char *)clFileTrace, "")!=0){
+      writeTrace(clFileTrace);
+    }
+    roadcDelete(job.pRoadc);
+    readInputFreeArrays(&job.input);
+    return 0;
   }
 
-  roadcCalculation(pRoadc, 1, clTimeout);
-  if(clVerbose){
-    printf("...calculation done.\n");
-  }
-
-  compactedDataSize = roadcGetCompactedDataSize(pRoadc);
-  compactedData = roadcGetCompactedData(pRoadc);
+  compactorCalculation(&job);
 
   if(clVerbose){
     printf("Write start...\n");
   }
-  writeOutputFile();
+  job.wallTime[COMPACTOR_PHASE_WRITE] = statisticsWallTime();
+  job.cpuTime[COMPACTOR_PHASE_WRITE] = statisticsCpuTime();
+  writeOutputFile(&job);
+  job.wallTime[COMPACTOR_PHASE_WRITE] = statisticsWallTime()-job.wallTime[COMPACTOR_PHASE_WRITE];
+  job.cpuTime[COMPACTOR_PHASE_WRITE] = statisticsCpuTime()-job.cpuTime[COMPACTOR_PHASE_WRITE];
+  __atomic_store_n(&job.progressStep, COMPACTOR_STEP_DONE, __ATOMIC_RELEASE);
+  progressEnd();
   if(clVerbose){
     printf("...write done.\n");
   }
 
   if(clVerbose){
-    printf("Original data size:  %lu\n", getInputNumBytes());
-    printf("Compacted data size: %lu\n", compactedDataSize);
-    printf("Compaction rate:     %f\n", (float)compactedDataSize/(float)getInputNumBytes());
+    printf("Original data size:  %lu\n", getInputNumBytes(&job.input));
+    printf("Compacted data size: %lu\n", job.compactedDataSize);
+    printf("Compaction rate:     %f\n", (float)job.compactedDataSize/(float)getInputNumBytes(&job.input));
+  }
+  if(clStats==CL_STATS_JSON){
+    writeStatistics(&job);
+  }
+  if(strcmp((const char *)clFileTrace, "")!=0){
+    writeTrace(clFileTrace);
   }
 
-  roadcDelete(pRoadc);
-  readInputFreeArrays();
+  roadcDelete(job.pRoadc);
+  readInputFreeArrays(&job.input);
 
   return 0; 
 }
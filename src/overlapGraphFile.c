@@ -0,0 +1,167 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <string.h>
+#include "overlapGraphFile.h"
+#include "commandLineParameter.h"
+#include "compactor.h"
+
+/* maximal length of a token in the tour file */
+#define MAX_TOUR_TOKEN_SIZE 256
+
+/* write the overlap graph as TSPLIB file of type ATSP with full matrix */
+void writeOverlapGraphFile(tCompactorJobPtr pJob){
+  FILE *fp;
+  tRoadcUInt32 *pGraph;
+  tRoadcUInt32 dimension;
+  tRoadcUInt32 i, j;
+
+  pGraph = roadcGetOverlapGraph(pJob->pRoadc, clTimeout, &dimension);
+  if(pGraph==NULL){
+    fprintf (stderr, "Calculation of the overlap graph failed (memory, memory budget, or timeout).\n");
+    exit(0);
+  }
+  fp = fopen(clFileOverlapGraph, "w");
+  if (fp == NULL){
+    fprintf (stderr, "Can not open overlap graph file %s.\n", clFileOverlapGraph);
+    exit(0);
+  }
+  fprintf(fp, "NAME: %s\n", clCompressedDataName);
+  fprintf(fp, "TYPE: ATSP\n");
+  fprintf(fp, "COMMENT: compactor overlap graph of %s, node 1 is start and end, node k is array k-1 after removing multiple arrays\n", pJob->pFileIn);
+  fprintf(fp, "DIMENSION: %lu\n", dimension);
+  fprintf(fp, "EDGE_WEIGHT_TYPE: EXPLICIT\n");
+  fprintf(fp, "EDGE_WEIGHT_FORMAT: FULL_MATRIX\n");
+  fprintf(fp, "EDGE_WEIGHT_SECTION\n");
+  for(i=0; i<dimension; i++){
+    for(j=0; j<dimension; j++){
+      fprintf(fp, (j==0) ? "%lu" : " %lu", pGraph[i*dimension+j]);
+    }
+    fprintf(fp, "\n");
+  }
+  fprintf(fp, "EOF\n");
+  free(pGraph);
+  if(fclose(fp)>0){
+    fprintf (stderr, "Can not close overlap graph file %s.\n", clFileOverlapGraph);
+    exit(0);
+  }
+  if(pJob->verbose){
+    printf("Overlap graph with %lu nodes written to %s.\n", dimension, clFileOverlapGraph);
+  }
+}
+
+/* read a TSPLIB tour file, the tour is rotated to start at node 1 (start and end) */
+void readOrderFile(tCompactorJobPtr pJob){
+  FILE *fp;
+  char token[MAX_TOUR_TOKEN_SIZE];
+  tRoadcUInt32 *pNodes;
+  tRoadcUInt32 *pTmp;
+  tRoadcUInt32 numberNodes;
+  tRoadcUInt32 maxNumberNodes;
+  tRoadcUInt32 start;
+  tRoadcUInt32 i;
+  long node;
+  int tourSection;
+
+  fp = fopen(clFileOrder, "r");
+  if (fp == NULL){
+    fprintf (stderr, "Can not open tour file %s.\n", clFileOrder);
+    exit(0);
+  }
+  numberNodes = 0;
+  maxNumberNodes = 0;
+  pNodes = NULL;
+  tourSection = 0;
+  while(fscanf(fp, "%255s", token)==1){
+    if(!tourSection){
+      /* header lines are not needed */
+      tourSection = (strcmp(token, "TOUR_SECTION")==0);
+      continue;
+    }
+    if(strcmp(token, "EOF")==0){
+      break;
+    }
+    node = atol(token);
+    if(node==-1){
+      break;
+    }
+    if(node<=0){
+      fprintf (stderr, "Invalid node %s in tour file %s.\n", token, clFileOrder);
+      exit(0);
+    }
+    if(numberNodes==maxNumberNodes){
+      maxNumberNodes = (maxNumberNodes==0) ? 1024 : 2*maxNumberNodes;
+      pTmp = (tRoadcUInt32 *)realloc(pNodes, maxNumberNodes*sizeof(tRoadcUInt32));
+      if(pTmp==NULL){
+        fprintf (stderr, "Not enough memory for tour file %s.\n", clFileOrder);
+        exit(0);
+      }
+      pNodes = pTmp;
+    }
+    pNodes[numberNodes++] = (tRoadcUInt32)node;
+  }
+  fclose(fp);
+
+  /* node 1 is start and end, node k is array k-2 of the order */
+  start = numberNodes;
+  for(i=0; i<numberNodes; i++){
+    if(pNodes[i]==1){
+      if(start!=numberNodes){
+        fprintf (stderr, "Node 1 more than once in tour file %s.\n", clFileOrder);
+        exit(0);
+      }
+      start = i;
+    }
+  }
+  if(start==numberNodes){
+    fprintf (stderr, "No tour with node 1 in tour file %s.\n", clFileOrder);
+    exit(0);
+  }
+  pTmp = (tRoadcUInt32 *)malloc(numberNodes*sizeof(tRoadcUInt32));
+  if(pTmp==NULL){
+    fprintf (stderr, "Not enough memory for tour file %s.\n", clFileOrder);
+    exit(0);
+  }
+  for(i=1; i<numberNodes; i++){
+    pTmp[i-1] = pNodes[(start+i)%numberNodes]-2;
+  }
+  if(roadcSetOrder(pJob->pRoadc, pTmp, numberNodes-1)){
+    fprintf (stderr, "Not enough memory for tour file %s.\n", clFileOrder);
+    exit(0);
+  }
+  free(pTmp);
+  free(pNodes);
+  if(pJob->verbose){
+    printf("Order of %lu arrays read from %s.\n", numberNodes-1, clFileOrder);
+  }
+}
@@ -34,17 +34,34 @@ THE SOFTWARE.
 #include "commandLineParameter.h"
 
 void printHelpText(void){
-  printf("Usage: compactor [options] file\n");
+  printf("Usage: compactor [options] file [file]...\n");
   printf("Options:\n");
   /*printf("  -c <arg>    | --compiler <arg>  compiler type [ACME]. Default: ACME\n");*/
-  printf("  -b <file>   | --binary <file>   Binary output filename for 'bin' format.         Default: 'compactedData.bin'.\n");
-  printf("  -f <arg>    | --format <arg>    Output data format [bin|hex|int|oct].            Default: 'int'.\n");
-  printf("  -h          | --help            Print this help text and exit.\n");
-  printf("  -n <string> | --name <string>   Compressed array name.                           Default: 'compactedData'.\n");
-  printf("  -o <file>   | --outfile <file>  Output filename.                                 Default: 'compactedData.txt'.\n");
-  printf("  -s <string> | --size <string>   Add array sizes to output with postfix <string>. Default: no sizes.\n");
-  printf("  -t <int>    | --timeout <int>   Compaction timeout in seconds.                   Default: no timeout.\n");
-  printf("  -v          | --verbose         Provide more details.\n");
+  printf("  -a <arg>    | --algorithm <arg>              Calculation engine [greedy|cycle|best|suffix|auto]. Default: 'greedy'.\n");
+  printf("  -b <file>   | --binary <file>                Binary output filename for 'bin' format.         Default: 'compactedData.bin'.\n");
+  printf("  -d <file>   | --serve <file>                 Server mode, requests on local socket file.      Default: no server.\n");
+  printf("  -e <arg>    | --exact <arg>                  Exact calculation for few arrays [auto|on|off].  Default: 'auto'.\n");
+  printf("  -f <arg>    | --format <arg>                 Output data format [bin|hex|int|oct].            Default: 'int'.\n");
+  printf("  -g <float>  | --target-gap <float>           Stop local search at this gap to lower bound [%%]. Default: no target gap.\n");
+  printf("  -h          | --help                         Print this help text and exit.\n");
+  printf("  -i <file>   | --import-order <file>          Merge arrays in order of TSPLIB tour file.       Default: no order.\n");
+  printf("  -j <int>    | --jobs <int>                   Number of input files calculated in parallel.    Default: number of processors.\n");
+  printf("  -k <int>    | --shards <int>                 Number of similarity shards run in parallel.     Default: 1 (no shards).\n");
+  printf("  -l <int>    | --local-search <int>           Local search after greedy, share of timeout [%%]. Default: 0 (no local search).\n");
+  printf("  -m <file>   | --manifest <file>              Batch mode: input and output files of manifest.  Default: no manifest.\n");
+  printf("  -n <string> | --name <string>                Compressed array name.                           Default: 'compactedData'.\n");
+  printf("  -o <file>   | --outfile <file>               Output filename.                                 Default: 'compactedData.txt'.\n");
+  printf("  -p <int>    | --portfolio <int>              Number of greedy calculations run in parallel.   Default: 1.\n");
+  printf("  -q <arg>    | --progress <arg>               Progress every second [stderr|<status file>].    Default: no progress.\n");
+  printf("  -r          | --estimate                     Estimate compacted size and calculation time only.\n");
+  printf("  -s <string> | --size <string>                Add array sizes to output with postfix <string>. Default: no sizes.\n");
+  printf("  -t <int>    | --timeout <int>                Compaction timeout in seconds.                   Default: no timeout.\n");
+  printf("  -u <int>    | --max-memory <int>             Memory budget in MB, larger steps are skipped.   Default: no budget.\n");
+  printf("  -v          | --verbose                      Provide more details.\n");
+  printf("  -w <file>   | --trace <file>                 Trace file of the phases (Chrome trace format).  Default: no trace.\n");
+  printf("  -x <file>   | --export-overlap-graph <file>  Export overlap graph as TSPLIB ATSP file.        Default: no export.\n");
+  printf("  -y          | --verify                       Check every input array at its position in the output.\n");
+  printf("  -z <arg>    | --stats <arg>                  Statistics of phases and roadC kernels [json].   Default: no statistics.\n");
   if(clVerbose == 0){
     printf ("Type 'compactor -h -v' for more information.\n");
   } else {
@@ -0,0 +1,225 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/* progress report of option --progress: a thread samples the progress of 
+   the job and of roadC every second and writes one line to stderr or to a
+   status file, the calculation only stores its progress with relaxed atomic
+   stores. The estimated time left (ETA) is extrapolated from the greedy 
+   levels done and from the positions searched, it is limited by the timeout. */
+
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "progressOutput.h"
+#include "commandLineParameter.h"
+#include "statisticsOutput.h"
+
+/* seconds between two reports */
+#define PROGRESS_INTERVAL 1
+
+static const char *progressPhaseNames[ROADC_NUMBER_PHASES] = {
+  "shards", "multiple", "lower bound", "order", "concatenation"
+};
+
+static pthread_t progressThread;
+static pthread_mutex_t progressMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t progressCondition = PTHREAD_COND_INITIALIZER;
+static int progressStop = 0;
+static int progressThreadStarted = 0;
+static tCompactorJobPtr pProgressJob = (tCompactorJobPtr)NULL;
+static double progressStartTime;
+/* start of the step or the phase of roadC reported last */
+static double progressPhaseStartTime;
+static double progressCalculationStartTime;
+static int progressLastPhase;
+
+/* estimated seconds left for the share done of a step or phase, -1: unknown */
+double progressTimeLeft(double done, double total, double phaseTime){
+  if((done>0.0)&&(total>=done)){
+    return phaseTime*(total-done)/done;
+  }
+  return -1.0;
+}
+
+/* the calculation stops at the timeout */
+double progressTimeout(double left, double calculationTime){
+  double timeoutLeft;
+
+  if(clTimeout==0){
+    return left;
+  }
+  timeoutLeft = (double)clTimeout-calculationTime;
+  if(timeoutLeft<0.0){
+    timeoutLeft = 0.0;
+  }
+  if((left<0.0)||(left>timeoutLeft)){
+    return timeoutLeft;
+  }
+  return left;
+}
+
+void progressLine(char *pLine, size_t size){
+  tRoadcProgress progress;
+  tRoadcPtr pRoadc;
+  double now, time, left;
+  int step, phase;
+  size_t length;
+
+  now = statisticsWallTime();
+  time = now-progressStartTime;
+  step = __atomic_load_n(&pProgressJob->progressStep, __ATOMIC_ACQUIRE);
+  left = -1.0;
+  length = 0;
+  phase = step*(ROADC_NUMBER_PHASES+1);
+  if(step==COMPACTOR_STEP_READ){
+    length = (size_t)snprintf(pLine, size, "read input");
+  } else if(step==COMPACTOR_STEP_CALCULATION){
+    /* the roadC context is created before the step is set */
+    pRoadc = pProgressJob->pRoadc;
+    roadcGetProgress(pRoadc, &progress);
+    if(progress.phase<ROADC_NUMBER_PHASES){
+      phase += progress.phase;
+      length = (size_t)snprintf(pLine, size, "%s", progressPhaseNames[progress.phase]);
+    } else {
+      length = (size_t)snprintf(pLine, size, "calculation");
+    }
+    if(progressLastPhase<COMPACTOR_STEP_CALCULATION*(ROADC_NUMBER_PHASES+1)){
+      progressCalculationStartTime = now;
+    }
+    if(phase!=progressLastPhase){
+      progressPhaseStartTime = now;
+      progressLastPhase = phase;
+    }
+    if((progress.phase==ROADC_PHASE_ORDER)&&(progress.maxOverlapLevel>0)&&(length<size)){
+      length += (size_t)snprintf(&pLine[length], size-length, ", greedy level %lu/%lu",
+                         progress.overlapLevel, progress.maxOverlapLevel);
+      left = progressTimeLeft((double)(progress.maxOverlapLevel-progress.overlapLevel),
+                              (double)progress.maxOverlapLevel, now-progressPhaseStartTime);
+    }
+    left = progressTimeout(left, now-progressCalculationStartTime);
+    if((progress.phase!=ROADC_PHASE_NONE)&&(progress.inputBytes>0)&&(length<size)){
+      length += (size_t)snprintf(&pLine[length], size-length, ", arrays left %lu, saved %lu bytes (%.1f%%)",
+                         progress.entries, progress.inputBytes-progress.bytes,
+                         100.0*(double)(progress.inputBytes-progress.bytes)/(double)progress.inputBytes);
+    }
+  } else if(step==COMPACTOR_STEP_POSITIONS){
+    if(phase!=progressLastPhase){
+      progressPhaseStartTime = now;
+      progressLastPhase = phase;
+    }
+    length = (size_t)snprintf(pLine, size, "positions %lu/%lu", 
+                      __atomic_load_n(&pProgressJob->progressPositions, __ATOMIC_RELAXED),
+                      getInputNumArrays(&pProgressJob->input));
+    left = progressTimeLeft((double)__atomic_load_n(&pProgressJob->progressPositions, __ATOMIC_RELAXED),
+                            (double)getInputNumArrays(&pProgressJob->input), now-progressPhaseStartTime);
+  } else if(step==COMPACTOR_STEP_WRITE){
+    length = (size_t)snprintf(pLine, size, "write output");
+  } else {
+    length = (size_t)snprintf(pLine, size, "done");
+  }
+  if(length<size){
+    length += (size_t)snprintf(&pLine[length], size-length, ", %.0f s", time);
+  }
+  if((left>=0.0)&&(length<size)){
+    snprintf(&pLine[length], size-length, ", ETA %.0f s", left);
+  }
+}
+
+void progressWrite(int last){
+  char line[256];
+  FILE *fp;
+
+  progressLine(line, sizeof(line));
+  if(strcmp((const char *)clFileProgress, "stderr")==0){
+    /* the line is overwritten by the next one */
+    fprintf(stderr, "\r%-100s%s", line, last ? "\n" : "");
+    fflush(stderr);
+  } else {
+    /* the status file has the last line only */
+    fp = fopen(clFileProgress, "w");
+    if(fp==NULL){
+      return;
+    }
+    fprintf(fp, "%s\n", line);
+    fclose(fp);
+  }
+}
+
+void *progressRun(void *pArg){
+  struct timespec wakeUp;
+  int stop;
+
+  (void)pArg;
+  pthread_mutex_lock(&progressMutex);
+  stop = progressStop;
+  while(!stop){
+    clock_gettime(CLOCK_REALTIME, &wakeUp);
+    wakeUp.tv_sec += PROGRESS_INTERVAL;
+    while((!progressStop)&&
+          (pthread_cond_timedwait(&progressCondition, &progressMutex, &wakeUp)==0)){
+    }
+    stop = progressStop;
+    if(!stop){
+      progressWrite(0);
+    }
+  }
+  pthread_mutex_unlock(&progressMutex);
+  return NULL;
+}
+
+void progressStart(tCompactorJobPtr pJob){
+  pProgressJob = pJob;
+  progressStartTime = statisticsWallTime();
+  progressPhaseStartTime = progressStartTime;
+  progressCalculationStartTime = progressStartTime;
+  progressLastPhase = -1;
+  progressStop = 0;
+  if(pthread_create(&progressThread, NULL, progressRun, NULL)==0){
+    progressThreadStarted = 1;
+  } else {
+    fprintf (stderr, "WARNING: Can not start the progress thread, no progress report.\n");
+  }
+}
+
+void progressEnd(void){
+  if(!progressThreadStarted){
+    return;
+  }
+  pthread_mutex_lock(&progressMutex);
+  progressStop = 1;
+  pthread_cond_signal(&progressCondition);
+  pthread_mutex_unlock(&progressMutex);
+  pthread_join(progressThread, NULL);
+  progressThreadStarted = 0;
+  progressWrite(1);
+}
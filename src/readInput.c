@@ -47,37 +47,30 @@ THE SOFTWARE.
 
 
 #define MALLOC_NUM 65536
-tRoadcBytePtr *inputArrays=(tRoadcBytePtr *)NULL;
-tRoadcBytePtr *inputPaddingByteMaskArrays=(tRoadcBytePtr *)NULL;
-char **inputArraysAddressName=(char **)NULL;
-tRoadcUInt32 *inputArraysSize=(tRoadcUInt32 *)NULL;
-tRoadcUInt32 *inputArraysAlignment=(tRoadcUInt32 *)NULL;
-tRoadcUInt32 numInputArrays=0;
-tRoadcUInt32 numInputBytes=0;
-static tRoadcUInt32 maxNumInputArrays=0;
-
+/* line buffer and array name while reading, the input files are read one after another */
 static tRoadcByte *inputLineArray=(tRoadcByte *)NULL;
 static tRoadcUInt32 numInputLineArray=0;
 static tRoadcUInt32 maxNumInputLineArray=0;
 
 static char tmpString[100];
+/* the slot numInputArrays holds a name or data not yet added as an array */
+static int pendingArray=0;
 
-void addInputArraysAddressName(char *val, int index){
+void addInputArraysAddressName(tInputDataPtr pInput, char *val, int index){
   size_t entrySize;
   entrySize = strlen(val) + 1;
 
-  inputArraysAddressName[index]=(char *)malloc(entrySize*sizeof(char));
-  if(inputArraysAddressName[index]==(char *)NULL){
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+  pInput->inputArraysAddressName[index]=(char *)malloc(entrySize*sizeof(char));
+  if(pInput->inputArraysAddressName[index]==(char *)NULL){
+    readInputError("Can not allocate new array for input data\n");
   }
-  strcpy(inputArraysAddressName[index], val);
-  inputArraysAddressName[index][entrySize-1]='\0'; /* terminate string in any case */
+  strcpy(pInput->inputArraysAddressName[index], val);
+  pInput->inputArraysAddressName[index][entrySize-1]='\0'; /* terminate string in any case */
 }
 
-void addInputArraysAlignment(tRoadcUInt32 val, int index){
+void addInputArraysAlignment(tInputDataPtr pInput, tRoadcUInt32 val, int index){
 
-  inputArraysAlignment[index]=val;
+  pInput->inputArraysAlignment[index]=val;
 }
 
 void resetProcessNextLine(void){
@@ -97,27 +90,24 @@ int determineInputFormatType(void){
   return inputFormatType;
 }
 
-void setArrayNameAndSize(int index){
+void setArrayNameAndSize(tInputDataPtr pInput, int index){
   int inputFormatType;
   int tmpVal;
 
-  addInputArraysAlignment(1, index); /* default value */
+  addInputArraysAlignment(pInput, 1, index); /* default value */
 
   inputFormatType = determineInputFormatType();
   if(inputFormatType==RI_FORMAT_BYTE){
-    fprintf (stderr, "Line: %d: Array name expected, but byte array values given. Set array name first.\n", getCurrentLine());
-    exit(0);
+    readInputError("Line: %d: Array name expected, but byte array values given. Set array name first.\n", getCurrentLine());
   }
   if(inputFormatType==RI_FORMAT_BINARY){
-    fprintf (stderr, "Line: %d: Array name expected, but binary array values given. Set array name first.\n", getCurrentLine());
-    exit(0);
+    readInputError("Line: %d: Array name expected, but binary array values given. Set array name first.\n", getCurrentLine());
   }
 
-  if(extractString(tmpString, 1)==0){
-    fprintf (stderr, "Line: %d: Column: %d no array name given\n", getCurrentLine(), getCurrentColumn());
-    exit(0);
+  if(extractString(tmpString, sizeof(tmpString), 1)==0){
+    readInputError("Line: %d: Column: %d no array name given\n", getCurrentLine(), getCurrentColumn());
   }
-  addInputArraysAddressName(tmpString, index);
+  addInputArraysAddressName(pInput, tmpString, index);
 
   while((isEndOfLine()==0) && (getChar()==' ')){
     incColumn(1);
@@ -126,153 +116,159 @@ void setArrayNameAndSize(int index){
   tmpVal = getNextValueByte();
   if(tmpVal!=-1){
     /* there is a number */
-    addInputArraysAlignment((tRoadcUInt32)tmpVal, index);
+    addInputArraysAlignment(pInput, (tRoadcUInt32)tmpVal, index);
     return;
   }
 }
 
-void allocInputArrays(){
-  maxNumInputArrays=MALLOC_NUM;
-  inputArraysSize = (tRoadcUInt32 *)malloc(MALLOC_NUM*sizeof(tRoadcUInt32)); 
-  if(inputArraysSize==(tRoadcUInt32 *)NULL){                                                
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+void allocInputArrays(tInputDataPtr pInput){
+  pInput->maxNumInputArrays=MALLOC_NUM;
+  pInput->inputArraysSize = (tRoadcUInt32 *)malloc(MALLOC_NUM*sizeof(tRoadcUInt32)); 
+  if(pInput->inputArraysSize==(tRoadcUInt32 *)NULL){                                                
+    readInputError("Can not allocate new array for input data\n");
   }
-  inputArraysAlignment = (tRoadcUInt32 *)malloc(MALLOC_NUM*sizeof(tRoadcUInt32)); 
-  if(inputArraysAlignment==(tRoadcUInt32 *)NULL){                                                
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+  pInput->inputArraysAlignment = (tRoadcUInt32 *)malloc(MALLOC_NUM*sizeof(tRoadcUInt32)); 
+  if(pInput->inputArraysAlignment==(tRoadcUInt32 *)NULL){                                                
+    readInputError("Can not allocate new array for input data\n");
   }
-  inputArrays=(tRoadcBytePtr *)malloc(MALLOC_NUM*sizeof(tRoadcBytePtr));
-  if(inputArrays==(tRoadcBytePtr *)NULL){
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+  pInput->inputArrays=(tRoadcBytePtr *)malloc(MALLOC_NUM*sizeof(tRoadcBytePtr));
+  if(pInput->inputArrays==(tRoadcBytePtr *)NULL){
+    readInputError("Can not allocate new array for input data\n");
   }
-  inputPaddingByteMaskArrays=(tRoadcBytePtr *)malloc(MALLOC_NUM*sizeof(tRoadcBytePtr));
-  if(inputPaddingByteMaskArrays==(tRoadcBytePtr *)NULL){
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+  pInput->inputPaddingByteMaskArrays=(tRoadcBytePtr *)malloc(MALLOC_NUM*sizeof(tRoadcBytePtr));
+  if(pInput->inputPaddingByteMaskArrays==(tRoadcBytePtr *)NULL){
+    readInputError("Can not allocate new array for input data\n");
   }
-  inputArraysAddressName=(char **)malloc(MALLOC_NUM*sizeof(char *));
-  if(inputArraysAddressName==(char **)NULL){
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+  pInput->inputArraysAddressName=(char **)malloc(MALLOC_NUM*sizeof(char *));
+  if(pInput->inputArraysAddressName==(char **)NULL){
+    readInputError("Can not allocate new array for input data\n");
   }
   maxNumInputLineArray=MALLOC_NUM;
   inputLineArray=(tRoadcByte *)malloc(MALLOC_NUM*sizeof(tRoadcByte));
   if(inputLineArray==(tRoadcByte *)NULL){
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+    readInputError("Can not allocate new array for input data\n");
   }
 }                              
 
 void reallocInputLineArray(){
   if(numInputLineArray==maxNumInputLineArray){
-    maxNumInputLineArray=maxNumInputLineArray+MALLOC_NUM;
+    /* the size doubles, long input lines are read in linear time */
+    maxNumInputLineArray=2*maxNumInputLineArray;
     inputLineArray = (tRoadcByte *)realloc((void*)inputLineArray, maxNumInputLineArray*sizeof(tRoadcByte)); 
     if(inputLineArray==(tRoadcByte *)NULL){                                                
-      fprintf (stderr, "Can not allocate new array for input data\n");
-      exit(0);
+      readInputError("Can not allocate new array for input data\n");
     }
   }
 }
 
-void reallocInputArrays(){
-  if(numInputArrays==maxNumInputArrays){
-    maxNumInputArrays=maxNumInputArrays+MALLOC_NUM;
-    inputArraysSize = (tRoadcUInt32 *)realloc((void*)inputArraysSize, maxNumInputArrays*sizeof(tRoadcUInt32)); 
-    if(inputArraysSize==(tRoadcUInt32 *)NULL){                                                
-      fprintf (stderr, "Can not allocate new array for input data\n");
-      exit(0);
+void reallocInputArrays(tInputDataPtr pInput){
+  if(pInput->numInputArrays==pInput->maxNumInputArrays){
+    pInput->maxNumInputArrays=2*pInput->maxNumInputArrays;
+    pInput->inputArraysSize = (tRoadcUInt32 *)realloc((void*)pInput->inputArraysSize, pInput->maxNumInputArrays*sizeof(tRoadcUInt32)); 
+    if(pInput->inputArraysSize==(tRoadcUInt32 *)NULL){                                                
+      readInputError("Can not allocate new array for input data\n");
     }
-    inputArraysAlignment = (tRoadcUInt32 *)realloc((void*)inputArraysAlignment, maxNumInputArrays*sizeof(tRoadcUInt32)); 
-    if(inputArraysAlignment==(tRoadcUInt32 *)NULL){                                                
-      fprintf (stderr, "Can not allocate new array for input data\n");
-      exit(0);
+    pInput->inputArraysAlignment = (tRoadcUInt32 *)realloc((void*)pInput->inputArraysAlignment, pInput->maxNumInputArrays*sizeof(tRoadcUInt32)); 
+    if(pInput->inputArraysAlignment==(tRoadcUInt32 *)NULL){                                                
+      readInputError("Can not allocate new array for input data\n");
     }
-    inputArrays=(tRoadcBytePtr *)realloc((void*)inputArrays, maxNumInputArrays*sizeof(tRoadcBytePtr));
-    if(inputArrays==(tRoadcBytePtr *)NULL){
-      fprintf (stderr, "Can not allocate new array for input data\n");
-      exit(0);
+    pInput->inputArrays=(tRoadcBytePtr *)realloc((void*)pInput->inputArrays, pInput->maxNumInputArrays*sizeof(tRoadcBytePtr));
+    if(pInput->inputArrays==(tRoadcBytePtr *)NULL){
+      readInputError("Can not allocate new array for input data\n");
     }
-    inputPaddingByteMaskArrays=(tRoadcBytePtr *)realloc((void*)inputPaddingByteMaskArrays, maxNumInputArrays*sizeof(tRoadcBytePtr));
-    if(inputPaddingByteMaskArrays==(tRoadcBytePtr *)NULL){
-      fprintf (stderr, "Can not allocate new array for input data\n");
-      exit(0);
+    pInput->inputPaddingByteMaskArrays=(tRoadcBytePtr *)realloc((void*)pInput->inputPaddingByteMaskArrays, pInput->maxNumInputArrays*sizeof(tRoadcBytePtr));
+    if(pInput->inputPaddingByteMaskArrays==(tRoadcBytePtr *)NULL){
+      readInputError("Can not allocate new array for input data\n");
     }
-    inputArraysAddressName=(char **)realloc((void*)inputArraysAddressName, maxNumInputArrays*sizeof(char *));
-    if(inputArraysAddressName==(char **)NULL){
-      fprintf (stderr, "Can not allocate new array for input data\n");
-      exit(0);
+    pInput->inputArraysAddressName=(char **)realloc((void*)pInput->inputArraysAddressName, pInput->maxNumInputArrays*sizeof(char *));
+    if(pInput->inputArraysAddressName==(char **)NULL){
+      readInputError("Can not allocate new array for input data\n");
     }
   }
 }
 
-void readInputFreeArrays(void){
+/* name, data, and padding byte mask of the array read next */
+void initPendingArray(tInputDataPtr pInput){
+  reallocInputArrays(pInput);
+  pInput->inputArrays[pInput->numInputArrays]=(tRoadcBytePtr)NULL;
+  pInput->inputPaddingByteMaskArrays[pInput->numInputArrays]=(tRoadcBytePtr)NULL;
+  pInput->inputArraysAddressName[pInput->numInputArrays]=(char *)NULL;
+  pendingArray=1;
+}
+
+void freePendingArray(tInputDataPtr pInput){
+  if(pendingArray){
+    free((void *)pInput->inputArrays[pInput->numInputArrays]);
+    free((void *)pInput->inputPaddingByteMaskArrays[pInput->numInputArrays]);
+    free((void *)pInput->inputArraysAddressName[pInput->numInputArrays]);
+    pendingArray=0;
+  }
+}
+
+void readInputFreeArrays(tInputDataPtr pInput){
   tRoadcUInt32 i;
-  for(i=0;i<numInputArrays;i++){
-    free((void *)inputArrays[i]);
+  for(i=0;i<pInput->numInputArrays;i++){
+    free((void *)pInput->inputArrays[i]);
   }
-  free((void *)inputArrays);
-  for(i=0;i<numInputArrays;i++){
-    if(inputPaddingByteMaskArrays[i]!=NULL){;
-      free((void *)inputPaddingByteMaskArrays[i]);
+  free((void *)pInput->inputArrays);
+  for(i=0;i<pInput->numInputArrays;i++){
+    if(pInput->inputPaddingByteMaskArrays[i]!=NULL){;
+      free((void *)pInput->inputPaddingByteMaskArrays[i]);
     }
   }
-  free((void *)inputPaddingByteMaskArrays);
-  free((void *)inputArraysSize);
-  free((void *)inputArraysAlignment);
-  free((void *)inputLineArray);
-  for(i=0;i<numInputArrays;i++){
-    free((void *)inputArraysAddressName[i]);
+  free((void *)pInput->inputPaddingByteMaskArrays);
+  free((void *)pInput->inputArraysSize);
+  free((void *)pInput->inputArraysAlignment);
+  for(i=0;i<pInput->numInputArrays;i++){
+    free((void *)pInput->inputArraysAddressName[i]);
   }
-  free((void *)inputArraysAddressName);
+  free((void *)pInput->inputArraysAddressName);
+}
+
+/* the array takes pData without a copy */
+void addNewArrayData(tInputDataPtr pInput, tRoadcBytePtr pData){
+  pendingArray=0;
+  pInput->inputArraysSize[pInput->numInputArrays]=numInputLineArray;
+  pInput->inputArrays[pInput->numInputArrays]=pData;
+  pInput->numInputArrays++;
+  pInput->numInputBytes = pInput->numInputBytes + numInputLineArray;
 }
 
-void addNewArray(){
+void addNewArray(tInputDataPtr pInput){
   tRoadcBytePtr pTmp;
-  tRoadcUInt32 i;
 
   pTmp = (tRoadcBytePtr)malloc(numInputLineArray*sizeof(tRoadcByte)); 
   if(pTmp==(tRoadcBytePtr)NULL){                                                
-    fprintf (stderr, "Can not allocate new array for input data\n");
-    exit(0);
+    readInputError("Can not allocate new array for input data\n");
   }                                                              
-  for(i=0; i<numInputLineArray; i++){
-    // copy data
-    pTmp[i]=inputLineArray[i];
-  }
-  reallocInputArrays();
-  inputArraysSize[numInputArrays]=numInputLineArray;
-  inputArrays[numInputArrays]=pTmp;
-  numInputArrays++;
-  numInputBytes = numInputBytes + numInputLineArray;
+  memcpy((void *)pTmp, (void *)inputLineArray, numInputLineArray*sizeof(tRoadcByte));
+  addNewArrayData(pInput, pTmp);
 }
 
-void readInputAcme(void){
+void readInputAcme(tInputDataPtr pInput){
   tRoadcUInt32 i;
   int value;
   int skipLineFlag;
   int inputFormatType;
   int paddingMaskWaringPrinted;
 
-  allocInputArrays();
+  allocInputArrays(pInput);
 
   while (isEndOfFile() == 0) {
     resetProcessNextLine();
     skipLineFlag = skipLine();
     if (skipLineFlag==0){
 
-      setArrayNameAndSize(numInputArrays);
+      initPendingArray(pInput);
+      setArrayNameAndSize(pInput, pInput->numInputArrays);
 
       incLine();
 
       inputFormatType = determineInputFormatType();
 
       if(inputFormatType == RI_FORMAT_NONE){
-        extractString(tmpString, 0);
-	fprintf (stderr, "Line: %d Column: %d: unknown array type keyword: '%s'.\n", getCurrentLine(), getCurrentColumn(), tmpString);
-	exit(0);
+        extractString(tmpString, sizeof(tmpString), 0);
+	readInputError("Line: %d Column: %d: unknown array type keyword: '%s'.\n", getCurrentLine(), getCurrentColumn(), tmpString);
       }
 
       if(inputFormatType == RI_FORMAT_BYTE){
@@ -280,8 +276,10 @@ void readInputAcme(void){
 	value = getNextValueByte();
       }
       if(inputFormatType == RI_FORMAT_BINARY){
+	/* the file is read at once, the data is the array */
 	consumeKeywordBinaryAndInit();
-	value = getNextValueBinary();
+	pInput->inputArrays[pInput->numInputArrays] = binaryTakeData(&numInputLineArray);
+	value = -1;
       }
 
 
@@ -289,12 +287,7 @@ void readInputAcme(void){
 	while(value>=0){
 	  inputLineArray[numInputLineArray]=(tRoadcByte)value;
 	  
-	  if(inputFormatType == RI_FORMAT_BYTE){
-	    value = getNextValueByte();
-	  }
-	  if(inputFormatType == RI_FORMAT_BINARY){
-	    value = getNextValueBinary();
-	  }
+	  value = getNextValueByte();
 	  
 	  numInputLineArray++;
 	  reallocInputLineArray();
@@ -307,21 +300,17 @@ void readInputAcme(void){
       if(numInputLineArray>0){
 	/* check for padding byte mask input */
 	inputFormatType = determineInputFormatType();
-	if(inputFormatType == RI_FORMAT_NONE){
-	  /* no padding byte mask */
-	  inputPaddingByteMaskArrays[numInputArrays]=(tRoadcBytePtr)NULL;
-	} else {
+	if(inputFormatType != RI_FORMAT_NONE){
 	  if(inputFormatType == RI_FORMAT_BYTE){
 	    consumeKeywordByte();
 	  }
 	  if(inputFormatType == RI_FORMAT_BINARY){
 	    consumeKeywordBinaryAndInit();
 	  }
-	  inputPaddingByteMaskArrays[numInputArrays] =
+	  pInput->inputPaddingByteMaskArrays[pInput->numInputArrays] =
 	    (tRoadcBytePtr)malloc(numInputLineArray*sizeof(tRoadcByte)); 
-	  if(inputPaddingByteMaskArrays[numInputArrays]==(tRoadcBytePtr)NULL){
-	    fprintf (stderr, "Can not allocate new array for input data\n");
-	    exit(0);
+	  if(pInput->inputPaddingByteMaskArrays[pInput->numInputArrays]==(tRoadcBytePtr)NULL){
+	    readInputError("Can not allocate new array for input data\n");
 	  }
 	  paddingMaskWaringPrinted=0;
 	  for(i=0; i<numInputLineArray;i++){
@@ -338,7 +327,7 @@ void readInputAcme(void){
 		paddingMaskWaringPrinted=1;
 	      }
 	    }
-	    inputPaddingByteMaskArrays[numInputArrays][i]=value;
+	    pInput->inputPaddingByteMaskArrays[pInput->numInputArrays][i]=value;
 	  }
 	  if(inputFormatType == RI_FORMAT_BYTE){
 	    value = getNextValueByte();
@@ -354,7 +343,14 @@ void readInputAcme(void){
 	    binaryClose();
 	  }
 	}
-	addNewArray();
+	if(pInput->inputArrays[pInput->numInputArrays]!=(tRoadcBytePtr)NULL){
+	  addNewArrayData(pInput, pInput->inputArrays[pInput->numInputArrays]);
+	} else {
+	  addNewArray(pInput);
+	}
+      } else {
+	/* empty arrays are dropped */
+	freePendingArray(pInput);
       }
     } else {
       incLine();
@@ -362,61 +358,104 @@ void readInputAcme(void){
   }
 }  
 
-void readInput(void)
+void readInput(tInputDataPtr pInput, char *pFileName)
 {
-  openInputFile();
+  pInput->inputArrays=(tRoadcBytePtr *)NULL;
+  pInput->inputPaddingByteMaskArrays=(tRoadcBytePtr *)NULL;
+  pInput->inputArraysAddressName=(char **)NULL;
+  pInput->inputArraysSize=(tRoadcUInt32 *)NULL;
+  pInput->inputArraysAlignment=(tRoadcUInt32 *)NULL;
+  pInput->numInputArrays=0;
+  pInput->numInputBytes=0;
+  pInput->maxNumInputArrays=0;
+
+  /* the span also ends after an error, see readInputChecked() */
+  roadcTraceBegin("read", 0);
+  openInputFile(pFileName);
 
   if(clCompilerType==CL_COMPILER_ACME){
-    readInputAcme();
+    readInputAcme(pInput);
   }
   
   closeInputFile();
+  /* the line buffer is only needed while reading */
+  free((void *)inputLineArray);
+  inputLineArray=(tRoadcByte *)NULL;
 
-  if (numInputBytes==0){
-    fprintf (stderr, "no input data in input file %s.\n", clFileIn);
-    exit(0);
+  if (pInput->numInputBytes==0){
+    readInputError("no input data in input file %s.\n", pFileName);
+  }
+  roadcTraceEnd("read", pInput->numInputArrays);
+}
+
+/* 
+   like readInput(), but an error in the input file does not stop compactor
+   return: 0: ok
+           1: error, the message is given by getReadInputErrorMessage(), 
+              nothing is allocated
+*/
+int readInputChecked(tInputDataPtr pInput, char *pFileName){
+  jmp_buf errorJump;
+
+  if(setjmp(errorJump)!=0){
+    setReadInputErrorJump((jmp_buf *)NULL);
+    closeInputFile();
+    binaryClose();
+    free((void *)inputLineArray);
+    inputLineArray=(tRoadcByte *)NULL;
+    if(pInput->inputArrays!=(tRoadcBytePtr *)NULL){
+      freePendingArray(pInput);
+    }
+    pendingArray=0;
+    readInputFreeArrays(pInput);
+    roadcTraceEnd("read", 0);
+    return 1;
   }
+  setReadInputErrorJump(&errorJump);
+  readInput(pInput, pFileName);
+  setReadInputErrorJump((jmp_buf *)NULL);
+  return 0;
 }
 
-tRoadcBytePtr getInputArray(tRoadcUInt32 index){
-  if(index>=numInputArrays){
+tRoadcBytePtr getInputArray(tInputDataPtr pInput, tRoadcUInt32 index){
+  if(index>=pInput->numInputArrays){
     fprintf (stderr, "index too large %ld.\n", index);
     exit(0);
   }
-  return inputArrays[index];
+  return pInput->inputArrays[index];
 }
-tRoadcBytePtr getInputPaddingByteMaskArray(tRoadcUInt32 index){
-  if(index>=numInputArrays){
+tRoadcBytePtr getInputPaddingByteMaskArray(tInputDataPtr pInput, tRoadcUInt32 index){
+  if(index>=pInput->numInputArrays){
     fprintf (stderr, "index too large %ld.\n", index);
     exit(0);
   }
-  return inputPaddingByteMaskArrays[index];
+  return pInput->inputPaddingByteMaskArrays[index];
 }
-char * getInputArrayName(tRoadcUInt32 index){
-  if(index>=numInputArrays){
+char * getInputArrayName(tInputDataPtr pInput, tRoadcUInt32 index){
+  if(index>=pInput->numInputArrays){
     fprintf (stderr, "index too large %ld.\n", index);
     exit(0);
   }
-  return inputArraysAddressName[index];
+  return pInput->inputArraysAddressName[index];
 }
-tRoadcUInt32 getInputArraySize(tRoadcUInt32 index){
-  if(index>=numInputArrays){
+tRoadcUInt32 getInputArraySize(tInputDataPtr pInput, tRoadcUInt32 index){
+  if(index>=pInput->numInputArrays){
     fprintf (stderr, "index too large %ld.\n", index);
     exit(0);
   }
-  return inputArraysSize[index];
+  return pInput->inputArraysSize[index];
 }
-tRoadcUInt32 getInputArrayAlignment(tRoadcUInt32 index){
-  if(index>=numInputArrays){
+tRoadcUInt32 getInputArrayAlignment(tInputDataPtr pInput, tRoadcUInt32 index){
+  if(index>=pInput->numInputArrays){
     fprintf (stderr, "index too large %ld.\n", index);
     exit(0);
   }
-  return inputArraysAlignment[index];
+  return pInput->inputArraysAlignment[index];
 }
 
-tRoadcUInt32 getInputNumArrays(void){
-  return numInputArrays;
+tRoadcUInt32 getInputNumArrays(tInputDataPtr pInput){
+  return pInput->numInputArrays;
 }
-tRoadcUInt32 getInputNumBytes(void){
-  return numInputBytes;
+tRoadcUInt32 getInputNumBytes(tInputDataPtr pInput){
+  return pInput->numInputBytes;
 }
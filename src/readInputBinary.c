@@ -32,21 +32,24 @@ THE SOFTWARE.
 
 #include <string.h>
 #include <stdlib.h>
-#include <errno.h>
 #include "readInputBinary.h"
 #include "readInputFile.h"
 #include "stringHandling.h"
 
 static char fileName[1000];
-static FILE *fpBin=NULL;
 
 static char tmpString[100];
-static int currentNumberBytes=0;
 static int numberBytes=-1;
 static int skipBytes=0;
 
+/* the bytes of the array are read at once: binaryReadBytes from the file, 
+   filled up with RIB_FILL_VALUE up to binarySize */
+static tRoadcBytePtr pBinaryData=(tRoadcBytePtr)NULL;
+static size_t binarySize=0;
+static size_t binaryReadBytes=0;
+static size_t binaryIndex=0;
+
 static int noMoreValues;
-static int fillingActive;
 static int fillingWarningPrinted;
 
 
@@ -55,7 +58,7 @@ static int fillingWarningPrinted;
           0: no binary array
 */
 unsigned int checkAndConsumeBinaryArray(unsigned int consumeFlag){
-  if(extractString(tmpString, consumeFlag)==0){
+  if(extractString(tmpString, sizeof(tmpString), consumeFlag)==0){
     return 0;
   }
 
@@ -79,13 +82,12 @@ unsigned int isBinaryArray(void){
 
 void setValueNumberBytes(void){
   int result;
-  result = extractNextNumberAsString(tmpString, 1);
+  result = extractNextNumberAsString(tmpString, sizeof(tmpString), 1);
   if(result==0){
     /* number given, transform it */
     result = convertPositiveDecimal(tmpString);
     if(result<=0){
-      fprintf (stderr, "Line: %d: wrong value for numberBytes (<=0).\n", getCurrentLine());
-      exit(0);
+      readInputError("Line: %d: wrong value for numberBytes (<=0).\n", getCurrentLine());
     }
     /* valid value given */
     numberBytes = result;
@@ -94,34 +96,40 @@ void setValueNumberBytes(void){
 
 void setValueSkipBytes(void){
   int result;
-  result = extractNextNumberAsString(tmpString, 1);
+  result = extractNextNumberAsString(tmpString, sizeof(tmpString), 1);
   if(result==0){
     /* number given, transform it */
     result = convertPositiveDecimal(tmpString);
     if(result<0){
-      fprintf (stderr, "Line: %d: wrong value for skipBytes (<0).\n", getCurrentLine());
-      exit(0);
+      readInputError("Line: %d: wrong value for skipBytes (<0).\n", getCurrentLine());
     }
     /* valid value given */
     skipBytes = result;
   }
 }
 
+/* warning for the first value filled up */
+void binaryFillingWarning(void){
+  if(fillingWarningPrinted==0){
+    printf("WARNING: Line: %d: more bytes requested by numberBytes then bytes in file %s (taking also skipBytes into account), filling up with value %d. Maybe this was not intended.\n", getCurrentLine(), fileName, (int)RIB_FILL_VALUE);
+    fillingWarningPrinted=1;
+  }
+}
+
 void consumeKeywordBinaryAndInit(void){
+  FILE *fpBin;
   int result;
   long fileSize;
+  size_t availableBytes;
   
   checkAndConsumeBinaryArray(1);
-  result = extractFilename(fileName, 1);
+  result = extractFilename(fileName, sizeof(fileName), 1);
   if(result==1){
-    fprintf (stderr, "Line: %d: Column: %d no valid filename given.\n", getCurrentLine(), getCurrentColumn());
-    exit(0);
+    readInputError("Line: %d: Column: %d no valid filename given.\n", getCurrentLine(), getCurrentColumn());
   }
   numberBytes=-1;
-  currentNumberBytes=0;
   skipBytes=0;
   noMoreValues=0;
-  fillingActive=0;
   fillingWarningPrinted=0;
   
   if(nextIsComma(1)==1){
@@ -135,8 +143,7 @@ void consumeKeywordBinaryAndInit(void){
   }
   fpBin = fopen(fileName, "rb");
   if (fpBin == NULL){
-    fprintf (stderr, "Line: %d: Can not open binary output file %s.\n", getCurrentLine(), fileName);
-    exit(0);
+    readInputError("Line: %d: Can not open binary output file %s.\n", getCurrentLine(), fileName);
   }
   /* get file size */
   result = fseek(fpBin, (long)0, SEEK_END);
@@ -147,72 +154,93 @@ void consumeKeywordBinaryAndInit(void){
       printf ("WARNING: Line: %d: file is empty: no data to read from file %s.\n", getCurrentLine(), fileName);
     }
   }
+  availableBytes = 0;
+  if(fileSize>(long)skipBytes){
+    availableBytes = (size_t)(fileSize-(long)skipBytes);
+  }
   if(skipBytes>0){
     /* skip given number of bytes from start of file stream == SEEK_SET */
     result = fseek(fpBin, (long)skipBytes, SEEK_SET);
     if(skipBytes>=fileSize){
       if(numberBytes==-1){
 	printf ("WARNING: Line: %d: skipBytes size >= file size: no data to read from file %s.\n", getCurrentLine(), fileName);
-	fillingActive=1;
 	fillingWarningPrinted=1;
       }
       if(numberBytes>0){
 	printf("WARNING: Line: %d: skipBytes size >= file size, but numberBytes set to a value >0: no data to read from file %s, filling up with value %d. Maybe this was not intended.\n", getCurrentLine(), fileName, (int)RIB_FILL_VALUE);
-	fillingActive=1;
       fillingWarningPrinted=1;
       }
     }
   }
-}
 
-void binaryClose(void){
+  /* read the whole range of the file in one call */
+  binarySize = availableBytes;
+  if(numberBytes!=-1){
+    binarySize = (size_t)numberBytes;
+  }
+  if(availableBytes>binarySize){
+    availableBytes = binarySize;
+  }
+  pBinaryData = (tRoadcBytePtr)malloc((binarySize+1)*sizeof(tRoadcByte));
+  if(pBinaryData==(tRoadcBytePtr)NULL){
+    fclose(fpBin);
+    readInputError("Line: %d: Can not allocate memory for binary input file %s.\n", getCurrentLine(), fileName);
+  }
+  /* a read error is handled like the end of the file */
+  binaryReadBytes = fread((void *)pBinaryData, 1, availableBytes, fpBin);
+  if(binaryReadBytes<binarySize){
+    memset((void *)&pBinaryData[binaryReadBytes], RIB_FILL_VALUE, binarySize-binaryReadBytes);
+  }
+  binaryIndex = 0;
+
   if(fclose(fpBin)>0){
-    fprintf (stderr, "Can not close binary input file %s.\n", fileName);
-    exit(0);
+    readInputError("Can not close binary input file %s.\n", fileName);
   }
 }
 
+void binaryClose(void){
+  free((void *)pBinaryData);
+  pBinaryData=(tRoadcBytePtr)NULL;
+}
+
+/* 
+   all bytes of the array, the caller owns the data
+   return: NULL: no bytes
+           else: data of size *pSize
+*/
+tRoadcBytePtr binaryTakeData(tRoadcUInt32 *pSize){
+  tRoadcBytePtr pData;
+
+  *pSize = 0;
+  if(binarySize==0){
+    return (tRoadcBytePtr)NULL;
+  }
+  if(binaryReadBytes<binarySize){
+    binaryFillingWarning();
+  }
+  pData = pBinaryData;
+  *pSize = (tRoadcUInt32)binarySize;
+  pBinaryData=(tRoadcBytePtr)NULL;
+  return pData;
+}
 
 /* 
    return:   -1: no next value
            else: binary value
 */
 int getNextValueBinary(void){
-  size_t result;
-  unsigned char value;
-
   if(noMoreValues==1){
     /* no more bytes */
     return -1;
   }
-  currentNumberBytes++;
-  if((numberBytes!=-1) && (currentNumberBytes>numberBytes)){
-    /* no more bytes */
+  if(binaryIndex>=binarySize){
+    /* numberBytes reached or end of file */
     noMoreValues=1;
     return -1;
   }
-  if((numberBytes!=-1) && (fillingActive==1)){
-    /* fillingActive can only be 1 for numberBytes > 0 */
-    return (int) RIB_FILL_VALUE;
+  if(binaryIndex>=binaryReadBytes){
+    binaryFillingWarning();
   }
-  result = fread((void *)&value, 1, 1, fpBin);
-  if(result!=1){
-    /* read error or EOF */
-    if(numberBytes==-1){
-      /* read until EOF, now indicate EOF */
-      noMoreValues=1;
-      return -1;
-    }
-    fillingActive=1;
-    if(fillingWarningPrinted==0){
-      printf("WARNING: Line: %d: more bytes requested by numberBytes then bytes in file %s (taking also skipBytes into account), filling up with value %d. Maybe this was not intended.\n", getCurrentLine(), fileName, (int)RIB_FILL_VALUE);
-      fillingWarningPrinted=1;
-    }
-    return (int) RIB_FILL_VALUE;
-  } else {
-    return (int) value;
-  }
-
-  return -1;
+  binaryIndex++;
+  return (int) pBinaryData[binaryIndex-1];
 }
-
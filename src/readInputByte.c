@@ -32,7 +32,6 @@ THE SOFTWARE.
 
 #include <string.h>
 #include <stdlib.h>
-#include <errno.h>
 #include "readInputByte.h"
 #include "readInputFile.h"
 #include "stringHandling.h"
@@ -43,7 +42,7 @@ static char tmpString[100];
           0: no byte array
 */
 unsigned int checkAndConsumeByteArray(unsigned int consumeFlag){
-  if(extractString(tmpString, consumeFlag)==0){
+  if(extractString(tmpString, sizeof(tmpString), consumeFlag)==0){
     return 0;
   }
 
@@ -84,8 +83,7 @@ void consumeKeywordByte(void){
 
 void checkRange(int value){
   if ((value<0) || (value>255)) {
-    fprintf (stderr, "Line: %d Column: %d: Value out of range [0..255]: %d.\n", getCurrentLine(), getCurrentColumn(), value);
-    exit(0);
+    readInputError("Line: %d Column: %d: Value out of range [0..255]: %d.\n", getCurrentLine(), getCurrentColumn(), value);
   }
 }
 
@@ -101,60 +99,81 @@ void checkRange(int value){
            else: byte value
 */
 int getNextValueByte(void){
+  char *pToken;
+  char *pTokenEnd;
+  char *pLineEnd;
   int value;
   
   if (isEndOfLine()==1){
     return -1;
   }
 
-  if(extractNextNumberAsString(tmpString, 1)==1){
+  /* the value is parsed in the line itself, see extractNextNumberAsString() */
+  pToken = getString();
+  pLineEnd = getLineEnd();
+  while((pToken<pLineEnd) &&
+	(charClass[(unsigned char)*pToken]&CHAR_CLASS_SEPARATOR)){
+    pToken++;
+  }
+  pTokenEnd = pToken;
+  if((pToken<pLineEnd) &&
+     (((int)*pToken==39) || /* sign ' */
+      (*pToken=='"'))){
+    /* is a single char, e.g. 'A' or "!" */
+    pTokenEnd = pToken + ((pLineEnd-pToken<3) ? (pLineEnd-pToken) : 3);
+  } else {
+    while((pTokenEnd<pLineEnd) &&
+	  !(charClass[(unsigned char)*pTokenEnd]&CHAR_CLASS_VALUE_END)){
+      pTokenEnd++;
+    }
+  }
+  setLinePosition(pTokenEnd);
+  if(pTokenEnd==pToken){
     return -1;
   }
 
-  if(((int)tmpString[0]==39) || /* sign ' */
-     (tmpString[0]=='"')){
-     if(strlen(tmpString)!=3){
-       fprintf (stderr, "Line: %d Column: %d: Wrong character value: %s.\n", getCurrentLine(), getCurrentColumn(), tmpString);
-       exit(0);
+  if(((int)pToken[0]==39) || /* sign ' */
+     (pToken[0]=='"')){
+     if(pTokenEnd-pToken!=3){
+       readInputError("Line: %d Column: %d: Wrong character value: %.*s.\n", getCurrentLine(), getCurrentColumn(), (int)(pTokenEnd-pToken), pToken);
      }
-     value = convertChar(&tmpString[1]);
+     value = convertChar(&pToken[1]);
      checkRange(value);
      return value;
    }
-  if(tmpString[0]=='$'){
-    value = convertHexadecimal(&tmpString[1]);
+  if(pToken[0]=='$'){
+    value = convertNumber(&pToken[1], pTokenEnd, 16);
     checkRange(value);
     return value;
   }
-  if(strlen(tmpString)>1){
-    if((tmpString[1]=='x') ||
-       (tmpString[1]=='X')){
-      value = convertHexadecimal(&tmpString[2]);
+  if(pTokenEnd-pToken>1){
+    if((pToken[1]=='x') ||
+       (pToken[1]=='X')){
+      value = convertNumber(&pToken[2], pTokenEnd, 16);
       checkRange(value);
       return value;
     }
   }
-  if(tmpString[0]=='%'){
-    value = convertBinary(&tmpString[1]);
+  if(pToken[0]=='%'){
+    value = convertNumber(&pToken[1], pTokenEnd, 2);
     checkRange(value);
     return value;
   }
-  if(tmpString[0]=='&'){
-    value = convertOctal(&tmpString[1]);
+  if(pToken[0]=='&'){
+    value = convertNumber(&pToken[1], pTokenEnd, 8);
     checkRange(value);
     return value;
   }
-  if(tmpString[0]=='-'){
-    value = convertNegativeDecimal(&tmpString[1]);
+  if(pToken[0]=='-'){
+    value = convertNegativeDecimal(&pToken[1], pTokenEnd);
     checkRange(value);
     return value;
   }
-  if((tmpString[0]>='0') && (tmpString[0]<='9')){
-    value = convertPositiveDecimal(&tmpString[0]);
+  if(charDigitValue[(unsigned char)pToken[0]]<10){
+    value = convertNumber(pToken, pTokenEnd, 10);
     checkRange(value);
     return value;
   } 
 
   return -1;
 }
-
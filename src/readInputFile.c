@@ -33,63 +33,184 @@ THE SOFTWARE.
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif /* _WIN32 */
 #include "commandLineParameter.h"
 #include "readInputFile.h"
 
-static FILE *fp;
-/* 10 MB with each byte build with 5 chars, e.g. "255, " */
-#define MAX_INPUT_LINE_SIZE 1024+1024*10*5
-static char *inputPtr = NULL;
-static ssize_t maxLineLength;
+/* The input file is mapped into memory (read into memory on Windows or if 
+   it can not be mapped), a line is a pointer into the file data with its 
+   length including the line feed, so lines of any length are read without 
+   copying. The line is not terminated by '\0'. */
+static char *fileName;
+static char *pFileData = NULL;
+static size_t fileSize = 0;
+static size_t nextLineOffset = 0;
+static int fileMapped = 0;
+static char emptyLine[1] = {'\0'};
+static char *inputPtr = emptyLine;
+static size_t maxLineLength = 0;
 static unsigned int endOfFile=0;
 static unsigned int endOfLine=0;
 static unsigned int line=0;
 static unsigned int column=0;
 static unsigned int saveColumn=0;
 
-void readNextLine(void){
-  char *result;
-  if(inputPtr==(char*)NULL){
-    inputPtr = (char *)malloc(MAX_INPUT_LINE_SIZE*sizeof(char));
+/* server mode: an error in a request must not stop the server */
+static jmp_buf *pReadInputErrorJump = NULL;
+static char readInputErrorMessage[READ_INPUT_MAX_ERROR_SIZE];
+
+void readInputError(const char *pFormat, ...){
+  va_list args;
+
+  va_start(args, pFormat);
+  if(pReadInputErrorJump!=NULL){
+    vsnprintf(readInputErrorMessage, sizeof(readInputErrorMessage), pFormat, args);
+    va_end(args);
+    longjmp(*pReadInputErrorJump, 1);
   }
+  vfprintf(stderr, pFormat, args);
+  va_end(args);
+  exit(0);
+}
+
+/* NULL: errors stop compactor */
+void setReadInputErrorJump(jmp_buf *pErrorJump){
+  pReadInputErrorJump = pErrorJump;
+}
+
+const char *getReadInputErrorMessage(void){
+  return readInputErrorMessage;
+}
+
+void readNextLine(void){
+  char *pLineFeed;
+
   column=0;
-  /* getline does not work with MinGW on Windows, exits at EOF 
-     so use fgets instead
-    size_t len=0;
-    maxLineLength = getline(&inputPtr, &len, fp);
-    if(maxLineLength == -1){
+  if(nextLineOffset>=fileSize){
+    /* the last line stays the current line */
     endOfFile=1;
     endOfLine=1;
+    return;
+  }
+  inputPtr = &pFileData[nextLineOffset];
+  pLineFeed = (char *)memchr(inputPtr, '\n', fileSize-nextLineOffset);
+  if(pLineFeed==NULL){
+    maxLineLength = fileSize-nextLineOffset;
+  } else {
+    maxLineLength = (size_t)(pLineFeed-inputPtr)+1;
+  }
+  nextLineOffset += maxLineLength;
+}
+
+/* whole file into memory if it can not be mapped, the size doubles while reading */
+void readFileData(FILE *fp){
+  size_t maxSize;
+  size_t numRead;
+  char *pTmp;
+
+  maxSize = 65536;
+  fileSize = 0;
+  pFileData = (char *)malloc(maxSize);
+  while(pFileData!=NULL){
+    numRead = fread(&pFileData[fileSize], 1, maxSize-fileSize, fp);
+    fileSize += numRead;
+    if(fileSize<maxSize){
+      break;
     }
-  */
-  result = fgets(inputPtr, MAX_INPUT_LINE_SIZE-1, fp);
-  if(result==(char*)NULL){
-    endOfFile=1;
-    endOfLine=1;
+    maxSize = 2*maxSize;
+    pTmp = (char *)realloc(pFileData, maxSize);
+    if(pTmp==NULL){
+      free(pFileData);
+    }
+    pFileData = pTmp;
   }
-  maxLineLength = strlen(inputPtr);
-  if(maxLineLength==0){
-    endOfLine=1;
+  if(pFileData==NULL){
+    fclose(fp);
+    readInputError("Can not allocate memory for input file %s.\n", fileName);
+  }
+  if(ferror(fp)){
+    fclose(fp);
+    readInputError("Can not read input file %s.\n", fileName);
   }
 }
 
-void openInputFile(void){
-  fp = fopen(clFileIn, "r");
-  if (fp == NULL){
-    fprintf (stderr, "Can not open input file %s.\n", clFileIn);
-    exit(0);
+void openInputFile(char *pFileName){
+  FILE *fp;
+#ifndef _WIN32
+  struct stat fileStat;
+  int fd;
+  void *pMap;
+#endif /* _WIN32 */
+
+  fileName = pFileName;
+  pFileData = NULL;
+  fileSize = 0;
+  fileMapped = 0;
+#ifndef _WIN32
+  fd = open(fileName, O_RDONLY);
+  if (fd < 0){
+    readInputError("Can not open input file %s.\n", fileName);
   }
+  if((fstat(fd, &fileStat)==0) && S_ISREG(fileStat.st_mode) && (fileStat.st_size>0)){
+    pMap = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(pMap!=MAP_FAILED){
+      pFileData = (char *)pMap;
+      fileSize = (size_t)fileStat.st_size;
+      fileMapped = 1;
+      /* the file is read once from the start to the end */
+      madvise(pMap, fileSize, MADV_SEQUENTIAL);
+    }
+  }
+  close(fd);
+#endif /* _WIN32 */
+  if(!fileMapped){
+    fp = fopen(fileName, "rb");
+    if (fp == NULL){
+      readInputError("Can not open input file %s.\n", fileName);
+    }
+    readFileData(fp);
+    if(fclose(fp)>0){
+      readInputError("Can not close input file %s.\n", fileName);
+    }
+  }
+  /* several input files are read one after another */
+  nextLineOffset=0;
+  inputPtr=emptyLine;
+  maxLineLength=0;
+  endOfFile=0;
+  endOfLine=0;
+  line=0;
+  column=0;
+  saveColumn=0;
   readNextLine();
 }
 
+/* also called after a read error, the file may be closed already */
 void closeInputFile(void){
-  if(fclose(fp)>0){
-    fprintf (stderr, "Can not close input file %s.\n", clFileIn);
-    exit(0);
-  }
-  if(inputPtr!=(char*)NULL){
-    free((void *)inputPtr);
+  char *pData;
+
+  pData = pFileData;
+  pFileData = NULL;
+#ifndef _WIN32
+  if(fileMapped){
+    fileMapped = 0;
+    if(munmap(pData, fileSize)!=0){
+      readInputError("Can not close input file %s.\n", fileName);
+    }
+    pData = NULL;
   }
+#endif /* _WIN32 */
+  free((void *)pData);
+  fileSize = 0;
+  inputPtr = emptyLine;
+  maxLineLength = 0;
 }  
 
 void saveCurrentColumnValue(){
@@ -128,8 +249,7 @@ void incToPtr(char *newPtr){
   while ((&inputPtr[column])!=newPtr){
     column++;
     if (column > (unsigned int) maxLineLength){
-      fprintf (stderr, "Can not inc to given pointer, end of input line reached.\n");
-      exit(0);
+      readInputError("Can not inc to given pointer, end of input line reached.\n");
     }
     if (column == (unsigned int) maxLineLength){
       column--; /* bring index back in range again */
@@ -160,12 +280,34 @@ char *getString(void){
   return &inputPtr[column];
 }
 
+/* the rest of the line from the current column up to getLineEnd() */
+char *getLineEnd(void){
+  return &inputPtr[maxLineLength];
+}
+
+/* consume the line up to pNew, the same as incColumn() */
+void setLinePosition(char *pNew){
+  incColumn((unsigned int)(pNew-&inputPtr[column]));
+}
+
+/* at most toSize-1 characters are copied, a longer string is an error 
+   if it is consumed, else it is cut (only compared with keywords) */
+void terminateString(char *to, size_t toSize, tRoadcUInt32 length, unsigned int consumeFlag){
+  if(length>=toSize){
+    if(consumeFlag==1){
+      readInputError("Line: %d: string longer than %lu characters.\n", getCurrentLine(), (unsigned long)(toSize-1));
+    }
+    length = (tRoadcUInt32)(toSize-1);
+  }
+  to[length]='\0';
+}
+
 /* consumeFlag: 0: do not change file input string
                 1: consume string from file input string
    return: 0: string not empty
            1: string is empty 
 */
-int extractString(char *to, unsigned int consumeFlag){
+int extractString(char *to, size_t toSize, unsigned int consumeFlag){
   tRoadcUInt32 i=0;
   int extracted=0;
   int isEmpty=0;
@@ -179,7 +321,9 @@ int extractString(char *to, unsigned int consumeFlag){
        (c=='\0')){
       extracted=1;
     } else {
-      to[i]=c;
+      if(i+1<toSize){
+        to[i]=c;
+      }
       i++;
       incColumn(1);
       isEmpty=1;
@@ -188,7 +332,7 @@ int extractString(char *to, unsigned int consumeFlag){
   if(consumeFlag==0){
     decColumn(i);
   }
-  to[i]='\0';
+  terminateString(to, toSize, i, consumeFlag);
   return isEmpty;
 }
 
@@ -206,7 +350,7 @@ int extractString(char *to, unsigned int consumeFlag){
    char        (e.g. "c" or ';')
 
 */
-int extractNextNumberAsString(char *to, unsigned int consumeFlag){
+int extractNextNumberAsString(char *to, size_t toSize, unsigned int consumeFlag){
   tRoadcUInt32 stringIndex=0;
   tRoadcUInt32 consumedBytes=0;
   int extracted=0;
@@ -234,19 +378,25 @@ int extractNextNumberAsString(char *to, unsigned int consumeFlag){
       /* is a single char, e.g. 'A' or "!" */
       isEmpty=0;
       extracted=1;
-      to[stringIndex]=c;
+      if(stringIndex+1<toSize){
+	to[stringIndex]=c;
+      }
       stringIndex++;
       incColumn(1);
       consumedBytes++;
       if(isEndOfLine()==0){
 	c = getChar();
-	to[stringIndex]=c;
+	if(stringIndex+1<toSize){
+	  to[stringIndex]=c;
+	}
 	stringIndex++;
 	incColumn(1);
 	consumedBytes++;
 	if(isEndOfLine()==0){
 	  c = getChar();
-	  to[stringIndex]=c;
+	  if(stringIndex+1<toSize){
+	    to[stringIndex]=c;
+	  }
 	  stringIndex++;
 	  incColumn(1);
 	  consumedBytes++;
@@ -264,7 +414,9 @@ int extractNextNumberAsString(char *to, unsigned int consumeFlag){
 	 (c=='#')){
 	extracted=1;
       } else {
-	to[stringIndex]=c;
+	if(stringIndex+1<toSize){
+	  to[stringIndex]=c;
+	}
 	stringIndex++;
 	incColumn(1);
 	consumedBytes++;
@@ -275,7 +427,7 @@ int extractNextNumberAsString(char *to, unsigned int consumeFlag){
   if(consumeFlag==0){
     decColumn(consumedBytes);
   }
-  to[stringIndex]='\0';
+  terminateString(to, toSize, stringIndex, consumeFlag);
 	
   return isEmpty;
 }
@@ -285,7 +437,7 @@ int extractNextNumberAsString(char *to, unsigned int consumeFlag){
    return: 0: string not empty
            1: string is empty 
 */
-int extractFilename(char *to, unsigned int consumeFlag){
+int extractFilename(char *to, size_t toSize, unsigned int consumeFlag){
   tRoadcUInt32 i=0;
   int quoteSignFound=0;
   char c;
@@ -329,7 +481,9 @@ int extractFilename(char *to, unsigned int consumeFlag){
 	 (c=='>')){
 	quoteSignFound=1;
       } else {
-	to[i]=c;
+	if(i+1<toSize){
+	  to[i]=c;
+	}
 	i++;
       }
       incColumn(1);
@@ -343,7 +497,7 @@ int extractFilename(char *to, unsigned int consumeFlag){
   if(consumeFlag==0){
     setToSavedColumnValue();
   }
-  to[i]='\0';
+  terminateString(to, toSize, i, consumeFlag);
   return 0;
 }
 
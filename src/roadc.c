@@ -32,166 +32,216 @@ THE SOFTWARE.
  *  @author Dr. Steffen Grzig
  */
 
-#include "roadc.h"
-#include "commandLineParameter.h"
-
-/* use next define for standard print output of some internal roadc information */
-#define ROADC_PRINTINTERNALS
-
-#ifdef ROADC_PRINTINTERNALS
-#ifdef __cplusplus
-#include <cstdio>
-#else
-#include <stdio.h>
-#endif /* __cplusplus */
-#define ROADC_NOTIFICATION_MSG(...) if(clVerbose){fprintf (stdout, __VA_ARGS__);}
-#define ROADC_ERROR_MSG(...) fprintf (stderr, __VA_ARGS__)
-#else
-#define ROADC_NOTIFICATION_MSG(...)
-#define ROADC_ERROR_MSG(...)
-#endif /* ROADC_PRINTINTERNALS */
-
-#ifdef __cplusplus
-#include <cstdlib>
-#else
-#include <stdlib.h>
-#endif /* __cplusplus */
-
-#ifndef __cplusplus
-#ifndef NULL
-#define NULL ((void *)0)
-#endif /* NULL */
-#endif /* __cplusplus */
-
-/* value to calculate without timeout in roadcCalculation() */ 
-#define ROADC_NO_TIMEOUT 0
-/* Define for padding byte mask values: is no padding byte */
-#define ROADC_NO_PADDING_BITS 0
-/* Define for padding byte mask values: all bits are padding bits */
-#define ROADC_ALL_PADDING_BITS 255
-
-#define ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(ptr, returnType)  { \
-  if(ptr==NULL){                                                 \
-    return (returnType)NULL;                                     \
-  }                                                              \
-} 
-
-#define ROADC_ALLOC_FAILED_WITHOUT_RETURN_VALUE(ptr)  { \
-  if(ptr==NULL){                                        \
-    return;                                             \
-  }                                                     \
-} 
-
+#include <stdarg.h>
+#include <string.h>
+#include "roadcInternal.h"
+
+/* maximal length of a message given to the logging function */
+#define ROADC_LOG_MESSAGE_SIZE 512
+
+void roadcLog(tRoadcPtr pRoadc,
+              tRoadcByte level,
+              const char *pFormat,
+              ...){
+  char message[ROADC_LOG_MESSAGE_SIZE];
+  va_list arguments;
+
+  va_start(arguments, pFormat);
+  if(pRoadc->pRoadcLogFunction==NULL){
+    vfprintf((level==ROADC_LOG_ERROR) ? stderr : stdout, pFormat, arguments);
+  } else {
+    vsnprintf(message, sizeof(message), pFormat, arguments);
+    pRoadc->pRoadcLogFunction(pRoadc->pRoadcLogUserData, level, message);
+  }
+  va_end(arguments);
+}
 
 void roadcInitDataEntry(tRoadcDataEntryPtr pEntry){
   pEntry->pData=(tRoadcBytePtr)NULL;
-  pEntry->pPaddingByteMask=(tRoadcBytePtr)NULL;
+  pEntry->ppPaddingByteMaskBlocks=(tRoadcBytePtrPtr)NULL;
   pEntry->size=0;
   pEntry->alignment=1;
   pEntry->alignmentOffset=0;
+  pEntry->index=0;
   pEntry->pPrevious=(struct tRoadcDataEntryStruct *)NULL;
   pEntry->pNext=(struct tRoadcDataEntryStruct *)NULL;
 };
 
-void roadcCopyDataEntry(tRoadcDataEntryPtr pFrom, 
-                        tRoadcDataEntryPtr pTo){
+/* The padding byte mask of a data entry is stored as a table of blocks with 
+   ROADC_PADDING_BLOCK_SIZE bytes each. Blocks without any padding bit are not
+   allocated (NULL), an entry without any padding bit has no table at all (NULL). 
+   The size of the table is always given by the current size of the data entry. */
+
+void roadcFreePaddingByteMask(tRoadcDataEntryPtr pEntry){
   tRoadcUInt32 i;
-  void *pTmp0=NULL;
-  void *pTmp1=NULL;
-  void *pTmp2=NULL;
-  void *pTmp3=NULL;
-  
-  /* get memory right */
-  if(NULL==pFrom->pData){
+  tRoadcUInt32 numberBlocks;
+  if(pEntry->ppPaddingByteMaskBlocks==NULL){
     return;
   }
-  if(NULL==pTo->pData){
-    pTmp0 = malloc(pFrom->size); 
-    if(NULL==pTmp0){
-      return;
-    }
-    pTo->pData = (tRoadcBytePtr)pTmp0;
-  }
-  if((NULL==pFrom->pPaddingByteMask) &&
-     (NULL!=pTo->pPaddingByteMask)){
-    free(pTo->pPaddingByteMask);
-    pTo->pPaddingByteMask=NULL;
-  }
-  if((NULL!=pFrom->pPaddingByteMask) &&
-     (NULL==pTo->pPaddingByteMask)){
-    pTmp1 = malloc(pFrom->size); 
-    if(NULL==pTmp1){
-      if(NULL!=pTmp0){
-	free(pTmp0);
-	pTo->pData = (tRoadcBytePtr)NULL;
-      }
-      return;
+  numberBlocks = ROADC_PADDING_BLOCK_NUMBER(pEntry->size);
+  for(i=0;i<numberBlocks;i++){
+    if(pEntry->ppPaddingByteMaskBlocks[i]!=NULL){
+      free(pEntry->ppPaddingByteMaskBlocks[i]);
+      ROADC_STATISTICS_FREE(ROADC_PADDING_BLOCK_SIZE);
     }
-    pTo->pPaddingByteMask = (tRoadcBytePtr)pTmp1;
   }
-  if(pFrom->size!=pTo->size){
-    if(pTo->pPaddingByteMask!=NULL){
-      free(pTo->pPaddingByteMask);
-      pTo->pPaddingByteMask=NULL;
+  free(pEntry->ppPaddingByteMaskBlocks);
+  ROADC_STATISTICS_FREE(numberBlocks*sizeof(tRoadcBytePtr));
+  pEntry->ppPaddingByteMaskBlocks=(tRoadcBytePtrPtr)NULL;
+}
+
+/* return: NULL: no padding bits for the bytes index...index+(*pSegmentLength)-1
+           else: padding byte mask for the bytes index...index+(*pSegmentLength)-1
+   Note: *pSegmentLength can exceed the entry size for the last block */
+tRoadcBytePtr roadcPaddingByteMaskSegment(tRoadcDataEntryPtr pEntry,
+                                          tRoadcUInt32 index,
+                                          tRoadcUInt32 *pSegmentLength){
+  tRoadcBytePtr pBlock;
+  if(pEntry->ppPaddingByteMaskBlocks==NULL){
+    *pSegmentLength = pEntry->size-index;
+    return (tRoadcBytePtr)NULL;
+  }
+  *pSegmentLength = ROADC_PADDING_BLOCK_SIZE-(index%ROADC_PADDING_BLOCK_SIZE);
+  pBlock = pEntry->ppPaddingByteMaskBlocks[index/ROADC_PADDING_BLOCK_SIZE];
+  if(pBlock==NULL){
+    return (tRoadcBytePtr)NULL;
+  }
+  return &pBlock[index%ROADC_PADDING_BLOCK_SIZE];
+}
+
+tRoadcByte roadcPaddingByteMaskGet(tRoadcDataEntryPtr pEntry,
+                                   tRoadcUInt32 index){
+  tRoadcBytePtr pMask;
+  tRoadcUInt32 segmentLength;
+  pMask = roadcPaddingByteMaskSegment(pEntry, index, &segmentLength);
+  if(pMask==NULL){
+    return ROADC_NO_PADDING_BITS;
+  }
+  return pMask[0];
+}
+
+/* blocks are allocated on demand, setting ROADC_NO_PADDING_BITS never allocates
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcPaddingByteMaskSet(tRoadcDataEntryPtr pEntry,
+                                   tRoadcUInt32 index,
+                                   tRoadcByte value){
+  tRoadcUInt32 block;
+  void *pTmp;
+  if(pEntry->ppPaddingByteMaskBlocks==NULL){
+    if(value==ROADC_NO_PADDING_BITS){
+      return 0;
     }
-    if(pFrom->pPaddingByteMask!=NULL){
-      pTmp2 = malloc(pFrom->size); 
-      if(NULL==pTmp2){
-	if(NULL!=pTmp0){
-	  free(pTmp0);
-	  pTo->pData = (tRoadcBytePtr)NULL;
-	}
-	if(NULL!=pTmp1){
-	  free(pTmp1);
-	  pTo->pPaddingByteMask = (tRoadcBytePtr)NULL;
-	}
-	return;
-      }
-      pTo->pPaddingByteMask = (tRoadcBytePtr)pTmp2;
+    pTmp = calloc(ROADC_PADDING_BLOCK_NUMBER(pEntry->size), sizeof(tRoadcBytePtr));
+    if(NULL==pTmp){
+      return 1;
     }
-    if(pTo->pData!=NULL){
-      free(pTo->pData);
-      pTo->pData=NULL;
+    pEntry->ppPaddingByteMaskBlocks = (tRoadcBytePtrPtr)pTmp;
+    ROADC_STATISTICS_ALLOCATION(ROADC_PADDING_BLOCK_NUMBER(pEntry->size)*sizeof(tRoadcBytePtr));
+  }
+  block = index/ROADC_PADDING_BLOCK_SIZE;
+  if(pEntry->ppPaddingByteMaskBlocks[block]==NULL){
+    if(value==ROADC_NO_PADDING_BITS){
+      return 0;
     }
-    pTmp3 = malloc(pFrom->size); 
-    if(NULL==pTmp3){
-      if(NULL!=pTmp0){
-	free(pTmp0);
-	pTo->pData = (tRoadcBytePtr)NULL;
-      }
-      if(NULL!=pTmp1){
-	free(pTmp1);
-	pTo->pPaddingByteMask = (tRoadcBytePtr)NULL;
+    pTmp = calloc(ROADC_PADDING_BLOCK_SIZE, sizeof(tRoadcByte));
+    if(NULL==pTmp){
+      return 1;
+    }
+    pEntry->ppPaddingByteMaskBlocks[block] = (tRoadcBytePtr)pTmp;
+    ROADC_STATISTICS_ALLOCATION(ROADC_PADDING_BLOCK_SIZE);
+  }
+  pEntry->ppPaddingByteMaskBlocks[block][index%ROADC_PADDING_BLOCK_SIZE] = value;
+  return 0;
+}
+
+/* build the block representation from a plain padding byte mask array of pEntry->size bytes, 
+   pEntry must not have a padding byte mask yet
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcNewPaddingByteMask(tRoadcDataEntryPtr pEntry,
+                                   tRoadcBytePtr pPaddingByteMask){
+  tRoadcUInt32 i;
+  for(i=0;i<pEntry->size;i++){
+    if(pPaddingByteMask[i]!=ROADC_NO_PADDING_BITS){
+      if(roadcPaddingByteMaskSet(pEntry, i, pPaddingByteMask[i])){
+        roadcFreePaddingByteMask(pEntry);
+        return 1;
       }
-      if(NULL!=pTmp2){
-	free(pTmp2);
-	pTo->pPaddingByteMask = (tRoadcBytePtr)NULL;
+    }
+  }
+  return 0;
+}
+
+/* copy size padding byte mask values from pFrom (starting at fromIndex) to pTo (starting at toIndex),
+   the destination range of pTo must not contain padding bits yet
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcCopyPaddingByteMask(tRoadcDataEntryPtr pFrom,
+                                    tRoadcUInt32 fromIndex,
+                                    tRoadcDataEntryPtr pTo,
+                                    tRoadcUInt32 toIndex,
+                                    tRoadcUInt32 size){
+  tRoadcBytePtr pMask;
+  tRoadcUInt32 segmentLength;
+  tRoadcUInt32 i;
+  while(size>0){
+    pMask = roadcPaddingByteMaskSegment(pFrom, fromIndex, &segmentLength);
+    if(segmentLength>size){
+      segmentLength = size;
+    }
+    if(pMask!=NULL){
+      for(i=0;i<segmentLength;i++){
+        if(roadcPaddingByteMaskSet(pTo, toIndex+i, pMask[i])){
+          return 1;
+        }
       }
-      return;
     }
-    pTo->pData = (tRoadcBytePtr)pTmp3;
+    fromIndex = fromIndex + segmentLength;
+    toIndex = toIndex + segmentLength;
+    size = size - segmentLength;
   }
-    
-  if(pFrom->pPaddingByteMask==NULL){
-    for (i=0;i<pFrom->size;i++){
-      pTo->pData[i] = pFrom->pData[i];
+  return 0;
+}
+
+/* return: 0: ok, 1: malloc error */
+tRoadcByte roadcCopyDataEntry(tRoadcDataEntryPtr pFrom, 
+                              tRoadcDataEntryPtr pTo){
+  tRoadcUInt32 i;
+  void *pTmp;
+  
+  /* get memory right */
+  if(NULL==pFrom->pData){
+    return 0;
+  }
+  if((NULL==pTo->pData) || (pFrom->size!=pTo->size)){
+    pTmp = malloc(pFrom->size); 
+    if(NULL==pTmp){
+      return 1;
     }
-  } else {
-    for (i=0;i<pFrom->size;i++){
-      pTo->pData[i] = pFrom->pData[i];
-      pTo->pPaddingByteMask[i] = pFrom->pPaddingByteMask[i];
+    if(NULL!=pTo->pData){
+      free(pTo->pData);
+      ROADC_STATISTICS_FREE(pTo->size);
     }
+    pTo->pData = (tRoadcBytePtr)pTmp;
+    ROADC_STATISTICS_ALLOCATION(pFrom->size);
+  }
+  roadcFreePaddingByteMask(pTo);
+    
+  for (i=0;i<pFrom->size;i++){
+    pTo->pData[i] = pFrom->pData[i];
   }
   pTo->size = pFrom->size;
   pTo->alignment=pFrom->alignment;
   pTo->alignmentOffset=pFrom->alignmentOffset;
 
+  return roadcCopyPaddingByteMask(pFrom, 0, pTo, 0, pFrom->size);
 }
 
 tRoadcBytePtr roadcMallocUnsignedCharArray(tRoadcUInt32 size){
   void *pTmp;
   pTmp = malloc(size); 
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmp, tRoadcBytePtr);
+  /* malloc failed: NULL, handled by the caller */
+  if(pTmp!=NULL){
+    ROADC_STATISTICS_ALLOCATION(size);
+  }
   return (tRoadcBytePtr)pTmp;
 }
 
@@ -200,8 +250,10 @@ tRoadcBytePtr roadcMallocUnsignedCharArrayAndFill(tRoadcUInt32 size,
   tRoadcBytePtr pTmp;
   tRoadcUInt32 i;
   pTmp = roadcMallocUnsignedCharArray(size);
-  /* malloc failed? */
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmp, tRoadcBytePtr);
+  if(pTmp==NULL){
+    /* malloc failed */
+    return (tRoadcBytePtr)NULL;
+  }
   for(i=0;i<size;i++){
     pTmp[i] = value;
   }
@@ -213,8 +265,10 @@ tRoadcBytePtr roadcMallocUnsignedCharArrayAndCopyData(tRoadcBytePtr pInputArray,
   tRoadcBytePtr pTmpArray;
   tRoadcUInt32 i;
   pTmpArray = roadcMallocUnsignedCharArray(inputArraySize);
-  /* malloc failed? */
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmpArray, tRoadcBytePtr);
+  if(pTmpArray==NULL){
+    /* malloc failed */
+    return (tRoadcBytePtr)NULL;
+  }
   /* copy data */
   for(i=0;i<inputArraySize;i++){
     pTmpArray[i] = pInputArray[i];
@@ -246,9 +300,8 @@ tRoadcUInt32 roadcLeastCommonMultiple(tRoadcUInt32 a,
   tRoadcUInt32 result;
   gcd = roadcGreatestCommonDivisor(a,b);
   result = ((a * b) / gcd);
-  if(result>=ROADC_MAX_INPUT_SIZE){
-    ROADC_ERROR_MSG("ERROR: the alignment values of the input arrays caused an overflow in alignment calculation. The result of roadC is NOT valid anymore!\n");
-  }
+  /* an overflow is reported for the concatenated result, the alignment of 
+     every merged array divides the alignment of the result */
   return result;
 }
 
@@ -299,34 +352,65 @@ tRoadcByte roadcAlignmentMergeCheckSolution(tRoadcUInt32 alignment,
   return 1;
 }
 
-void roadcAlignmentConcatenationCalculation(tRoadcByte copyData,
-                                            tRoadcDataEntryPtr pLeft,
-                                            tRoadcDataEntryPtr pRight,
-                                            tRoadcDataEntryPtr pResult){
+/* copy pFrom to pTo starting at *pToIndex, the data is preceded by numberFillBytes fill bytes 
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcAlignmentConcatenationCopy(tRoadcDataEntryPtr pFrom,
+                                           tRoadcUInt32 numberFillBytes,
+                                           tRoadcDataEntryPtr pTo,
+                                           tRoadcUInt32 *pToIndex){
+  tRoadcUInt32 i;
+  for (i=0;i<numberFillBytes;i++){
+    pTo->pData[*pToIndex] = 0;
+    if(roadcPaddingByteMaskSet(pTo, *pToIndex, ROADC_ALL_PADDING_BITS)){
+      return 1;
+    }
+    (*pToIndex)++;
+  }
+  for (i=0;i<pFrom->size;i++){
+    pTo->pData[(*pToIndex)+i] = pFrom->pData[i];
+  }
+  if(roadcCopyPaddingByteMask(pFrom, 0, pTo, *pToIndex, pFrom->size)){
+    return 1;
+  }
+  *pToIndex = *pToIndex + pFrom->size;
+  return 0;
+}
+
+/* return: 1: the longer pLeft is the first part of the concatenation, 0: pRight is first */
+tRoadcByte roadcAlignmentConcatenationLeftFirst(tRoadcDataEntryPtr pLeft,
+                                                tRoadcDataEntryPtr pRight){
+  tRoadcUInt32 completeLenLeft;
+  tRoadcUInt32 completeLenRight;
+
+  completeLenLeft = pLeft->size+pLeft->alignmentOffset;
+  completeLenRight = pRight->size+pRight->alignmentOffset;
+  if(completeLenLeft==completeLenRight){
+    return (tRoadcByte)(pLeft->alignment > pRight->alignment);
+  }
+  return (tRoadcByte)(completeLenLeft>completeLenRight);
+}
+
+/* return: 0: ok, 1: malloc error (only possible for copyData==1) */
+tRoadcByte roadcAlignmentConcatenationCalculation(tRoadcByte copyData,
+                                                  tRoadcDataEntryPtr pLeft,
+                                                  tRoadcDataEntryPtr pRight,
+                                                  tRoadcDataEntryPtr pResult){
 
   tRoadcUInt32 numberFillBytes;
   tRoadcUInt32 resIndex;
-  tRoadcUInt32 lastLeftIndex;
   tRoadcUInt32 completeLenLeft;
   tRoadcUInt32 completeLenRight;
   tRoadcUInt32 appendDataAlignment;
-  tRoadcUInt32 i;
   tRoadcByte appendLeftDataFirst;
+  if(copyData==1){
+    /* the padding byte mask of pResult is build up from scratch */
+    roadcFreePaddingByteMask(pResult);
+  }
   pResult->size = 0;
   numberFillBytes = 0;
   completeLenLeft = pLeft->size+pLeft->alignmentOffset;
   completeLenRight = pRight->size+pRight->alignmentOffset;
-  if(completeLenLeft==completeLenRight){
-    if(pLeft->alignment > pRight->alignment){
-      appendLeftDataFirst = 1;
-    } else {
-      appendLeftDataFirst = 0;
-    }
-  } else if (completeLenLeft>completeLenRight){
-    appendLeftDataFirst = 1;
-  } else {
-    appendLeftDataFirst = 0;
-  }
+  appendLeftDataFirst = roadcAlignmentConcatenationLeftFirst(pLeft, pRight);
   if(appendLeftDataFirst==1){
     pResult->size = completeLenLeft;
     appendDataAlignment = pRight->alignment;
@@ -352,102 +436,21 @@ void roadcAlignmentConcatenationCalculation(tRoadcByte copyData,
   pResult->alignmentOffset = 0;
 
   if(copyData==1){
+    /* alignment offsets and fill bytes are padding bytes */
     resIndex = 0;
     if(appendLeftDataFirst==1){
-      resIndex=resIndex+pLeft->alignmentOffset;
-      /* pResult must have a padding byte mask */
-      /* delete possible old values from old runs */
-      for (i=0;i<resIndex;i++){
-	pResult->pData[i] = 0;
-	pResult->pPaddingByteMask[i] = ROADC_ALL_PADDING_BITS; 
-      }
-      if(pLeft->pPaddingByteMask==NULL){
-        for (i=0;i<pLeft->size;i++){
-          pResult->pData[resIndex] = pLeft->pData[i];
-	  pResult->pPaddingByteMask[resIndex] = ROADC_NO_PADDING_BITS;
-          resIndex++;
-        }
-      } else {
-        for (i=0;i<pLeft->size;i++){
-          pResult->pData[resIndex] = pLeft->pData[i];
-          pResult->pPaddingByteMask[resIndex] = pLeft->pPaddingByteMask[i];
-          resIndex++;
-        }
-      }
-    } else {
-      resIndex=resIndex+pRight->alignmentOffset;
-      /* pResult must have a padding byte mask */
-      /* delete possible old values from old runs */
-      for (i=0;i<resIndex;i++){
-	pResult->pData[i] = 0;
-	pResult->pPaddingByteMask[i] = ROADC_ALL_PADDING_BITS; 
-      }
-      if(pRight->pPaddingByteMask==NULL){
-        for (i=0;i<pRight->size;i++){
-          pResult->pData[resIndex] = pRight->pData[i];
-	  pResult->pPaddingByteMask[resIndex] = ROADC_NO_PADDING_BITS;
-          resIndex++;
-        }
-      } else {
-	/* pResult must have a padding byte mask */
-	/* delete possible old values from old runs */
-        for (i=0;i<resIndex;i++){
-          pResult->pData[i] = 0;
-	  pResult->pPaddingByteMask[i] = ROADC_ALL_PADDING_BITS; 
-        }
-        for (i=0;i<pRight->size;i++){
-          pResult->pData[resIndex] = pRight->pData[i];
-          pResult->pPaddingByteMask[resIndex] = pRight->pPaddingByteMask[i];
-          resIndex++;
-        }
-      }
-    }
-    lastLeftIndex = resIndex;
-    resIndex=resIndex + numberFillBytes;
-    if(appendLeftDataFirst==1){
-      resIndex=resIndex+pRight->alignmentOffset;
-      /* pResult must have a padding byte mask */
-      /* delete possible old values from old runs */
-      for (i=lastLeftIndex;i<resIndex;i++){
-	pResult->pData[i] = 0;
-	pResult->pPaddingByteMask[i] = ROADC_ALL_PADDING_BITS; 
-      }
-      if(pRight->pPaddingByteMask==NULL){
-        for (i=0;i<pRight->size;i++){
-          pResult->pData[resIndex] = pRight->pData[i];
-	  pResult->pPaddingByteMask[resIndex] = ROADC_NO_PADDING_BITS;
-          resIndex++;
-        }
-      } else {
-        for (i=0;i<pRight->size;i++){
-          pResult->pData[resIndex] = pRight->pData[i];
-          pResult->pPaddingByteMask[resIndex] = pRight->pPaddingByteMask[i];
-          resIndex++;
-        }
+      if(roadcAlignmentConcatenationCopy(pLeft, pLeft->alignmentOffset, pResult, &resIndex) ||
+         roadcAlignmentConcatenationCopy(pRight, numberFillBytes+pRight->alignmentOffset, pResult, &resIndex)){
+        return 1;
       }
     } else {
-      resIndex=resIndex+pLeft->alignmentOffset;
-      /* pResult must have a padding byte mask */
-      /* delete possible old values from old runs */
-      for (i=lastLeftIndex;i<resIndex;i++){
-	pResult->pData[i] = 0;
-	pResult->pPaddingByteMask[i] = ROADC_ALL_PADDING_BITS; 
-      }
-      if(pLeft->pPaddingByteMask==NULL){
-        for (i=0;i<pLeft->size;i++){
-          pResult->pData[resIndex] = pLeft->pData[i];
-	  pResult->pPaddingByteMask[resIndex] = ROADC_NO_PADDING_BITS;
-          resIndex++;
-        }
-      } else {
-        for (i=0;i<pLeft->size;i++){
-          pResult->pData[resIndex] = pLeft->pData[i];
-          pResult->pPaddingByteMask[resIndex] = pLeft->pPaddingByteMask[i];
-          resIndex++;
-        }
+      if(roadcAlignmentConcatenationCopy(pRight, pRight->alignmentOffset, pResult, &resIndex) ||
+         roadcAlignmentConcatenationCopy(pLeft, numberFillBytes+pLeft->alignmentOffset, pResult, &resIndex)){
+        return 1;
       }
     }
   }
+  return 0;
 }
 
 tRoadcByte roadcAlignmentMergeCalculation(tRoadcDataEntryPtr pLeft,
@@ -462,6 +465,7 @@ tRoadcByte roadcAlignmentMergeCalculation(tRoadcDataEntryPtr pLeft,
   tRoadcUInt32 offset;
   tRoadcUInt32 alignment;
 
+  ROADC_STATISTICS_ADD(alignmentCalls, 1);
   offset = pLeft->alignmentOffset;
   if(pRight->alignmentOffset>overlapBeginIndex){
     offsetRight = (pRight->alignmentOffset-overlapBeginIndex);
@@ -496,13 +500,27 @@ tRoadcByte roadcAlignmentMergeCalculation(tRoadcDataEntryPtr pLeft,
   return 0;
 }
 
+/* wall clock time in seconds, clock() is the processor time of all threads */
+tRoadcFloat64 roadcTimerNow(void){
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (tRoadcFloat64)now.tv_sec + (tRoadcFloat64)now.tv_nsec/1.0e9;
+}
+
+/* processor time of all threads in seconds */
+tRoadcFloat64 roadcTimerCpuNow(void){
+  struct timespec now;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+  return (tRoadcFloat64)now.tv_sec + (tRoadcFloat64)now.tv_nsec/1.0e9;
+}
+
 void roadcTimerStart(tRoadcPtr pRoadc){
-  pRoadc->roadcStartTime=clock();
+  pRoadc->roadcStartTime=roadcTimerNow();
 }
 
 tRoadcUInt32 roadcTimerRead(tRoadcPtr pRoadc){
-  pRoadc->roadcEndTime=clock();
-  return ((tRoadcUInt32)((tRoadcFloat64)(pRoadc->roadcEndTime - pRoadc->roadcStartTime) / (tRoadcFloat64)CLOCKS_PER_SEC));
+  pRoadc->roadcEndTime=roadcTimerNow();
+  return ((tRoadcUInt32)(pRoadc->roadcEndTime - pRoadc->roadcStartTime));
 }
   
 
@@ -512,11 +530,14 @@ tRoadcDataEntryPtr roadcNewRoadcDataEntry(tRoadcBytePtr pInputArray,
                                           tRoadcUInt32 inputAlignment){
 
   tRoadcBytePtr pTmpArray;
-  tRoadcBytePtr pTmpArrayPaddingByteMask;
   void *pTmp;
   tRoadcDataEntryPtr pElem;
   pTmp = malloc(sizeof(tRoadcDataEntry)); 
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmp, tRoadcDataEntryPtr);
+  if(pTmp==NULL){
+    /* malloc failed */
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  ROADC_STATISTICS_ALLOCATION(sizeof(tRoadcDataEntry));
   pElem = (tRoadcDataEntryPtr)pTmp;
 
   pTmpArray = roadcMallocUnsignedCharArrayAndCopyData(pInputArray,
@@ -526,26 +547,23 @@ tRoadcDataEntryPtr roadcNewRoadcDataEntry(tRoadcBytePtr pInputArray,
     free(pTmp);
     return (tRoadcDataEntryPtr)NULL;
   }
-  if(pInputPaddingByteMask!=NULL){
-    pTmpArrayPaddingByteMask = 
-      roadcMallocUnsignedCharArrayAndCopyData(pInputPaddingByteMask,
-                                              inputArraySize);
-  /* malloc failed? */
-    if(pTmpArrayPaddingByteMask==NULL){
-      free(pTmp);
-      free(pTmpArray);
-      return (tRoadcDataEntryPtr)NULL;
-    }
-  } else {
-    pTmpArrayPaddingByteMask = NULL  ;
-  }
   pElem->size = inputArraySize;
   pElem->pData = pTmpArray;
-  pElem->pPaddingByteMask = pTmpArrayPaddingByteMask;
+  pElem->ppPaddingByteMaskBlocks = NULL;
   pElem->alignment = inputAlignment;
   pElem->alignmentOffset = 0;
+  pElem->index = 0;
   pElem->pPrevious = NULL;
   pElem->pNext = NULL;
+  if(pInputPaddingByteMask!=NULL){
+    /* an all zero padding byte mask results in no padding byte mask */
+    if(roadcNewPaddingByteMask(pElem, pInputPaddingByteMask)){
+      /* malloc failed */
+      free(pTmp);
+      free(pTmpArray);
+      return (tRoadcDataEntryPtr)NULL;
+    }
+  }
 
   return pElem;
 }
@@ -557,7 +575,10 @@ tRoadcBytePtr roadcNewAndConcatenateData(tRoadcBytePtr pArr1,
   tRoadcBytePtr pTmpArray;
   tRoadcUInt32 i;
   pTmpArray = roadcMallocUnsignedCharArray(sizeArr1+sizeArr2);
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmpArray, tRoadcBytePtr);
+  if(pTmpArray==NULL){
+    /* malloc failed */
+    return (tRoadcBytePtr)NULL;
+  }
   /* copy data */
   for(i=0;i<sizeArr1;i++){
     pTmpArray[i] = pArr1[i];
@@ -568,38 +589,27 @@ tRoadcBytePtr roadcNewAndConcatenateData(tRoadcBytePtr pArr1,
   return pTmpArray;
 }
 
-tRoadcBytePtr roadcNewAndConcatenatePaddingByteMask(tRoadcBytePtr pMask1, 
-                                                    tRoadcUInt32 maskSize1,
-                                                    tRoadcBytePtr pMask2,
-                                                    tRoadcUInt32 maskSize2){
-  tRoadcBytePtr pTmpArray;
-  tRoadcUInt32 i;
-  pTmpArray = roadcMallocUnsignedCharArray(maskSize1+maskSize2);
-  /* malloc failed? */
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmpArray, tRoadcBytePtr);
-  if(pMask1==NULL){
-    /* generate data */
-    for(i=0;i<maskSize1;i++){
-      pTmpArray[i] = ROADC_NO_PADDING_BITS;
-    }
-  } else {
-    /* copy data */
-    for(i=0;i<maskSize1;i++){
-      pTmpArray[i] = pMask1[i];
-    }
+/* padding byte mask for pElem = pElem1 + pElem2 without its first elem2OverlapSize bytes,
+   only blocks with padding bits are generated
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcNewAndConcatenatePaddingByteMask(tRoadcDataEntryPtr pElem,
+                                                 tRoadcDataEntryPtr pElem1, 
+                                                 tRoadcDataEntryPtr pElem2,
+                                                 tRoadcUInt32 elem2OverlapSize){
+  if((pElem1->ppPaddingByteMaskBlocks==NULL) && (pElem2->ppPaddingByteMaskBlocks==NULL)){
+    /* no padding bits at all */
+    return 0;
   }
-  if(pMask2==NULL){
-    /* generate data */
-    for(i=0;i<maskSize2;i++){
-      pTmpArray[i+maskSize1] = ROADC_NO_PADDING_BITS;
-    }
-  } else {
-    /* copy data */
-    for(i=0;i<maskSize2;i++){
-      pTmpArray[i+maskSize1] = pMask2[i];
-    }
+  if(roadcCopyPaddingByteMask(pElem1, 0, 
+                              pElem, 0, 
+                              pElem1->size) ||
+     roadcCopyPaddingByteMask(pElem2, elem2OverlapSize, 
+                              pElem, pElem1->size, 
+                              pElem2->size-elem2OverlapSize)){
+    roadcFreePaddingByteMask(pElem);
+    return 1;
   }
-  return pTmpArray;
+  return 0;
 }
 
 tRoadcDataEntryPtr roadcNewRoadcDataEntryByConcatenation(tRoadcDataEntryPtr pElem1, 
@@ -608,12 +618,15 @@ tRoadcDataEntryPtr roadcNewRoadcDataEntryByConcatenation(tRoadcDataEntryPtr pEle
                                                          tRoadcUInt32 newAlignmentOffset,
                                                          tRoadcUInt32 elem2OverlapSize){
   tRoadcBytePtr pTmpArray;
-  tRoadcBytePtr pTmpPaddingByteMask;
   void *pTmp;
   tRoadcDataEntryPtr pElem;
 
   pTmp = malloc(sizeof(tRoadcDataEntry)); 
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmp, tRoadcDataEntryPtr);
+  if(pTmp==NULL){
+    /* malloc failed */
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  ROADC_STATISTICS_ALLOCATION(sizeof(tRoadcDataEntry));
   pElem = (tRoadcDataEntryPtr)pTmp;
   pTmpArray = roadcNewAndConcatenateData(pElem1->pData, pElem1->size,
                                         &(pElem2->pData[elem2OverlapSize]), pElem2->size-elem2OverlapSize);
@@ -624,45 +637,88 @@ tRoadcDataEntryPtr roadcNewRoadcDataEntryByConcatenation(tRoadcDataEntryPtr pEle
     return (tRoadcDataEntryPtr)NULL;
   }
 
-  if((pElem1->pPaddingByteMask==NULL) &&(pElem2->pPaddingByteMask==NULL)){
-    pTmpPaddingByteMask = NULL;
-  } else {
-    pTmpPaddingByteMask = roadcNewAndConcatenatePaddingByteMask(pElem1->pPaddingByteMask, pElem1->size,
-                                                               &(pElem2->pPaddingByteMask[elem2OverlapSize]), 
-                                                               pElem2->size-elem2OverlapSize);
-    /* malloc failed? */
-    if(pTmpPaddingByteMask==NULL){
-      free(pTmp);
-      free(pTmpArray);
-      return (tRoadcDataEntryPtr)NULL;
-    }
-  }
-
   pElem->pData = pTmpArray;
-  pElem->pPaddingByteMask = pTmpPaddingByteMask;
+  pElem->ppPaddingByteMaskBlocks = NULL;
   pElem->size = pElem1->size+pElem2->size-elem2OverlapSize;
   pElem->alignment = newAlignment;
   pElem->alignmentOffset = newAlignmentOffset;
+  pElem->index = 0;
   pElem->pPrevious = NULL;
   pElem->pNext = NULL;
 
+  if(roadcNewAndConcatenatePaddingByteMask(pElem, pElem1, pElem2, elem2OverlapSize)){
+    /* malloc failed */
+    free(pTmp);
+    free(pTmpArray);
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  ROADC_STATISTICS_ADD(merges, 1);
+  roadcTraceInstant("merge", elem2OverlapSize);
+
+  return pElem;
+}
+
+tRoadcDataEntryPtr roadcNewRoadcDataEntryByCopy(tRoadcDataEntryPtr pFrom){
+  void *pTmp;
+  tRoadcDataEntryPtr pElem;
+
+  pTmp = malloc(sizeof(tRoadcDataEntry)); 
+  if(pTmp==NULL){
+    /* malloc failed */
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  ROADC_STATISTICS_ALLOCATION(sizeof(tRoadcDataEntry));
+  pElem = (tRoadcDataEntryPtr)pTmp;
+  roadcInitDataEntry(pElem);
+  if(roadcCopyDataEntry(pFrom, pElem)){
+    /* malloc failed */
+    roadcFreeRoadcDataEntry(pElem);
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  pElem->index = pFrom->index;
   return pElem;
 }
 
+/* linear congruential generator (Knuth MMIX), own state per context */
+tRoadcUInt32 roadcRandom(tRoadcPtr pRoadc){
+  pRoadc->roadcRandomState = pRoadc->roadcRandomState*6364136223846793005ULL + 1442695040888963407ULL;
+  return (tRoadcUInt32)(pRoadc->roadcRandomState>>33);
+}
+
+/* order of arrays with equal size given by the strategy, 
+   return 1 if the new array is inserted before the existing array */
+tRoadcByte roadcInsertBeforeEqual(tRoadcPtr pRoadc,
+                                  tRoadcDataEntryPtr pNewElem,
+                                  tRoadcDataEntryPtr pElem){
+  switch(pRoadc->roadcStrategy & (~ROADC_STRATEGY_RIGHT_FIRST)){
+  case ROADC_STRATEGY_ALIGNMENT_FIRST:
+    return (tRoadcByte)(pNewElem->alignment>=pElem->alignment);
+  case ROADC_STRATEGY_RANDOM:
+    return (tRoadcByte)(roadcRandom(pRoadc)&1);
+  default:
+    return 1;
+  }
+}
+
 void roadcInsertDataEntry(tRoadcPtr pRoadc,
                           tRoadcDataEntryPtr pNewElem){
   tRoadcDataEntryPtr pCurrent;
   tRoadcDataEntryPtr pNext;
+  tRoadcByte tieBreak;
 
   /* pRoadc->pRoadcFirstDataEntry pointer is NULL if pRoadc->roadcNumberDataEntries==0, check anyway */
  
+  /* largest first: new array before existing arrays of equal size, no tie break needed */
+  tieBreak = (tRoadcByte)((pRoadc->roadcStrategy & (~ROADC_STRATEGY_RIGHT_FIRST))!=ROADC_STRATEGY_LARGEST_FIRST);
   if((pRoadc->roadcNumberDataEntries==0) || (pRoadc->pRoadcFirstDataEntry==NULL)){
     pRoadc->roadcNumberDataEntries=0;
     pNewElem->pPrevious = NULL;
     pNewElem->pNext = NULL;
     pRoadc->pRoadcFirstDataEntry=pNewElem;
     pRoadc->pRoadcLastDataEntry = pNewElem;
-  } else if ((*pRoadc->pRoadcFirstDataEntry).size<=pNewElem->size) {
+  } else if (((*pRoadc->pRoadcFirstDataEntry).size<pNewElem->size) ||
+             (((*pRoadc->pRoadcFirstDataEntry).size==pNewElem->size) &&
+              ((!tieBreak) || roadcInsertBeforeEqual(pRoadc, pNewElem, pRoadc->pRoadcFirstDataEntry)))) {
     (*pRoadc->pRoadcFirstDataEntry).pPrevious = pNewElem;
     pNewElem->pPrevious = NULL;
     pNewElem->pNext = pRoadc->pRoadcFirstDataEntry;
@@ -670,7 +726,10 @@ void roadcInsertDataEntry(tRoadcPtr pRoadc,
   } else {
     pCurrent = pRoadc->pRoadcFirstDataEntry;
     pNext = (*pRoadc->pRoadcFirstDataEntry).pNext;
-    while((pNext!=NULL)&&(pNext->size>pNewElem->size)){
+    while((pNext!=NULL)&&
+          ((pNext->size>pNewElem->size) ||
+           (tieBreak && (pNext->size==pNewElem->size) && 
+            (!roadcInsertBeforeEqual(pRoadc, pNewElem, pNext))))){
       pCurrent = pCurrent->pNext;
       pNext = pNext->pNext;
     }
@@ -692,11 +751,11 @@ void roadcFreeRoadcDataEntry(tRoadcDataEntryPtr pElem){
   if(pElem!=NULL){
     if(pElem->pData!=NULL){
       free(pElem->pData);
+      ROADC_STATISTICS_FREE(pElem->size);
     }
-    if(pElem->pPaddingByteMask!=NULL){
-      free(pElem->pPaddingByteMask);
-    }
+    roadcFreePaddingByteMask(pElem);
     free(pElem);
+    ROADC_STATISTICS_FREE(sizeof(tRoadcDataEntry));
   }
 }
 
@@ -770,8 +829,12 @@ void roadcAddElement(tRoadcPtr pRoadc,
   pRoadc->roadcCurrentInputSize=pRoadc->roadcCurrentInputSize+size;
 
   pTmp =  roadcNewRoadcDataEntry(pData, size, pPaddingByteMask, alignment);
-  /* alloc failed? */
-  ROADC_ALLOC_FAILED_WITHOUT_RETURN_VALUE(pTmp);
+  if(pTmp==NULL){
+    /* the compacted data would miss this array */
+    pRoadc->roadcMemoryError=1;
+    ROADC_ERROR_MSG(pRoadc, "ERROR: not enough memory to add an array of size %lu.\n", size);
+    return;
+  }
   roadcInsertDataEntry(pRoadc, pTmp);
 }
 
@@ -790,7 +853,28 @@ void roadcInitialize(tRoadc * const pRoadc){
   pRoadc->roadcNumberDataEntries=0;
   pRoadc->roadcStopedByTimeout=0;
   pRoadc->roadcCurrentInputSize=0;
-
+  pRoadc->pRoadcCompactedDataPaddingByteMask=NULL;
+  pRoadc->pRoadcOverlapMemo=NULL;
+  pRoadc->pRoadcLocalSearch=NULL;
+  pRoadc->roadcLocalSearchTimeShare=0;
+  pRoadc->roadcExactMode=ROADC_EXACT_AUTO;
+  pRoadc->roadcVerbose=0;
+  pRoadc->roadcStrategy=ROADC_STRATEGY_LARGEST_FIRST;
+  pRoadc->roadcRandomState=0;
+  pRoadc->roadcPortfolioSize=1;
+  pRoadc->roadcLowerBound=0;
+  pRoadc->roadcTargetGap=ROADC_NO_TARGET_GAP;
+  pRoadc->roadcEngine=ROADC_ENGINE_GREEDY;
+  pRoadc->pRoadcOrder=NULL;
+  pRoadc->roadcOrderSize=0;
+  pRoadc->roadcOrderError=0;
+  pRoadc->roadcNumberShards=1;
+  pRoadc->pRoadcLogFunction=NULL;
+  pRoadc->pRoadcLogUserData=NULL;
+  pRoadc->roadcMaxMemory=0;
+  pRoadc->roadcMemoryError=0;
+  roadcStatisticsInit(&pRoadc->roadcStatistics);
+  roadcProgressInit(pRoadc);
 }
 
 
@@ -799,7 +883,10 @@ tRoadcPtr roadcNew(void){
   void *pTmp;
 
   pTmp = malloc(sizeof(tRoadc)); 
-  ROADC_ALLOC_FAILED_WITH_RETURN_VALUE(pTmp, tRoadcPtr);
+  if(pTmp==NULL){
+    /* malloc failed, no context for messages */
+    return (tRoadcPtr)NULL;
+  }
   pRoadc = (tRoadcPtr)pTmp;
 
   roadcInitialize(pRoadc);
@@ -822,6 +909,10 @@ void roadcDeleteEntries(tRoadcPtr pRoadc){
   pRoadc->roadcNumberDataEntries=0;
   pRoadc->pRoadcFirstDataEntry=NULL;
   pRoadc->pRoadcLastDataEntry=NULL;
+  if(pRoadc->pRoadcCompactedDataPaddingByteMask!=NULL){
+    free(pRoadc->pRoadcCompactedDataPaddingByteMask);
+    pRoadc->pRoadcCompactedDataPaddingByteMask=NULL;
+  }
 }
 
 void roadcDelete(tRoadcPtr pRoadc){
@@ -829,6 +920,7 @@ void roadcDelete(tRoadcPtr pRoadc){
     return;
   }
   roadcDeleteEntries(pRoadc);
+  free(pRoadc->pRoadcOrder);
   if(pRoadc!=NULL){
     free(pRoadc);
   }
@@ -845,6 +937,7 @@ tRoadcByte roadcArraysEqual(tRoadcBytePtr pArr1,
   if((pArr1PaddingByteMask==NULL) && (pArr2PaddingByteMask==NULL)){
     for(i=0;i<(tRoadcUInt32)length;i++){
       if(pArr1[i]!=pArr2[i]){
+        ROADC_STATISTICS_COMPARE(i+1, 0);
         return 0;
       }
     }
@@ -853,6 +946,7 @@ tRoadcByte roadcArraysEqual(tRoadcBytePtr pArr1,
       tmp1 = pArr1[i] | pArr1PaddingByteMask[i];
       tmp2 = pArr2[i] | pArr1PaddingByteMask[i];
       if(tmp1!=tmp2){
+        ROADC_STATISTICS_COMPARE(i+1, 0);
         return 0;
       }
     }
@@ -861,6 +955,7 @@ tRoadcByte roadcArraysEqual(tRoadcBytePtr pArr1,
       tmp1 = pArr1[i] | pArr2PaddingByteMask[i];
       tmp2 = pArr2[i] | pArr2PaddingByteMask[i];
       if(tmp1!=tmp2){
+        ROADC_STATISTICS_COMPARE(i+1, 0);
         return 0;
       }
     }
@@ -869,10 +964,54 @@ tRoadcByte roadcArraysEqual(tRoadcBytePtr pArr1,
       tmp1 = pArr1[i] | pArr1PaddingByteMask[i] | pArr2PaddingByteMask[i];
       tmp2 = pArr2[i] | pArr1PaddingByteMask[i] | pArr2PaddingByteMask[i];
       if(tmp1!=tmp2){
+        ROADC_STATISTICS_COMPARE(i+1, 0);
         return 0;
       }
     }
   }
+  ROADC_STATISTICS_COMPARE(length, 1);
+  return 1;
+}
+
+/* compare length bytes of pEntry1 (starting at index1) and pEntry2 (starting at index2)
+   segment by segment, segments without padding bits use the mask free compare,
+   bytes outside of an array are never equal */
+tRoadcByte roadcDataEntriesEqual(tRoadcDataEntryPtr pEntry1,
+                                 tRoadcUInt32 index1,
+                                 tRoadcDataEntryPtr pEntry2,
+                                 tRoadcUInt32 index2,
+                                 tRoadcUInt32 length){
+  tRoadcBytePtr pMask1;
+  tRoadcBytePtr pMask2;
+  tRoadcUInt32 segmentLength1;
+  tRoadcUInt32 segmentLength2;
+  if((index1>pEntry1->size)||(length>pEntry1->size-index1)||
+     (index2>pEntry2->size)||(length>pEntry2->size-index2)){
+    return 0;
+  }
+  if((pEntry1->ppPaddingByteMaskBlocks==NULL) && (pEntry2->ppPaddingByteMaskBlocks==NULL)){
+    return roadcArraysEqual(&pEntry1->pData[index1], NULL,
+                            &pEntry2->pData[index2], NULL,
+                            length);
+  }
+  while(length>0){
+    pMask1 = roadcPaddingByteMaskSegment(pEntry1, index1, &segmentLength1);
+    pMask2 = roadcPaddingByteMaskSegment(pEntry2, index2, &segmentLength2);
+    if(segmentLength1>segmentLength2){
+      segmentLength1 = segmentLength2;
+    }
+    if(segmentLength1>length){
+      segmentLength1 = length;
+    }
+    if(roadcArraysEqual(&pEntry1->pData[index1], pMask1,
+                        &pEntry2->pData[index2], pMask2,
+                        segmentLength1)==0){
+      return 0;
+    }
+    index1 = index1 + segmentLength1;
+    index2 = index2 + segmentLength1;
+    length = length - segmentLength1;
+  }
   return 1;
 }
 
@@ -880,26 +1019,23 @@ tRoadcUInt32 roadcArrayGetPosition(tRoadcDataEntryPtr pThisArray,
                                    tRoadcDataEntryPtr pInThisArray){
   tRoadcUInt32 numberOfCompares;
   tRoadcUInt32 i;
-  tRoadcBytePtr pTmpPaddingByteMask;
-  tRoadcByte useInThisArrayPaddingByteMask;
+  tRoadcUInt32 position;
   if(pThisArray->size>pInThisArray->size){
     /* pThisArray too long, can not be part of pInThisArray */
     return pInThisArray->size;
   }
+  if(roadcWildcardMatchIsFaster(pThisArray, pInThisArray)){
+    if(roadcWildcardMatchGetPosition(pThisArray, pInThisArray, &position)==0){
+      return position;
+    }
+    /* not possible (e.g. malloc failed), use compare based search */
+  }
   numberOfCompares = (pInThisArray->size-pThisArray->size) + 1;
-  pTmpPaddingByteMask = NULL;
-  useInThisArrayPaddingByteMask=0;
-  if(pInThisArray->pPaddingByteMask!=NULL){
-    useInThisArrayPaddingByteMask=1;
-  } 
 
   for(i=0;i<numberOfCompares;i++){
-    if(useInThisArrayPaddingByteMask){
-      pTmpPaddingByteMask = &pInThisArray->pPaddingByteMask[i];
-    }
-    if(roadcArraysEqual(pThisArray->pData, pThisArray->pPaddingByteMask,
-                        &pInThisArray->pData[i], pTmpPaddingByteMask, 
-                        pThisArray->size)){
+    if(roadcDataEntriesEqual(pThisArray, 0,
+                             pInThisArray, i, 
+                             pThisArray->size)){
       if(roadcAlignmentPositionInResultCheck(pInThisArray->alignment,
 					     pThisArray->alignment,
 					     i)){
@@ -912,129 +1048,143 @@ tRoadcUInt32 roadcArrayGetPosition(tRoadcDataEntryPtr pThisArray,
   return pInThisArray->size;
 }
 
-void roadcAdaptInPlacePaddingByteMaskForCaseIncluded(tRoadcBytePtr pThisArray, 
-						     tRoadcBytePtr pThisArrayPaddingByteMask,
-						     tRoadcBytePtr pInThisArrayAdaptedInPlace,
-						     tRoadcBytePtr pInThisArrayPaddingByteMaskAdaptedInPlace,
-						     tRoadcUInt32 size){
+void roadcAdaptInPlacePaddingByteMaskForCaseIncluded(tRoadcDataEntryPtr pThisArray, 
+						     tRoadcDataEntryPtr pInThisArrayAdaptedInPlace,
+						     tRoadcUInt32 position){
   tRoadcUInt32 i;
+  tRoadcUInt32 index;
+  tRoadcUInt32 segmentLength;
+  tRoadcUInt32 thisSegmentLength;
+  tRoadcBytePtr pThisData;
+  tRoadcBytePtr pThisMask;
+  tRoadcBytePtr pInThisData;
+  tRoadcBytePtr pInThisMask;
   tRoadcByte tmpP;
   tRoadcByte tmpD;
-  if(pInThisArrayPaddingByteMaskAdaptedInPlace==NULL){
+  if(pInThisArrayAdaptedInPlace->ppPaddingByteMaskBlocks==NULL){
     /* no change in padding bytes needed */
     return;
   }
-  if(pThisArrayPaddingByteMask==NULL){
-    /* all padding bytes have to be set to false
-       all values must be copied */
-    for(i=0;i<size;i++){
-      pInThisArrayPaddingByteMaskAdaptedInPlace[i]=ROADC_NO_PADDING_BITS;
-      pInThisArrayAdaptedInPlace[i] = pThisArray[i];
+  index = 0;
+  while(index<pThisArray->size){
+    pInThisMask = roadcPaddingByteMaskSegment(pInThisArrayAdaptedInPlace, position+index, &segmentLength);
+    pThisMask = roadcPaddingByteMaskSegment(pThisArray, index, &thisSegmentLength);
+    if(segmentLength>thisSegmentLength){
+      segmentLength = thisSegmentLength;
     }
-    return;
-  }
-  for(i=0;i<size;i++){
-    tmpP = pInThisArrayPaddingByteMaskAdaptedInPlace[i] & pThisArrayPaddingByteMask[i];
-    tmpD = ((pInThisArrayAdaptedInPlace[i] & (~pInThisArrayPaddingByteMaskAdaptedInPlace[i])) | 
-            (pThisArray[i] & (~pThisArrayPaddingByteMask[i])));
-    pInThisArrayPaddingByteMaskAdaptedInPlace[i] = tmpP;
-    pInThisArrayAdaptedInPlace[i] = tmpD;
+    if(segmentLength>(pThisArray->size-index)){
+      segmentLength = pThisArray->size-index;
+    }
+    pInThisData = &pInThisArrayAdaptedInPlace->pData[position+index];
+    pThisData = &pThisArray->pData[index];
+    if(pInThisMask==NULL){
+      /* no change in padding bytes needed */
+    } else if(pThisMask==NULL){
+      /* all padding bytes have to be set to false
+         all values must be copied */
+      for(i=0;i<segmentLength;i++){
+        pInThisMask[i]=ROADC_NO_PADDING_BITS;
+        pInThisData[i] = pThisData[i];
+      }
+    } else {
+      for(i=0;i<segmentLength;i++){
+        tmpP = pInThisMask[i] & pThisMask[i];
+        tmpD = ((pInThisData[i] & (~pInThisMask[i])) | 
+                (pThisData[i] & (~pThisMask[i])));
+        pInThisMask[i] = tmpP;
+        pInThisData[i] = tmpD;
+      }
+    }
+    index = index + segmentLength;
   }
 }
 
-void roadcAdaptInPlacePaddingByteMaskForCaseOverlap(tRoadcBytePtr pThisArrayAdaptInPlace, 
-						    tRoadcBytePtr pThisArrayPaddingByteMaskAdaptInPlace,
-						    tRoadcBytePtr pWithThisArrayAdaptInPlace,
-						    tRoadcBytePtr pWithThisArrayPaddingByteMaskAdaptInPlace,
+void roadcAdaptInPlacePaddingByteMaskForCaseOverlap(tRoadcDataEntryPtr pThisArrayAdaptInPlace, 
+						    tRoadcUInt32 position,
+						    tRoadcDataEntryPtr pWithThisArrayAdaptInPlace,
 						    tRoadcUInt32 size){
   tRoadcUInt32 i;
+  tRoadcUInt32 index;
+  tRoadcUInt32 segmentLength;
+  tRoadcUInt32 withSegmentLength;
+  tRoadcBytePtr pThisData;
+  tRoadcBytePtr pThisMask;
+  tRoadcBytePtr pWithThisData;
+  tRoadcBytePtr pWithThisMask;
   tRoadcByte tmpP;
   tRoadcByte tmpD;
-  if(pThisArrayPaddingByteMaskAdaptInPlace==NULL){
-    if(pWithThisArrayPaddingByteMaskAdaptInPlace==NULL){
-      /* no change in padding bytes needed */
-      return;
-    } else {
-      for(i=0;i<size;i++){
-        pWithThisArrayPaddingByteMaskAdaptInPlace[i]=ROADC_NO_PADDING_BITS;
-        pWithThisArrayAdaptInPlace[i] = pThisArrayAdaptInPlace[i];
-      }
-      return;
+  if((pThisArrayAdaptInPlace->ppPaddingByteMaskBlocks==NULL) &&
+     (pWithThisArrayAdaptInPlace->ppPaddingByteMaskBlocks==NULL)){
+    /* no change in padding bytes needed */
+    return;
+  }
+  index = 0;
+  while(index<size){
+    pThisMask = roadcPaddingByteMaskSegment(pThisArrayAdaptInPlace, position+index, &segmentLength);
+    pWithThisMask = roadcPaddingByteMaskSegment(pWithThisArrayAdaptInPlace, index, &withSegmentLength);
+    if(segmentLength>withSegmentLength){
+      segmentLength = withSegmentLength;
     }
-  } else {
-    if(pWithThisArrayPaddingByteMaskAdaptInPlace==NULL){
-      for(i=0;i<size;i++){
-        pThisArrayPaddingByteMaskAdaptInPlace[i]=ROADC_NO_PADDING_BITS;
-        pThisArrayAdaptInPlace[i] = pWithThisArrayAdaptInPlace[i];
+    if(segmentLength>(size-index)){
+      segmentLength = size-index;
+    }
+    pThisData = &pThisArrayAdaptInPlace->pData[position+index];
+    pWithThisData = &pWithThisArrayAdaptInPlace->pData[index];
+    if(pThisMask==NULL){
+      if(pWithThisMask!=NULL){
+        for(i=0;i<segmentLength;i++){
+          pWithThisMask[i]=ROADC_NO_PADDING_BITS;
+          pWithThisData[i] = pThisData[i];
+        }
       }
-      return;
     } else {
-      for(i=0;i<size;i++){
-        tmpP = pWithThisArrayPaddingByteMaskAdaptInPlace[i] & pThisArrayPaddingByteMaskAdaptInPlace[i];
-        tmpD = ((pWithThisArrayAdaptInPlace[i] & (~pWithThisArrayPaddingByteMaskAdaptInPlace[i])) | 
-                (pThisArrayAdaptInPlace[i] & (~pThisArrayPaddingByteMaskAdaptInPlace[i])));
-        pWithThisArrayPaddingByteMaskAdaptInPlace[i] = tmpP;
-        pWithThisArrayAdaptInPlace[i] = tmpD;
-        pThisArrayPaddingByteMaskAdaptInPlace[i]=tmpP;
-        pThisArrayAdaptInPlace[i] = tmpD;
+      if(pWithThisMask==NULL){
+        for(i=0;i<segmentLength;i++){
+          pThisMask[i]=ROADC_NO_PADDING_BITS;
+          pThisData[i] = pWithThisData[i];
+        }
+      } else {
+        for(i=0;i<segmentLength;i++){
+          tmpP = pWithThisMask[i] & pThisMask[i];
+          tmpD = ((pWithThisData[i] & (~pWithThisMask[i])) | 
+                  (pThisData[i] & (~pThisMask[i])));
+          pWithThisMask[i] = tmpP;
+          pWithThisData[i] = tmpD;
+          pThisMask[i]=tmpP;
+          pThisData[i] = tmpD;
+        }
       }
     }
+    index = index + segmentLength;
   }
 }
 
-tRoadcByte roadcIsOverlap(tRoadcBytePtr pLeftArray,
-                          tRoadcBytePtr pLeftArrayPaddingByteMask,
-                          tRoadcUInt32 leftArraySize,
-                          tRoadcBytePtr pRightArray,
-                          tRoadcBytePtr pRightArrayPaddingByteMask,
+tRoadcByte roadcIsOverlap(tRoadcDataEntryPtr pLeftArray,
+                          tRoadcDataEntryPtr pRightArray,
                           tRoadcUInt32 overlap){
-  tRoadcBytePtr pTmpData;
-  tRoadcBytePtr pTmpPaddingByteMask;
-  tRoadcUInt32 i;
-  tRoadcByte tmp1;
-  tRoadcByte tmp2;
-
-  pTmpData=&pLeftArray[leftArraySize-overlap];
-  pTmpPaddingByteMask=NULL;
-  if(pLeftArrayPaddingByteMask!=NULL){
-    pTmpPaddingByteMask=&pLeftArrayPaddingByteMask[leftArraySize-overlap];
+  if((overlap>pLeftArray->size)||(overlap>pRightArray->size)){
+    return 0;
   }
+  return roadcDataEntriesEqual(pLeftArray, pLeftArray->size-overlap,
+                               pRightArray, 0,
+                               overlap);
+}
 
-  if((pLeftArrayPaddingByteMask==NULL) && (pRightArrayPaddingByteMask==NULL)){
-    for(i=0;i<overlap;i++){
-      if(pTmpData[i]!=pRightArray[i]){
-        return 0;
-      }
-    }
-    return 1;
-  } else if((pLeftArrayPaddingByteMask!=NULL) && (pRightArrayPaddingByteMask==NULL)){
-    for(i=0;i<overlap;i++){
-      tmp1 = pTmpData[i] | pTmpPaddingByteMask[i];
-      tmp2 = pRightArray[i] | pTmpPaddingByteMask[i];
-      if(tmp1!=tmp2){
-          return 0;
-      }
-    }
-    return 1;
-  } else if(pLeftArrayPaddingByteMask==NULL){
-    for(i=0;i<overlap;i++){
-      tmp1 = pTmpData[i] | pRightArrayPaddingByteMask[i];
-      tmp2 = pRightArray[i] | pRightArrayPaddingByteMask[i];
-      if(tmp1!=tmp2){
-        return 0;
-      }
-    }
-    return 1;
-  } else {
-    for(i=0;i<overlap;i++){
-      tmp1 = pTmpData[i] | pRightArrayPaddingByteMask[i] | pTmpPaddingByteMask[i];
-      tmp2 = pRightArray[i] | pRightArrayPaddingByteMask[i] | pTmpPaddingByteMask[i];
-      if(tmp1!=tmp2){
-        return 0;
-      }
-    }
-    return 1;
+tRoadcByte roadcGreedyIsOverlap(tRoadcPtr pRoadc,
+                                tRoadcDataEntryPtr pLeftArray,
+                                tRoadcDataEntryPtr pRightArray,
+                                tRoadcUInt32 overlap){
+  if((overlap>pLeftArray->size)||(overlap>pRightArray->size)){
+    return 0;
+  }
+  if((pRoadc->pRoadcOverlapMemo==NULL)||
+     ((pLeftArray->ppPaddingByteMaskBlocks==NULL)&&(pRightArray->ppPaddingByteMaskBlocks==NULL))){
+    /* without padding bits a compare fails fast */
+    return roadcDataEntriesEqual(pLeftArray, pLeftArray->size-overlap,
+                                 pRightArray, 0,
+                                 overlap);
   }
+  return roadcOverlapMemoIsOverlap(pRoadc, pLeftArray, pRightArray, overlap);
 }
 
 void roadcSetGreedyVariables(tRoadcPtr pRoadc,
@@ -1064,19 +1214,41 @@ tRoadcByte roadcGreedyConcatenate(tRoadcPtr pRoadc,
     /* malloc error */
     return 1; 
   }
+  /* the new element continues the merge chain of the left element */
+  (*ppNewElem)->index = pElemA->index;
+  roadcOverlapMemoReplace(pRoadc, *ppNewElem);
+  roadcLocalSearchRecordMerge(pRoadc, pElemA, pElemB);
   roadcRemoveDataEntry(pRoadc, pElemA);
   roadcRemoveDataEntry(pRoadc, pElemB);
   roadcInsertDataEntry(pRoadc, *ppNewElem);
+  ROADC_PROGRESS_SAVED(pRoadc, elemBOverlapSize);
   return 0; /* no malloc error */
 }
 
+/* overlap and alignment check of the left array with the right array for the current overlap size */
+tRoadcByte roadcGreedyIsMerge(tRoadcPtr pRoadc,
+                              tRoadcDataEntryPtr pLeftArray,
+                              tRoadcDataEntryPtr pRightArray,
+                              tRoadcDataEntryPtr pCalcResult){
+  if(!roadcGreedyIsOverlap(pRoadc, pLeftArray, pRightArray,
+                           pRoadc->roadcGreedyCurrentOverlapSize)){
+    return 0;
+  }
+  ROADC_STATISTICS_OVERLAP_HIT(pRoadc->roadcGreedyCurrentOverlapSize);
+  return roadcAlignmentMergeCalculation(pLeftArray, pRightArray,
+                                        pLeftArray->size-pRoadc->roadcGreedyCurrentOverlapSize,
+                                        pCalcResult);
+}
+
 tRoadcByte roadcGreedyStep(tRoadcPtr pRoadc){
   tRoadcDataEntryPtr pTmp;
   tRoadcDataEntryPtr pTmp2;
+  tRoadcDataEntryPtr pLeft;
+  tRoadcDataEntryPtr pRight;
   tRoadcByte checkOverlapLeft;
   tRoadcByte checkOverlapRight;
+  tRoadcByte found;
   tRoadcUInt32 tmpPos;
-  tRoadcBytePtr pTmpPaddingByteMask;
   tRoadcDataEntry calcResult;
   tRoadcDataEntryPtr pNewElem;
 
@@ -1096,29 +1268,45 @@ tRoadcByte roadcGreedyStep(tRoadcPtr pRoadc){
        (pRoadc->pRoadcGreedyCurrentDataEntrySmaller==pRoadc->pRoadcFirstRightOverlapCheckDataEntry)){
       checkOverlapRight=1;
     }
-    if(checkOverlapLeft &&
-       (roadcIsOverlap((*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pData,
-                       (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pPaddingByteMask,
-                       (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).size,
-                       (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pData,
-                       (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pPaddingByteMask,
-                       pRoadc->roadcGreedyCurrentOverlapSize))&&
-       (roadcAlignmentMergeCalculation(pRoadc->pRoadcGreedyCurrentDataEntryLarger,
-                                       pRoadc->pRoadcGreedyCurrentDataEntrySmaller,
-                                       (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).size-
-                                       pRoadc->roadcGreedyCurrentOverlapSize,
-                                       &calcResult)) 
-       ){
-      /* overlap left found */
-      tmpPos = (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).size-pRoadc->roadcGreedyCurrentOverlapSize;
-      pTmpPaddingByteMask=NULL;
-      if((*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pPaddingByteMask!=NULL){
-        pTmpPaddingByteMask=&(*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pPaddingByteMask[tmpPos];
+    /* overlap left: smaller array right of the larger array,
+       overlap right: smaller array left of the larger array */
+    found = ROADC_GREEDY_OVERLAP_NONE;
+    /* after a merge the next array may be too small for the current overlap size */
+    if((*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).size>pRoadc->roadcGreedyCurrentOverlapSize){
+      if(pRoadc->roadcStrategy & ROADC_STRATEGY_RIGHT_FIRST){
+        if(checkOverlapRight &&
+           roadcGreedyIsMerge(pRoadc, pRoadc->pRoadcGreedyCurrentDataEntrySmaller,
+                              pRoadc->pRoadcGreedyCurrentDataEntryLarger, &calcResult)){
+          found = ROADC_GREEDY_OVERLAP_RIGHT;
+        } else if(checkOverlapLeft &&
+                  roadcGreedyIsMerge(pRoadc, pRoadc->pRoadcGreedyCurrentDataEntryLarger,
+                                     pRoadc->pRoadcGreedyCurrentDataEntrySmaller, &calcResult)){
+          found = ROADC_GREEDY_OVERLAP_LEFT;
+        }
+      } else {
+        if(checkOverlapLeft &&
+           roadcGreedyIsMerge(pRoadc, pRoadc->pRoadcGreedyCurrentDataEntryLarger,
+                              pRoadc->pRoadcGreedyCurrentDataEntrySmaller, &calcResult)){
+          found = ROADC_GREEDY_OVERLAP_LEFT;
+        } else if(checkOverlapRight &&
+                  roadcGreedyIsMerge(pRoadc, pRoadc->pRoadcGreedyCurrentDataEntrySmaller,
+                                     pRoadc->pRoadcGreedyCurrentDataEntryLarger, &calcResult)){
+          found = ROADC_GREEDY_OVERLAP_RIGHT;
+        }
+      }
+    }
+    if(found!=ROADC_GREEDY_OVERLAP_NONE){
+      if(found==ROADC_GREEDY_OVERLAP_LEFT){
+        pLeft = pRoadc->pRoadcGreedyCurrentDataEntryLarger;
+        pRight = pRoadc->pRoadcGreedyCurrentDataEntrySmaller;
+      } else {
+        pLeft = pRoadc->pRoadcGreedyCurrentDataEntrySmaller;
+        pRight = pRoadc->pRoadcGreedyCurrentDataEntryLarger;
       }
-      roadcAdaptInPlacePaddingByteMaskForCaseOverlap(&(*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pData[tmpPos],
-						     pTmpPaddingByteMask,
-						     (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pData,
-						     (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pPaddingByteMask,
+      tmpPos = pLeft->size-pRoadc->roadcGreedyCurrentOverlapSize;
+      roadcAdaptInPlacePaddingByteMaskForCaseOverlap(pLeft,
+						     tmpPos,
+						     pRight,
 						     pRoadc->roadcGreedyCurrentOverlapSize); 
       /* store roadcGreedyCurrentIndexSmaller and -Larger 
          due to this variables and roadcFirstIndexToCheckForOverlapRight 
@@ -1132,8 +1320,8 @@ tRoadcByte roadcGreedyStep(tRoadcPtr pRoadc){
         pTmp2=pTmp;
       }
       if(roadcGreedyConcatenate(pRoadc,
-                                pRoadc->pRoadcGreedyCurrentDataEntryLarger, 
-                                pRoadc->pRoadcGreedyCurrentDataEntrySmaller, 
+                                pLeft, 
+                                pRight, 
                                 &pNewElem,
                                 calcResult.alignment,
                                 calcResult.alignmentOffset,
@@ -1144,58 +1332,13 @@ tRoadcByte roadcGreedyStep(tRoadcPtr pRoadc){
       /* the call of roadcGreedyConcatenate() removes two elements and adds a new element
          The greedy variable are adapted (e.g. pointer pRoadc->pRoadcGreedyCurrentDataEntrySmaller 
          and pRoadc->pRoadcGreedyCurrentDataEntryLarger */
-      roadcSetGreedyVariables(pRoadc, pNewElem, pNewElem->pNext, 
-                              pRoadc->roadcGreedyCurrentOverlapSize, pTmp2, pTmp);
-    } else if(checkOverlapRight&&
-              (roadcIsOverlap((*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pData,
-                              (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pPaddingByteMask,
-                              (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).size,
-                              (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pData,
-                              (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pPaddingByteMask,
-                              pRoadc->roadcGreedyCurrentOverlapSize)) &&
-              (roadcAlignmentMergeCalculation(pRoadc->pRoadcGreedyCurrentDataEntrySmaller,
-                                              pRoadc->pRoadcGreedyCurrentDataEntryLarger,
-                                              (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).size-
-                                              pRoadc->roadcGreedyCurrentOverlapSize,
-                                              &calcResult)) 
-              ){
-      /* overlap right found */
-      tmpPos = (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).size-pRoadc->roadcGreedyCurrentOverlapSize;
-      pTmpPaddingByteMask=NULL;
-      if((*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pPaddingByteMask!=NULL){
-        pTmpPaddingByteMask=&(*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pPaddingByteMask[tmpPos];
-      }
-      roadcAdaptInPlacePaddingByteMaskForCaseOverlap(&(*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pData[tmpPos],
-						     pTmpPaddingByteMask,
-						     (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pData,
-						     (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pPaddingByteMask,
-						     pRoadc->roadcGreedyCurrentOverlapSize); 
-      /* store roadcGreedyCurrentIndexSmaller and -Larger due to this variables 
-         and roadcFirstIndexToCheckForOverlapRight
-         are changed by calling roadcGreedyConcatenate() */
-      checkOverlapLeft=0;
-      checkOverlapRight=0;
-      pTmp = (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pNext;
-      pTmp2 = (*pRoadc->pRoadcGreedyCurrentDataEntryLarger).pNext;
-      if(pTmp2==pRoadc->pRoadcGreedyCurrentDataEntrySmaller){
-        /* element is deleted, take next one */
-        pTmp2=pTmp;
-      }
-      if(roadcGreedyConcatenate(pRoadc,
-                                pRoadc->pRoadcGreedyCurrentDataEntrySmaller, 
-                                pRoadc->pRoadcGreedyCurrentDataEntryLarger, 
-                                &pNewElem,
-                                calcResult.alignment,
-                                calcResult.alignmentOffset,
-                                pRoadc->roadcGreedyCurrentOverlapSize)){
-        /* malloc error */
-        return 1;
+      if(found==ROADC_GREEDY_OVERLAP_LEFT){
+        roadcSetGreedyVariables(pRoadc, pNewElem, pNewElem->pNext, 
+                                pRoadc->roadcGreedyCurrentOverlapSize, pTmp2, pTmp);
+      } else {
+        roadcSetGreedyVariables(pRoadc, pNewElem, pNewElem->pNext, 
+                                pRoadc->roadcGreedyCurrentOverlapSize, pTmp, pTmp2);
       }
-      /* the call of roadcGreedyConcatenate() removes two elements and adds a new element
-        The greedy variable are adapted (e.g. pointer pRoadc->pRoadcGreedyCurrentDataEntrySmaller 
-        and pRoadc->pRoadcGreedyCurrentDataEntryLarger */
-      roadcSetGreedyVariables(pRoadc, pNewElem, pNewElem->pNext, 
-                              pRoadc->roadcGreedyCurrentOverlapSize, pTmp, pTmp2);
     } else {
       /* no overlap take next array for overlap check */
       pRoadc->pRoadcGreedyCurrentDataEntrySmaller = (*pRoadc->pRoadcGreedyCurrentDataEntrySmaller).pNext;
@@ -1229,9 +1372,24 @@ tRoadcByte roadcGreedyStep(tRoadcPtr pRoadc){
   }
 }
 
+void roadcIndexDataEntries(tRoadcPtr pRoadc){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 index;
+
+  index = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pCurrent->index = index;
+    index++;
+    pCurrent = pCurrent->pNext;
+  }
+}
+
 tRoadcByte roadcCalculationGreedy(tRoadcPtr pRoadc,
                                   tRoadcUInt32 maxTimeInSeconds){
   tRoadcUInt32 elapsedTime;
+  tRoadcUInt32 level;
+  tRoadcUInt32 maxLevel;
 
   /* next element exists (at least two elements) this has to be ensured before calling this function */
   pRoadc->roadcGreedyCurrentOverlapSize = (*(*pRoadc->pRoadcFirstDataEntry).pNext).size;
@@ -1239,6 +1397,7 @@ tRoadcByte roadcCalculationGreedy(tRoadcPtr pRoadc,
     /* nothing to do */
     return 0;
   }
+  maxLevel = pRoadc->roadcGreedyCurrentOverlapSize-1;
   while(1){
     /* set greedy variables
        before call it is assured that data set is >1
@@ -1255,15 +1414,20 @@ tRoadcByte roadcCalculationGreedy(tRoadcPtr pRoadc,
       return 0;
     } 
     /* calculate for current values */
+    level = pRoadc->roadcGreedyCurrentOverlapSize;
+    roadcProgressLevel(pRoadc, level, maxLevel);
+    roadcTraceBegin("greedy level", level);
     if(roadcGreedyStep(pRoadc)){
       /* malloc error */
+      roadcTraceEnd("greedy level", level);
       return 1;
     }
+    roadcTraceEnd("greedy level", level);
     if(maxTimeInSeconds!=ROADC_NO_TIMEOUT){
       elapsedTime = roadcTimerRead(pRoadc);
       if(elapsedTime>=maxTimeInSeconds){
         pRoadc->roadcStopedByTimeout=1;
-        ROADC_NOTIFICATION_MSG("Greedy stop due to elapsed time: %lu\n", elapsedTime);
+        ROADC_NOTIFICATION_MSG(pRoadc, "Greedy stop due to elapsed time: %lu\n", elapsedTime);
         return 0;
       }
     }
@@ -1276,12 +1440,16 @@ void roadcCalculationMultiple(tRoadcPtr pRoadc,
   tRoadcUInt32 elapsedTime;
   tRoadcByte found, done;
   tRoadcUInt32 foundPos;
+  tRoadcUInt32 removedSize;
   tRoadcDataEntryPtr pLarger; 
   tRoadcDataEntryPtr pSmaller;
   tRoadcDataEntryPtr pTmp;
-  tRoadcBytePtr pTmpPaddingByteMask;
   tRoadcDataEntry calcResult;
 
+  if(roadcDispatchMultiple(pRoadc, maxTimeInSeconds)==0){
+    /* removed by hashes */
+    return;
+  }
   roadcInitDataEntry(&calcResult);
   /* check if any array is already part of an existing array */
   pSmaller = pRoadc->pRoadcLastDataEntry;
@@ -1296,13 +1464,7 @@ void roadcCalculationMultiple(tRoadcPtr pRoadc,
 	  /* remove included array */
 	  found=1;
 	  /* adjust padding byte masks */
-	  pTmpPaddingByteMask=NULL; 
-	  if(pLarger->pPaddingByteMask!=NULL){
-	    pTmpPaddingByteMask=&pLarger->pPaddingByteMask[foundPos];
-	  }
-	  roadcAdaptInPlacePaddingByteMaskForCaseIncluded(pSmaller->pData, pSmaller->pPaddingByteMask, 
-							  &pLarger->pData[foundPos], pTmpPaddingByteMask,
-							  pSmaller->size);
+	  roadcAdaptInPlacePaddingByteMaskForCaseIncluded(pSmaller, pLarger, foundPos);
 	  /* adjust alignment data */
 	  pLarger->alignment = calcResult.alignment;
 	  pLarger->alignmentOffset = calcResult.alignmentOffset;
@@ -1317,7 +1479,9 @@ void roadcCalculationMultiple(tRoadcPtr pRoadc,
     pTmp = pSmaller->pPrevious;
     if(found){
       /* element is deleted */
+      removedSize = pSmaller->size;
       roadcRemoveDataEntry(pRoadc, pSmaller);
+      ROADC_PROGRESS_SAVED(pRoadc, removedSize);
     }
     pSmaller = pTmp;
     pLarger = pSmaller->pPrevious;
@@ -1326,139 +1490,591 @@ void roadcCalculationMultiple(tRoadcPtr pRoadc,
       elapsedTime = roadcTimerRead(pRoadc);
       if(elapsedTime>=maxTimeInSeconds){
 	pRoadc->roadcStopedByTimeout=1;
-	ROADC_NOTIFICATION_MSG("Multiple stop due to elapsed time: %lu\n", elapsedTime);
+	ROADC_NOTIFICATION_MSG(pRoadc, "Multiple stop due to elapsed time: %lu\n", elapsedTime);
 	return;
       }
     }
   }
 }
 
-void roadcCalculation(tRoadcPtr pRoadc,
-                      tRoadcByte compressionLevel,
-                      tRoadcUInt32 maxTimeInSeconds){
-  tRoadcBytePtr pTmp;
-  clock_t startTime, endTime;
-  tRoadcFloat64 elapsedTime;
-  tRoadcFloat64 totalTime;
-  tRoadcDataEntryPtr pCurrent;
-  tRoadcDataEntry calcCurrent;
-  tRoadcDataEntryPtr calcResult;
-  void *pVoid;
+void roadcSetLocalSearch(tRoadcPtr pRoadc,
+                         tRoadcByte timeSharePercent){
+  if (NULL == pRoadc) {
+    return;
+  }
+  if(timeSharePercent>100){
+    timeSharePercent = 100;
+  }
+  pRoadc->roadcLocalSearchTimeShare = timeSharePercent;
+}
 
-  totalTime = 0.0;
+void roadcSetExact(tRoadcPtr pRoadc,
+                   tRoadcByte exactMode){
+  if (NULL == pRoadc) {
+    return;
+  }
+  if(exactMode>ROADC_EXACT_NEVER){
+    exactMode = ROADC_EXACT_AUTO;
+  }
+  pRoadc->roadcExactMode = exactMode;
+}
 
+void roadcSetStrategy(tRoadcPtr pRoadc,
+                      tRoadcByte strategy,
+                      tRoadcUInt32 seed){
   if (NULL == pRoadc) {
     return;
   }
+  if((strategy & (~ROADC_STRATEGY_RIGHT_FIRST))>ROADC_STRATEGY_RANDOM){
+    strategy = (tRoadcByte)(strategy & ROADC_STRATEGY_RIGHT_FIRST);
+  }
+  pRoadc->roadcStrategy = strategy;
+  pRoadc->roadcRandomState = (tRoadcUInt64)seed;
+}
 
-  if(pRoadc->roadcNumberDataEntries==0){
-    /* nothing to do */
+void roadcSetPortfolio(tRoadcPtr pRoadc,
+                       tRoadcUInt32 numberCalculations){
+  if (NULL == pRoadc) {
+    return;
+  }
+  if(numberCalculations==0){
+    numberCalculations = 1;
+  }
+  pRoadc->roadcPortfolioSize = numberCalculations;
+}
+
+void roadcSetShards(tRoadcPtr pRoadc,
+                    tRoadcUInt32 numberShards){
+  if (NULL == pRoadc) {
     return;
   }
+  if(numberShards==0){
+    numberShards = 1;
+  }
+  pRoadc->roadcNumberShards = numberShards;
+}
 
-  if(maxTimeInSeconds!=ROADC_NO_TIMEOUT){
-    roadcTimerStart(pRoadc);
+void roadcSetEngine(tRoadcPtr pRoadc,
+                    tRoadcByte engine){
+  if (NULL == pRoadc) {
+    return;
   }
-  pRoadc->roadcStopedByTimeout=0;
-  ROADC_NOTIFICATION_MSG("number arrays before compaction: %lu\n", pRoadc->roadcNumberDataEntries);
-  if(pRoadc->roadcNumberDataEntries>1){
-    startTime=clock();
-    roadcCalculationMultiple(pRoadc, maxTimeInSeconds);
-    endTime=clock();
-    elapsedTime = (tRoadcFloat64)((tRoadcFloat64)(endTime - startTime) / (tRoadcFloat64)CLOCKS_PER_SEC);
-    totalTime = elapsedTime;
-    ROADC_NOTIFICATION_MSG("remove multiple time (s): %f\n", elapsedTime);
+  if(engine>ROADC_ENGINE_AUTO){
+    engine = ROADC_ENGINE_GREEDY;
+  }
+  pRoadc->roadcEngine = engine;
+}
 
+void roadcSetTargetGap(tRoadcPtr pRoadc,
+                       tRoadcFloat64 gapPercent){
+  if (NULL == pRoadc) {
+    return;
   }
-  ROADC_NOTIFICATION_MSG("number arrays after multiple: %lu\n", pRoadc->roadcNumberDataEntries);
-  if((pRoadc->roadcStopedByTimeout==0)&&compressionLevel&&(pRoadc->roadcNumberDataEntries>1)){
-    startTime=clock();
-    /* nothing to do for only one entry */
-    if(roadcCalculationGreedy(pRoadc, maxTimeInSeconds)){
+  if(gapPercent<0.0){
+    gapPercent = ROADC_NO_TARGET_GAP;
+  }
+  pRoadc->roadcTargetGap = gapPercent;
+}
+
+/* return 1 if the size is within the target gap to the lower bound */
+tRoadcByte roadcTargetGapReached(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 size){
+  if((pRoadc->roadcTargetGap<0.0)||(pRoadc->roadcLowerBound==0)){
+    return 0;
+  }
+  return (tRoadcByte)((tRoadcFloat64)size<=
+                      (tRoadcFloat64)pRoadc->roadcLowerBound*(1.0+pRoadc->roadcTargetGap/100.0));
+}
+
+void roadcSetVerbose(tRoadcPtr pRoadc,
+                     tRoadcByte verbose){
+  if (NULL == pRoadc) {
+    return;
+  }
+  pRoadc->roadcVerbose = verbose;
+}
+
+void roadcSetMaxMemory(tRoadcPtr pRoadc,
+                       tRoadcUInt32 maxMemoryInMegabytes){
+  if (NULL == pRoadc) {
+    return;
+  }
+  pRoadc->roadcMaxMemory = (tRoadcUInt64)maxMemoryInMegabytes*1024*1024;
+}
+
+tRoadcByte roadcGetMemoryError(tRoadcPtr pRoadc){
+  if (NULL == pRoadc) {
+    return 0;
+  }
+  return pRoadc->roadcMemoryError;
+}
+
+void roadcSetLogFunction(tRoadcPtr pRoadc,
+                         tRoadcLogFunction pLogFunction,
+                         void *pUserData){
+  if (NULL == pRoadc) {
+    return;
+  }
+  pRoadc->pRoadcLogFunction = pLogFunction;
+  pRoadc->pRoadcLogUserData = pUserData;
+}
+
+/* copy the data entries of pRoadc into pTo, inserted from the last one to keep
+   the order of equal sized data entries for ROADC_STRATEGY_LARGEST_FIRST,
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcCopyDataEntries(tRoadcPtr pRoadc,
+                                tRoadcPtr pTo){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntryPtr pElem;
+
+  pCurrent = pRoadc->pRoadcLastDataEntry;
+  while(pCurrent!=NULL){
+    pElem = roadcNewRoadcDataEntryByCopy(pCurrent);
+    if(pElem==NULL){
       /* malloc error */
-      return;
+      return 1;
     }
-    endTime=clock();
-    elapsedTime = (tRoadcFloat64)((tRoadcFloat64)(endTime - startTime) / (tRoadcFloat64)CLOCKS_PER_SEC);
-    totalTime += elapsedTime;
-    ROADC_NOTIFICATION_MSG("greedy time (s): %f\n", elapsedTime);
-    ROADC_NOTIFICATION_MSG("number arrays after greedy: %lu\n", pRoadc->roadcNumberDataEntries);
+    roadcInsertDataEntry(pTo, pElem);
+    pCurrent = pCurrent->pPrevious;
   }
-  startTime=clock();
-  pCurrent = pRoadc->pRoadcFirstDataEntry;
-  calcCurrent.size = 0;
-  calcCurrent.alignment = 1;
-  calcCurrent.alignmentOffset = 0;
-  pVoid = malloc(sizeof(tRoadcDataEntry)); 
-  ROADC_ALLOC_FAILED_WITHOUT_RETURN_VALUE(pVoid);
-  calcResult = (tRoadcDataEntryPtr)pVoid;
-  roadcInitDataEntry(calcResult);
+  return 0;
+}
+
+/* move all data entries of pFrom to pRoadc, the data entries of pRoadc are deleted */
+void roadcReplaceDataEntries(tRoadcPtr pRoadc,
+                             tRoadcPtr pFrom){
+  roadcDeleteEntries(pRoadc);
+  pRoadc->pRoadcFirstDataEntry = pFrom->pRoadcFirstDataEntry;
+  pRoadc->pRoadcLastDataEntry = pFrom->pRoadcLastDataEntry;
+  pRoadc->roadcNumberDataEntries = pFrom->roadcNumberDataEntries;
+  pFrom->pRoadcFirstDataEntry = NULL;
+  pFrom->pRoadcLastDataEntry = NULL;
+  pFrom->roadcNumberDataEntries = 0;
+}
 
+tRoadcUInt32 roadcConcatenationSize(tRoadcDataEntryPtr pFirst){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntry calcCurrent;
+  tRoadcDataEntry calcResult;
+
+  roadcInitDataEntry(&calcCurrent);
+  roadcInitDataEntry(&calcResult);
+  pCurrent = pFirst;
   while(pCurrent!=NULL){
-    roadcAlignmentConcatenationCalculation(0, &calcCurrent, pCurrent, calcResult);
-    calcCurrent.size = calcResult->size;
-    calcCurrent.alignment = calcResult->alignment;
-    calcCurrent.alignmentOffset = calcResult->alignmentOffset;
+    roadcAlignmentConcatenationCalculation(0, &calcCurrent, pCurrent, &calcResult);
+    calcCurrent.size = calcResult.size;
+    calcCurrent.alignment = calcResult.alignment;
+    calcCurrent.alignmentOffset = calcResult.alignmentOffset;
     pCurrent = pCurrent->pNext;
   }
+  return calcCurrent.size;
+}
 
-  pTmp=roadcMallocUnsignedCharArrayAndFill(calcCurrent.size, 0);
-  if(pTmp==NULL){
-    /* alloc failed */
-    free(calcResult);
-    return;
+/* memory of the data entries in bytes including the padding byte mask blocks */
+tRoadcUInt64 roadcDataEntriesMemory(tRoadcPtr pRoadc){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt64 memory;
+  tRoadcUInt32 numberBlocks;
+  tRoadcUInt32 i;
+
+  memory = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    memory += sizeof(tRoadcDataEntry) + pCurrent->size;
+    if(pCurrent->ppPaddingByteMaskBlocks!=NULL){
+      numberBlocks = ROADC_PADDING_BLOCK_NUMBER(pCurrent->size);
+      memory += numberBlocks*sizeof(tRoadcBytePtr);
+      for(i=0;i<numberBlocks;i++){
+        if(pCurrent->ppPaddingByteMaskBlocks[i]!=NULL){
+          memory += ROADC_PADDING_BLOCK_SIZE;
+        }
+      }
+    }
+    pCurrent = pCurrent->pNext;
   }
-  calcCurrent.pData = pTmp;
-  pTmp=roadcMallocUnsignedCharArrayAndFill(calcCurrent.size, ROADC_NO_PADDING_BITS);
-  if(pTmp==NULL){
-    /* alloc failed */
-    free(calcResult);
-    free(calcCurrent.pData);
-    return;
+  return memory;
+}
+
+/* check if memory bytes in addition to the data entries fit into the memory budget,
+   the calculation step pUsage is skipped if not
+   return: 1: fits or no memory budget, 0: does not fit */
+tRoadcByte roadcMemoryAvailable(tRoadcPtr pRoadc,
+                                tRoadcUInt64 memory,
+                                const char *pUsage){
+  tRoadcUInt64 dataMemory;
+
+  if(pRoadc->roadcMaxMemory==0){
+    return 1;
   }
-  calcCurrent.pPaddingByteMask = pTmp;
-  pTmp=roadcMallocUnsignedCharArrayAndFill(calcCurrent.size, 0);
-  if(pTmp==NULL){
-    /* alloc failed */
-    free(calcResult);
-    free(calcCurrent.pData);
-    free(calcCurrent.pPaddingByteMask);
-    return;
+  dataMemory = roadcDataEntriesMemory(pRoadc);
+  if(dataMemory+memory<=pRoadc->roadcMaxMemory){
+    return 1;
   }
-  calcResult->pData = pTmp;
-  pTmp=roadcMallocUnsignedCharArrayAndFill(calcCurrent.size, ROADC_NO_PADDING_BITS);
-  if(pTmp==NULL){
-    /* alloc failed */
-    free(calcCurrent.pData);
-    free(calcCurrent.pPaddingByteMask);
-    free(calcResult->pData);
-    free(calcResult);
-    return;
+  ROADC_NOTIFICATION_MSG(pRoadc, "memory budget: %s skipped (%llu bytes for arrays, %llu bytes needed, budget %llu bytes)\n",
+                         pUsage, dataMemory, memory, pRoadc->roadcMaxMemory);
+  return 0;
+}
+
+/* concatenate the data entries in their order into one data entry, the positions are 
+   calculated from the sizes and alignments before and every data entry is copied once
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcConcatenation(tRoadcPtr pRoadc){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntryPtr pNext;
+  tRoadcDataEntryPtr pResult;
+  tRoadcDataEntry calcCurrent;
+  tRoadcDataEntry calcResult;
+  tRoadcUInt64 *pPositions;
+  tRoadcUInt32 *pPaddingBefore;
+  tRoadcUInt64 shift;
+  tRoadcUInt32 first;
+  tRoadcUInt32 position;
+  tRoadcUInt32 i, j;
+  tRoadcByte freeEntries;
+
+  pPositions = (tRoadcUInt64 *)malloc(pRoadc->roadcNumberDataEntries*sizeof(tRoadcUInt64));
+  pPaddingBefore = (tRoadcUInt32 *)malloc(pRoadc->roadcNumberDataEntries*sizeof(tRoadcUInt32));
+  pResult = (tRoadcDataEntryPtr)malloc(sizeof(tRoadcDataEntry));
+  if((pPositions==NULL)||(pPaddingBefore==NULL)||(pResult==NULL)){
+    free(pPositions);
+    free(pPaddingBefore);
+    free(pResult);
+    return 1;
   }
-  calcResult->pPaddingByteMask = pTmp;
+  ROADC_STATISTICS_ALLOCATION(sizeof(tRoadcDataEntry));
+  roadcInitDataEntry(pResult);
+  roadcInitDataEntry(&calcCurrent);
+  roadcInitDataEntry(&calcResult);
 
-  /* concatenate result data */
-  calcCurrent.size = 0;
-  calcCurrent.alignment = 1;
-  calcCurrent.alignmentOffset = 0;
+  /* positions minus shift, putting an array in front of the concatenated arrays 
+     increases the shift; the bytes before an array up to the previous array are
+     alignment offset and fill bytes, i.e. padding bytes */
+  shift = 0;
+  first = 0;
+  i = 0;
   pCurrent = pRoadc->pRoadcFirstDataEntry;
   while(pCurrent!=NULL){
-    roadcAlignmentConcatenationCalculation(1, &calcCurrent, pCurrent, calcResult);
-    roadcCopyDataEntry(calcResult, &calcCurrent);
+    roadcAlignmentConcatenationCalculation(0, &calcCurrent, pCurrent, &calcResult);
+    if(roadcAlignmentConcatenationLeftFirst(&calcCurrent, pCurrent)){
+      pPositions[i] = (tRoadcUInt64)(calcResult.size-pCurrent->size) - shift;
+      pPaddingBefore[i] = calcResult.size-calcCurrent.size-pCurrent->size;
+    } else {
+      if(i>0){
+        pPaddingBefore[first] += calcResult.size-calcCurrent.size-pCurrent->alignmentOffset-pCurrent->size;
+      }
+      shift += calcResult.size-calcCurrent.size;
+      pPositions[i] = (tRoadcUInt64)pCurrent->alignmentOffset - shift;
+      pPaddingBefore[i] = pCurrent->alignmentOffset;
+      first = i;
+    }
+    calcCurrent.size = calcResult.size;
+    calcCurrent.alignment = calcResult.alignment;
+    calcCurrent.alignmentOffset = calcResult.alignmentOffset;
+    i++;
     pCurrent = pCurrent->pNext;
   }
 
-  free(calcCurrent.pData);
-  free(calcCurrent.pPaddingByteMask);
+  pResult->pData = roadcMallocUnsignedCharArrayAndFill(calcCurrent.size, 0);
+  if(pResult->pData==NULL){
+    free(pPositions);
+    free(pPaddingBefore);
+    free(pResult);
+    return 1;
+  }
+  pResult->size = calcCurrent.size;
+  pResult->alignment = calcCurrent.alignment;
+  /* under memory pressure every array is freed after its copy */
+  freeEntries = (tRoadcByte)!roadcMemoryAvailable(pRoadc, (tRoadcUInt64)calcCurrent.size, 
+                                                  "keeping the arrays while concatenating");
+
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pNext = pCurrent->pNext;
+    position = (tRoadcUInt32)(pPositions[i]+shift);
+    for(j=position-pPaddingBefore[i];j<position;j++){
+      if(roadcPaddingByteMaskSet(pResult, j, ROADC_ALL_PADDING_BITS)){
+        break;
+      }
+    }
+    memcpy(&pResult->pData[position], pCurrent->pData, pCurrent->size);
+    if((j<position)||
+       roadcCopyPaddingByteMask(pCurrent, 0, pResult, position, pCurrent->size)){
+      /* malloc error */
+      free(pPositions);
+      free(pPaddingBefore);
+      roadcFreeRoadcDataEntry(pResult);
+      return 1;
+    }
+    if(freeEntries){
+      roadcRemoveDataEntry(pRoadc, pCurrent);
+    }
+    i++;
+    pCurrent = pNext;
+  }
+  free(pPositions);
+  free(pPaddingBefore);
+
   roadcDeleteEntries(pRoadc);
-  pRoadc->roadcCurrentInputSize=calcResult->size;
-  roadcInsertDataEntry(pRoadc, calcResult);
+  pRoadc->roadcCurrentInputSize=pResult->size;
+  roadcInsertDataEntry(pRoadc, pResult);
+  return 0;
+}
 
-  endTime=clock();
-  elapsedTime = (tRoadcFloat64)((tRoadcFloat64)(endTime - startTime) / (tRoadcFloat64)CLOCKS_PER_SEC);
+/* order of the arrays by exact calculation, greedy, and local search, 
+   the arrays are concatenated in this order afterwards */
+tRoadcByte roadcCalculationOrder(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds){
+  tRoadcFloat64 startTime;
+  tRoadcFloat64 elapsedTime;
+  tRoadc exactResult;
+  tRoadcUInt32 exactSize;
+  tRoadc cycleCoverResult;
+  tRoadcUInt32 cycleCoverSize;
+  tRoadcByte engineDone;
+  tRoadcByte engine;
+
+  engine = pRoadc->roadcEngine;
+  if(engine==ROADC_ENGINE_AUTO){
+    engine = roadcDispatchEngine(pRoadc);
+  }
+  roadcInitialize(&exactResult);
+  roadcInitialize(&cycleCoverResult);
+  if(roadcExactIsSelected(pRoadc)){
+    startTime=roadcTimerNow();
+    roadcTraceBegin("exact", pRoadc->roadcNumberDataEntries);
+    if(roadcExactCalculation(pRoadc, maxTimeInSeconds, &exactResult)){
+      /* malloc error or timeout: greedy result only */
+      roadcDeleteEntries(&exactResult);
+    }
+    roadcTraceEnd("exact", pRoadc->roadcNumberDataEntries);
+    elapsedTime = roadcTimerNow() - startTime;
+    ROADC_NOTIFICATION_MSG(pRoadc, "exact time (s): %f\n", elapsedTime);
+  }
+  /* the greedy calculation is not needed if the engine merged all arrays */
+  engineDone = 0;
+  if(engine==ROADC_ENGINE_SUFFIX){
+    startTime=roadcTimerNow();
+    roadcTraceBegin("suffix greedy", pRoadc->roadcNumberDataEntries);
+    engineDone = (tRoadcByte)(!roadcSuffixGreedyCalculation(pRoadc, maxTimeInSeconds));
+    roadcTraceEnd("suffix greedy", pRoadc->roadcNumberDataEntries);
+    elapsedTime = roadcTimerNow() - startTime;
+    ROADC_NOTIFICATION_MSG(pRoadc, "suffix greedy time (s): %f\n", elapsedTime);
+    ROADC_NOTIFICATION_MSG(pRoadc, "number arrays after suffix greedy: %lu\n", pRoadc->roadcNumberDataEntries);
+  } else if(engine==ROADC_ENGINE_CYCLE_COVER){
+    startTime=roadcTimerNow();
+    /* greedy calculation if the cycle cover is not possible */
+    roadcTraceBegin("cycle cover", pRoadc->roadcNumberDataEntries);
+    engineDone = (tRoadcByte)(!roadcCycleCoverCalculation(pRoadc, maxTimeInSeconds));
+    roadcTraceEnd("cycle cover", pRoadc->roadcNumberDataEntries);
+    elapsedTime = roadcTimerNow() - startTime;
+    ROADC_NOTIFICATION_MSG(pRoadc, "cycle cover time (s): %f\n", elapsedTime);
+  } else if(engine==ROADC_ENGINE_BEST){
+    startTime=roadcTimerNow();
+    /* the greedy calculation changes the data entries, calculate on a copy */
+    cycleCoverResult.roadcStartTime = pRoadc->roadcStartTime;
+    cycleCoverResult.roadcVerbose = pRoadc->roadcVerbose;
+    cycleCoverResult.pRoadcLogFunction = pRoadc->pRoadcLogFunction;
+    cycleCoverResult.pRoadcLogUserData = pRoadc->pRoadcLogUserData;
+    roadcTraceBegin("cycle cover", pRoadc->roadcNumberDataEntries);
+    if((!roadcMemoryAvailable(pRoadc, roadcDataEntriesMemory(pRoadc)+roadcCycleCoverMemory(pRoadc), "cycle cover")) ||
+       roadcCopyDataEntries(pRoadc, &cycleCoverResult) ||
+       roadcCycleCoverCalculation(&cycleCoverResult, maxTimeInSeconds)){
+      /* malloc error or too many arrays: greedy result only */
+      roadcDeleteEntries(&cycleCoverResult);
+    }
+    roadcTraceEnd("cycle cover", cycleCoverResult.roadcNumberDataEntries);
+    pRoadc->roadcStopedByTimeout |= cycleCoverResult.roadcStopedByTimeout;
+    elapsedTime = roadcTimerNow() - startTime;
+    ROADC_NOTIFICATION_MSG(pRoadc, "cycle cover time (s): %f\n", elapsedTime);
+  }
+  if(!engineDone){
+    startTime=roadcTimerNow();
+    /* nothing to do for only one entry */
+    roadcIndexDataEntries(pRoadc);
+    roadcOverlapMemoNew(pRoadc);
+    roadcLocalSearchNew(pRoadc);
+    roadcTraceBegin("greedy", pRoadc->roadcNumberDataEntries);
+    if(roadcCalculationGreedy(pRoadc, maxTimeInSeconds)){
+      /* malloc error */
+      roadcTraceEnd("greedy", pRoadc->roadcNumberDataEntries);
+      roadcOverlapMemoDelete(pRoadc);
+      roadcLocalSearchDelete(pRoadc);
+      roadcDeleteEntries(&exactResult);
+      roadcDeleteEntries(&cycleCoverResult);
+      return 1;
+    }
+    roadcTraceEnd("greedy", pRoadc->roadcNumberDataEntries);
+    roadcOverlapMemoDelete(pRoadc);
+    elapsedTime = roadcTimerNow() - startTime;
+    ROADC_NOTIFICATION_MSG(pRoadc, "greedy time (s): %f\n", elapsedTime);
+    ROADC_NOTIFICATION_MSG(pRoadc, "number arrays after greedy: %lu\n", pRoadc->roadcNumberDataEntries);
+    if((pRoadc->pRoadcLocalSearch!=NULL)&&
+       roadcTargetGapReached(pRoadc, roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry))){
+      ROADC_NOTIFICATION_MSG(pRoadc, "local search skipped: target gap reached\n");
+      roadcLocalSearchDelete(pRoadc);
+    }
+    if(pRoadc->pRoadcLocalSearch!=NULL){
+      startTime=roadcTimerNow();
+      roadcTraceBegin("local search", pRoadc->roadcNumberDataEntries);
+      roadcLocalSearchCalculation(pRoadc, maxTimeInSeconds);
+      roadcTraceEnd("local search", pRoadc->roadcNumberDataEntries);
+      roadcLocalSearchDelete(pRoadc);
+      elapsedTime = roadcTimerNow() - startTime;
+      ROADC_NOTIFICATION_MSG(pRoadc, "local search time (s): %f\n", elapsedTime);
+    }
+  }
+  if(cycleCoverResult.roadcNumberDataEntries>0){
+    cycleCoverSize = roadcConcatenationSize(cycleCoverResult.pRoadcFirstDataEntry);
+    ROADC_NOTIFICATION_MSG(pRoadc, "size cycle cover: %lu, greedy: %lu\n", cycleCoverSize, 
+                           roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry));
+    if(cycleCoverSize<roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry)){
+      roadcReplaceDataEntries(pRoadc, &cycleCoverResult);
+    } else {
+      roadcDeleteEntries(&cycleCoverResult);
+    }
+  }
+  if(exactResult.roadcNumberDataEntries>0){
+    exactSize = roadcConcatenationSize(exactResult.pRoadcFirstDataEntry);
+    ROADC_NOTIFICATION_MSG(pRoadc, "size exact: %lu, greedy: %lu\n", exactSize, 
+                           roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry));
+    if(exactSize<=roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry)){
+      roadcReplaceDataEntries(pRoadc, &exactResult);
+    } else {
+      roadcDeleteEntries(&exactResult);
+    }
+  }
+  return 0;
+}
+
+void roadcCalculation(tRoadcPtr pRoadc,
+                      tRoadcByte compressionLevel,
+                      tRoadcUInt32 maxTimeInSeconds){
+  tRoadcFloat64 startTime;
+  tRoadcFloat64 startCpuTime;
+  tRoadcFloat64 elapsedTime;
+  tRoadcFloat64 totalTime;
+  tRoadcUInt32 size;
+  tRoadcStatisticsPtr pPreviousStatistics;
+
+  totalTime = 0.0;
+
+  if (NULL == pRoadc) {
+    return;
+  }
+
+  if(pRoadc->roadcNumberDataEntries==0){
+    /* nothing to do */
+    return;
+  }
+
+  /* the timer is also read by the threads of the portfolio */
+  roadcTimerStart(pRoadc);
+  pPreviousStatistics = roadcStatisticsStart(pRoadc);
+  roadcProgressStart(pRoadc);
+  pRoadc->roadcStopedByTimeout=0;
+  pRoadc->roadcLowerBound=0;
+  pRoadc->roadcOrderError=0;
+  ROADC_NOTIFICATION_MSG(pRoadc, "number arrays before compaction: %lu\n", pRoadc->roadcNumberDataEntries);
+  /* the order refers to the arrays after removing multiple arrays of all arrays */
+  if(compressionLevel&&(pRoadc->roadcNumberShards>1)&&(pRoadc->pRoadcOrder==NULL)&&
+     (pRoadc->roadcNumberDataEntries>pRoadc->roadcNumberShards)){
+    startTime=roadcTimerNow();
+    startCpuTime=roadcTimerCpuNow();
+    /* on malloc error without shards */
+    roadcProgressPhase(pRoadc, ROADC_PHASE_SHARDS);
+    roadcTraceBegin("shards", pRoadc->roadcNumberShards);
+    roadcShardCalculation(pRoadc, maxTimeInSeconds);
+    roadcTraceEnd("shards", pRoadc->roadcNumberShards);
+    elapsedTime = roadcTimerNow() - startTime;
+    totalTime = elapsedTime;
+    roadcStatisticsPhase(&pRoadc->roadcStatistics, ROADC_PHASE_SHARDS, elapsedTime, roadcTimerCpuNow()-startCpuTime);
+    ROADC_NOTIFICATION_MSG(pRoadc, "shard time (s): %f\n", elapsedTime);
+    ROADC_NOTIFICATION_MSG(pRoadc, "number arrays after shards: %lu\n", pRoadc->roadcNumberDataEntries);
+  }
+  if((pRoadc->roadcStopedByTimeout==0)&&(pRoadc->roadcNumberDataEntries>1)){
+    startTime=roadcTimerNow();
+    startCpuTime=roadcTimerCpuNow();
+    roadcProgressPhase(pRoadc, ROADC_PHASE_MULTIPLE);
+    roadcTraceBegin("multiple", pRoadc->roadcNumberDataEntries);
+    roadcCalculationMultiple(pRoadc, maxTimeInSeconds);
+    roadcTraceEnd("multiple", pRoadc->roadcNumberDataEntries);
+    elapsedTime = roadcTimerNow() - startTime;
+    totalTime += elapsedTime;
+    roadcStatisticsPhase(&pRoadc->roadcStatistics, ROADC_PHASE_MULTIPLE, elapsedTime, roadcTimerCpuNow()-startCpuTime);
+    ROADC_NOTIFICATION_MSG(pRoadc, "remove multiple time (s): %f\n", elapsedTime);
+
+  }
+  ROADC_NOTIFICATION_MSG(pRoadc, "number arrays after multiple: %lu\n", pRoadc->roadcNumberDataEntries);
+  if((pRoadc->roadcStopedByTimeout==0)&&compressionLevel&&(pRoadc->roadcNumberDataEntries>1)){
+    if(pRoadc->roadcVerbose || (pRoadc->roadcTargetGap>=0.0)){
+      startTime=roadcTimerNow();
+      startCpuTime=roadcTimerCpuNow();
+      roadcProgressPhase(pRoadc, ROADC_PHASE_LOWER_BOUND);
+      roadcTraceBegin("lower bound", pRoadc->roadcNumberDataEntries);
+      pRoadc->roadcLowerBound = roadcLowerBound(pRoadc, maxTimeInSeconds);
+      roadcTraceEnd("lower bound", pRoadc->roadcLowerBound);
+      elapsedTime = roadcTimerNow() - startTime;
+      totalTime += elapsedTime;
+      roadcStatisticsPhase(&pRoadc->roadcStatistics, ROADC_PHASE_LOWER_BOUND, elapsedTime, roadcTimerCpuNow()-startCpuTime);
+      ROADC_NOTIFICATION_MSG(pRoadc, "lower bound time (s): %f\n", elapsedTime);
+    }
+    if((pRoadc->pRoadcOrder!=NULL)&&(!roadcOverlapGraphOrderIsValid(pRoadc))){
+      pRoadc->roadcOrderError=1;
+    }
+    startTime=roadcTimerNow();
+    startCpuTime=roadcTimerCpuNow();
+    /* on malloc error the arrays merged so far are concatenated, this is still a valid result */
+    roadcProgressPhase(pRoadc, ROADC_PHASE_ORDER);
+    roadcTraceBegin("order", pRoadc->roadcNumberDataEntries);
+    if((pRoadc->pRoadcOrder!=NULL)&&(!pRoadc->roadcOrderError)){
+      if(roadcOverlapGraphOrderCalculation(pRoadc)){
+        ROADC_ERROR_MSG(pRoadc, "WARNING: not enough memory to merge the arrays in the given order, the arrays are concatenated.\n");
+      }
+    } else if(pRoadc->roadcPortfolioSize>1){
+      if(roadcPortfolioCalculation(pRoadc, maxTimeInSeconds)){
+        ROADC_ERROR_MSG(pRoadc, "WARNING: not enough memory for the portfolio calculation, the arrays are concatenated.\n");
+      }
+    } else if(roadcCalculationOrder(pRoadc, maxTimeInSeconds)){
+      ROADC_ERROR_MSG(pRoadc, "WARNING: not enough memory for the calculation, the arrays merged so far are concatenated.\n");
+    }
+    roadcTraceEnd("order", pRoadc->roadcNumberDataEntries);
+    elapsedTime = roadcTimerNow() - startTime;
+    totalTime += elapsedTime;
+    roadcStatisticsPhase(&pRoadc->roadcStatistics, ROADC_PHASE_ORDER, elapsedTime, roadcTimerCpuNow()-startCpuTime);
+    if(pRoadc->roadcLowerBound>0){
+      size = roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry);
+      ROADC_NOTIFICATION_MSG(pRoadc, "size: %lu, lower bound: %lu, gap (%%): %f\n", size, pRoadc->roadcLowerBound,
+                             100.0*((tRoadcFloat64)size-(tRoadcFloat64)pRoadc->roadcLowerBound)/
+                             (tRoadcFloat64)pRoadc->roadcLowerBound);
+    }
+  }
+  startTime=roadcTimerNow();
+  startCpuTime=roadcTimerCpuNow();
+  roadcProgressPhase(pRoadc, ROADC_PHASE_CONCATENATION);
+  roadcTraceBegin("concatenation", pRoadc->roadcNumberDataEntries);
+  if(roadcConcatenation(pRoadc)){
+    /* no valid result: the arrays are not concatenated, some may be freed already */
+    roadcTraceEnd("concatenation", 0);
+    roadcDeleteEntries(pRoadc);
+    roadcStatisticsStop(pPreviousStatistics);
+    roadcProgressPhase(pRoadc, ROADC_PHASE_NONE);
+    pRoadc->roadcMemoryError=1;
+    ROADC_ERROR_MSG(pRoadc, "ERROR: not enough memory to concatenate the arrays, no compacted data.\n");
+    return;
+  }
+  if(pRoadc->pRoadcFirstDataEntry->alignment>=ROADC_MAX_INPUT_SIZE){
+    ROADC_ERROR_MSG(pRoadc, "ERROR: the alignment values of the input arrays caused an overflow in alignment calculation. The result of roadC is NOT valid anymore!\n");
+  }
+  roadcTraceEnd("concatenation", roadcGetCompactedDataSize(pRoadc));
+
+  elapsedTime = roadcTimerNow() - startTime;
   totalTime += elapsedTime;
-  ROADC_NOTIFICATION_MSG("concatenation time (s): %f\n", elapsedTime);
-  ROADC_NOTIFICATION_MSG("Total time (s): %f\n", totalTime);
+  roadcStatisticsPhase(&pRoadc->roadcStatistics, ROADC_PHASE_CONCATENATION, elapsedTime, roadcTimerCpuNow()-startCpuTime);
+  roadcStatisticsStop(pPreviousStatistics);
+  roadcProgressPhase(pRoadc, ROADC_PHASE_NONE);
+  ROADC_NOTIFICATION_MSG(pRoadc, "concatenation time (s): %f\n", elapsedTime);
+  ROADC_NOTIFICATION_MSG(pRoadc, "Total time (s): %f\n", totalTime);
 }  
 
 tRoadcBytePtr roadcGetCompactedData(tRoadcPtr pRoadc){
@@ -1470,11 +2086,25 @@ tRoadcBytePtr roadcGetCompactedData(tRoadcPtr pRoadc){
 }
 
 tRoadcBytePtr roadcGetCompactedDataPaddingByteMask(tRoadcPtr pRoadc){
+  tRoadcBytePtr pTmp;
+  tRoadcUInt32 i;
   if((pRoadc==(tRoadcPtr)NULL) ||
      (pRoadc->pRoadcFirstDataEntry==NULL)){
     return (tRoadcBytePtr)NULL;
   }
-  return pRoadc->pRoadcFirstDataEntry->pPaddingByteMask;
+  if(pRoadc->pRoadcCompactedDataPaddingByteMask==NULL){
+    /* build plain padding byte mask array from block representation */
+    pTmp = roadcMallocUnsignedCharArray(pRoadc->pRoadcFirstDataEntry->size);
+    if(pTmp==NULL){
+      ROADC_ERROR_MSG(pRoadc, "ERROR: not enough memory for the padding byte mask of the compacted data.\n");
+      return (tRoadcBytePtr)NULL;
+    }
+    for(i=0;i<pRoadc->pRoadcFirstDataEntry->size;i++){
+      pTmp[i] = roadcPaddingByteMaskGet(pRoadc->pRoadcFirstDataEntry, i);
+    }
+    pRoadc->pRoadcCompactedDataPaddingByteMask = pTmp;
+  }
+  return pRoadc->pRoadcCompactedDataPaddingByteMask;
 }
 
 tRoadcUInt32 roadcGetCompactedDataSize(tRoadcPtr pRoadc){
@@ -1500,6 +2130,7 @@ tRoadcUInt32 roadcGetPositionInCompactedData(tRoadcPtr pRoadc,
                                              tRoadcUInt32 alignment){
   tRoadcDataEntry thisArray;
   tRoadcDataEntry inThisArray;
+  tRoadcUInt32 position;
   if((pRoadc==(tRoadcPtr)NULL) ||
      (pRoadc->pRoadcFirstDataEntry==(tRoadcDataEntryPtr)NULL) ||
      (pData==(tRoadcBytePtr)NULL)){
@@ -1507,15 +2138,23 @@ tRoadcUInt32 roadcGetPositionInCompactedData(tRoadcPtr pRoadc,
   }
   thisArray.size = size;
   thisArray.pData = pData;
-  thisArray.pPaddingByteMask = pPaddingByteMask;
+  thisArray.ppPaddingByteMaskBlocks = NULL;
   thisArray.alignment = alignment;
   thisArray.alignmentOffset = 0;
+  if(pPaddingByteMask!=NULL){
+    if(roadcNewPaddingByteMask(&thisArray, pPaddingByteMask)){
+      /* malloc failed */
+      return ROADC_MAX_INPUT_SIZE;
+    }
+  }
   inThisArray.size = roadcGetCompactedDataSize(pRoadc);
   inThisArray.pData = roadcGetCompactedData(pRoadc);
   /* resulting padding byte mask must not be used since this would produce wrong matches */
-  inThisArray.pPaddingByteMask = NULL;
+  inThisArray.ppPaddingByteMaskBlocks = NULL;
   inThisArray.alignment = roadcGetCompactedDataAlignment(pRoadc);
   inThisArray.alignmentOffset = 0;
-  return roadcArrayGetPosition(&thisArray, &inThisArray);
+  position = roadcArrayGetPosition(&thisArray, &inThisArray);
+  roadcFreePaddingByteMask(&thisArray);
+  return position;
 }
 
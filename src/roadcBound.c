@@ -0,0 +1,213 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcBound.c
+ *  @brief Lower bound of the compacted data size.
+ *
+ *  After removing multiple arrays no array is included in another one, so
+ *  for any order of the n arrays the compacted data size is
+ *
+ *    sum of all array sizes - sum of the overlaps of the n-1 neighbours
+ *
+ *  plus the gaps needed for the alignment. The overlap of a neighbour pair
+ *  (i, j) is at most the largest overlap of any array followed by j (in(j))
+ *  and at most the largest overlap of i followed by any array (out(i)). 
+ *  Every array but the first one has a predecessor, every array but the last
+ *  one has a successor, so the sum of overlaps is at most
+ *
+ *    min(sum in(j) - min in(j), sum out(i) - min out(i))
+ *
+ *  This is a relaxation of the assignment (cycle cover) bound. It needs at
+ *  most n^2 overlap calculations, pairs which can not increase in(j) or
+ *  out(i) due to their sizes are skipped. For more than 
+ *  ROADC_BOUND_MAX_ENTRIES arrays the overlaps are only bounded by the 
+ *  array sizes.
+ */
+
+#include "roadcInternal.h"
+
+/* maximal number of arrays for the bound from the overlaps of all pairs */
+#ifndef ROADC_BOUND_MAX_ENTRIES
+#define ROADC_BOUND_MAX_ENTRIES 1024
+#endif /* ROADC_BOUND_MAX_ENTRIES */
+
+/* largest overlaps to and from every array, 
+   return: 0: ok, 1: malloc error or timeout */
+tRoadcByte roadcBoundOverlaps(tRoadcPtr pRoadc,
+                              tRoadcUInt32 maxTimeInSeconds,
+                              tRoadcUInt32 *pMaxIn,
+                              tRoadcUInt32 *pMaxOut){
+  tRoadcUInt32 numberEntries;
+  tRoadcDataEntryPtrPtr ppEntries;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntry calcResult;
+  tRoadcUInt32 i, j;
+  tRoadcUInt32 maxLength;
+  tRoadcUInt32 overlap;
+  tRoadcByte mallocError;
+  tRoadcByte result;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  if(ppEntries==NULL){
+    return 1;
+  }
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    ppEntries[i] = pCurrent;
+    pMaxIn[i] = 0;
+    pMaxOut[i] = 0;
+    i++;
+    pCurrent = pCurrent->pNext;
+  }
+  roadcInitDataEntry(&calcResult);
+  mallocError = 0;
+  result = 0;
+  for(i=0;(i<numberEntries)&&(result==0);i++){
+    for(j=0;(j<numberEntries)&&(result==0);j++){
+      /* same limit as in the greedy, included arrays are already removed */
+      maxLength = ppEntries[i]->size;
+      if(ppEntries[j]->size<maxLength){
+        maxLength = ppEntries[j]->size;
+      }
+      maxLength--;
+      /* the overlap of the pair can not increase any of both largest overlaps */
+      if((j==i)||((maxLength<=pMaxOut[i])&&(maxLength<=pMaxIn[j]))){
+        continue;
+      }
+      overlap = roadcOverlapLargest(ppEntries[i], ppEntries[j], maxLength, &calcResult, &mallocError);
+      result = mallocError;
+      if(overlap>pMaxOut[i]){
+        pMaxOut[i] = overlap;
+      }
+      if(overlap>pMaxIn[j]){
+        pMaxIn[j] = overlap;
+      }
+    }
+    if((maxTimeInSeconds!=ROADC_NO_TIMEOUT)&&
+       (roadcTimerRead(pRoadc)>=maxTimeInSeconds)){
+      result = 1;
+    }
+  }
+  free(ppEntries);
+  return result;
+}
+
+/* largest overlaps bounded by the array sizes only */
+void roadcBoundOverlapsBySize(tRoadcPtr pRoadc,
+                              tRoadcUInt32 *pMaxIn,
+                              tRoadcUInt32 *pMaxOut){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 largest, secondLargest, other;
+  tRoadcUInt32 i;
+
+  /* the list is sorted by size */
+  largest = pRoadc->pRoadcFirstDataEntry->size;
+  secondLargest = pRoadc->pRoadcFirstDataEntry->pNext->size;
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    other = largest;
+    if(i==0){
+      other = secondLargest;
+    }
+    if(pCurrent->size<other){
+      other = pCurrent->size;
+    }
+    /* included arrays are already removed */
+    pMaxIn[i] = other-1;
+    pMaxOut[i] = other-1;
+    i++;
+    pCurrent = pCurrent->pNext;
+  }
+}
+
+/* sum of the largest overlaps without the smallest one */
+tRoadcUInt32 roadcBoundSumOverlaps(tRoadcUInt32 *pMaxOverlaps,
+                                   tRoadcUInt32 numberEntries){
+  tRoadcUInt32 sum, smallest;
+  tRoadcUInt32 i;
+
+  sum = 0;
+  smallest = pMaxOverlaps[0];
+  for(i=0;i<numberEntries;i++){
+    sum += pMaxOverlaps[i];
+    if(pMaxOverlaps[i]<smallest){
+      smallest = pMaxOverlaps[i];
+    }
+  }
+  return sum-smallest;
+}
+
+tRoadcUInt32 roadcLowerBound(tRoadcPtr pRoadc,
+                             tRoadcUInt32 maxTimeInSeconds){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 *pMaxIn;
+  tRoadcUInt32 *pMaxOut;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 sumSizes;
+  tRoadcUInt32 sumOverlaps;
+  tRoadcUInt32 sumOverlapsOut;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  if(numberEntries==0){
+    return 0;
+  }
+  sumSizes = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    sumSizes += pCurrent->size;
+    pCurrent = pCurrent->pNext;
+  }
+  if(numberEntries==1){
+    return sumSizes;
+  }
+  pMaxIn = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pMaxOut = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  if((pMaxIn==NULL)||(pMaxOut==NULL)){
+    /* malloc error: no bound */
+    free(pMaxIn);
+    free(pMaxOut);
+    return 0;
+  }
+  if((numberEntries>ROADC_BOUND_MAX_ENTRIES)||
+     roadcBoundOverlaps(pRoadc, maxTimeInSeconds, pMaxIn, pMaxOut)){
+    roadcBoundOverlapsBySize(pRoadc, pMaxIn, pMaxOut);
+  }
+  sumOverlaps = roadcBoundSumOverlaps(pMaxIn, numberEntries);
+  sumOverlapsOut = roadcBoundSumOverlaps(pMaxOut, numberEntries);
+  if(sumOverlapsOut<sumOverlaps){
+    sumOverlaps = sumOverlapsOut;
+  }
+  free(pMaxIn);
+  free(pMaxOut);
+  /* the largest array is always part of the compacted data */
+  if(sumSizes-sumOverlaps<pRoadc->pRoadcFirstDataEntry->size){
+    return pRoadc->pRoadcFirstDataEntry->size;
+  }
+  return sumSizes-sumOverlaps;
+}
@@ -0,0 +1,403 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcCycleCover.c
+ *  @brief Cycle cover calculation as an alternative to the greedy calculation.
+ *
+ *  The greedy calculation takes the largest overlap first and may block 
+ *  better combinations of smaller overlaps. The cycle cover calculation 
+ *  takes all overlaps into account at once: the assignment of a successor
+ *  to every array with the largest sum of overlaps (maximum weight cycle 
+ *  cover of the overlap graph). An array assigned to itself has no successor.
+ *
+ *  Only the ROADC_CYCLE_COVER_CANDIDATES largest overlaps of every array are
+ *  candidates for its successor, so the graph has O(n) edges for n arrays.
+ *  The assignment on this sparse graph is calculated by the auction 
+ *  algorithm with epsilon scaling. The overlaps are scaled by n+1, so the
+ *  last phase with epsilon 1 gives the largest sum of the candidate overlaps.
+ *  The overlaps of all pairs are calculated one row at a time, only the 
+ *  candidates are kept.
+ *
+ *  Every cycle of the assignment is broken at its smallest overlap and the
+ *  arrays of the cycle are merged in this order, every array with the 
+ *  largest alignment compatible overlap to the previous merged arrays. 
+ *  The merged arrays of all cycles are the arrays of the next round, until
+ *  no arrays overlap any more.
+ */
+
+#include "roadcInternal.h"
+
+/* successor candidates of every array: the arrays with the largest overlaps */
+#ifndef ROADC_CYCLE_COVER_CANDIDATES
+#define ROADC_CYCLE_COVER_CANDIDATES 16
+#endif /* ROADC_CYCLE_COVER_CANDIDATES */
+
+/* candidates of an array including the array itself (no successor) */
+#define ROADC_CYCLE_COVER_SLOTS (ROADC_CYCLE_COVER_CANDIDATES+1)
+
+/* no row or column */
+#define ROADC_CYCLE_COVER_NONE ((tRoadcUInt32)(-1))
+
+/* signed values for the bids and prices of the auction */
+typedef long long tRoadcCycleCoverValue;
+
+/* price of a column that is the only candidate of its row */
+#define ROADC_CYCLE_COVER_INFINITE (((tRoadcCycleCoverValue)1)<<60)
+
+/* largest scaled overlap, prices and bids stay far below the overflow */
+#define ROADC_CYCLE_COVER_MAX_SCALED (((tRoadcCycleCoverValue)1)<<56)
+
+struct tRoadcCycleCoverStruct{
+  tRoadcUInt32 numberEntries;
+  tRoadcDataEntryPtrPtr ppEntries;
+  /* overlaps of one array followed by every array */
+  tRoadcUInt32 *pRowOverlaps;
+  /* candidates of index i at i*ROADC_CYCLE_COVER_SLOTS, the first is i itself,
+     the others by decreasing overlap */
+  tRoadcUInt32 *pCandidates;
+  tRoadcUInt32 *pCandidateOverlaps;
+  tRoadcUInt32 *pNumberCandidates;
+  /* successor of every index and its overlap */
+  tRoadcUInt32 *pSuccessor;
+  tRoadcUInt32 *pSuccessorOverlap;
+  /* merge order, the cycles one after another */
+  tRoadcUInt32 *pOrder;
+  /* auction: price and row of every column, stack of the rows without column */
+  tRoadcCycleCoverValue *pPrice;
+  tRoadcUInt32 *pColumnRow;
+  tRoadcUInt32 *pUnassigned;
+  tRoadcBytePtr pDone;
+};
+
+typedef struct tRoadcCycleCoverStruct tRoadcCycleCover;
+typedef tRoadcCycleCover* tRoadcCycleCoverPtr;
+
+void roadcCycleCoverFree(tRoadcCycleCoverPtr pCycleCover){
+  free(pCycleCover->ppEntries);
+  free(pCycleCover->pRowOverlaps);
+  free(pCycleCover->pCandidates);
+  free(pCycleCover->pCandidateOverlaps);
+  free(pCycleCover->pNumberCandidates);
+  free(pCycleCover->pSuccessor);
+  free(pCycleCover->pSuccessorOverlap);
+  free(pCycleCover->pOrder);
+  free(pCycleCover->pPrice);
+  free(pCycleCover->pColumnRow);
+  free(pCycleCover->pUnassigned);
+  free(pCycleCover->pDone);
+}
+
+/* return: 0: ok, 1: malloc error */
+tRoadcByte roadcCycleCoverAlloc(tRoadcCycleCoverPtr pCycleCover,
+                                tRoadcUInt32 numberEntries){
+  pCycleCover->numberEntries = numberEntries;
+  pCycleCover->ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  pCycleCover->pRowOverlaps = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pCandidates = (tRoadcUInt32 *)malloc((size_t)numberEntries*ROADC_CYCLE_COVER_SLOTS*sizeof(tRoadcUInt32));
+  pCycleCover->pCandidateOverlaps = (tRoadcUInt32 *)malloc((size_t)numberEntries*ROADC_CYCLE_COVER_SLOTS*sizeof(tRoadcUInt32));
+  pCycleCover->pNumberCandidates = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pSuccessor = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pSuccessorOverlap = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pOrder = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pPrice = (tRoadcCycleCoverValue *)malloc(numberEntries*sizeof(tRoadcCycleCoverValue));
+  pCycleCover->pColumnRow = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pUnassigned = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pCycleCover->pDone = (tRoadcBytePtr)malloc(numberEntries*sizeof(tRoadcByte));
+  if((pCycleCover->ppEntries==NULL)||(pCycleCover->pRowOverlaps==NULL)||
+     (pCycleCover->pCandidates==NULL)||(pCycleCover->pCandidateOverlaps==NULL)||
+     (pCycleCover->pNumberCandidates==NULL)||
+     (pCycleCover->pSuccessor==NULL)||(pCycleCover->pSuccessorOverlap==NULL)||
+     (pCycleCover->pOrder==NULL)||(pCycleCover->pPrice==NULL)||
+     (pCycleCover->pColumnRow==NULL)||(pCycleCover->pUnassigned==NULL)||
+     (pCycleCover->pDone==NULL)){
+    roadcCycleCoverFree(pCycleCover);
+    return 1;
+  }
+  return 0;
+}
+
+/* keep the largest overlaps of the row as its candidates */
+void roadcCycleCoverCandidates(tRoadcCycleCoverPtr pCycleCover,
+                               tRoadcUInt32 row){
+  tRoadcUInt32 *pCandidates;
+  tRoadcUInt32 *pOverlaps;
+  tRoadcUInt32 numberCandidates;
+  tRoadcUInt32 overlap;
+  tRoadcUInt32 j, k;
+
+  pCandidates = &pCycleCover->pCandidates[row*ROADC_CYCLE_COVER_SLOTS];
+  pOverlaps = &pCycleCover->pCandidateOverlaps[row*ROADC_CYCLE_COVER_SLOTS];
+  /* no successor, the same as a successor without overlap */
+  pCandidates[0] = row;
+  pOverlaps[0] = 0;
+  numberCandidates = 1;
+  for(j=0;j<pCycleCover->numberEntries;j++){
+    overlap = pCycleCover->pRowOverlaps[j];
+    if(overlap==0){
+      continue;
+    }
+    if((numberCandidates==ROADC_CYCLE_COVER_SLOTS)&&
+       (overlap<=pOverlaps[numberCandidates-1])){
+      continue;
+    }
+    if(numberCandidates<ROADC_CYCLE_COVER_SLOTS){
+      numberCandidates++;
+    }
+    /* insert sorted, the smallest candidate is dropped if all slots are used */
+    k = numberCandidates-1;
+    while((k>1)&&(pOverlaps[k-1]<overlap)){
+      pCandidates[k] = pCandidates[k-1];
+      pOverlaps[k] = pOverlaps[k-1];
+      k--;
+    }
+    pCandidates[k] = j;
+    pOverlaps[k] = overlap;
+  }
+  pCycleCover->pNumberCandidates[row] = numberCandidates;
+}
+
+/* assignment with the largest sum of candidate overlaps by the auction algorithm:
+   a row without column bids for its best column, the price of the column rises
+   by the difference to the second best column plus epsilon */
+void roadcCycleCoverAssignment(tRoadcCycleCoverPtr pCycleCover){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 numberUnassigned;
+  tRoadcUInt32 *pCandidates;
+  tRoadcUInt32 *pOverlaps;
+  tRoadcCycleCoverValue scale;
+  tRoadcCycleCoverValue epsilon;
+  tRoadcCycleCoverValue maxOverlap;
+  tRoadcCycleCoverValue value, best, second;
+  tRoadcUInt32 i, k, row, column, bestIndex;
+
+  numberEntries = pCycleCover->numberEntries;
+  maxOverlap = 0;
+  for(i=0;i<numberEntries;i++){
+    pCycleCover->pPrice[i] = 0;
+    /* the second candidate has the largest overlap of the row */
+    if((pCycleCover->pNumberCandidates[i]>1)&&
+       ((tRoadcCycleCoverValue)pCycleCover->pCandidateOverlaps[i*ROADC_CYCLE_COVER_SLOTS+1]>maxOverlap)){
+      maxOverlap = (tRoadcCycleCoverValue)pCycleCover->pCandidateOverlaps[i*ROADC_CYCLE_COVER_SLOTS+1];
+    }
+  }
+  /* an epsilon below 1/n of an overlap gives the largest sum */
+  scale = (tRoadcCycleCoverValue)numberEntries+1;
+  if((tRoadcFloat64)maxOverlap*(tRoadcFloat64)scale>(tRoadcFloat64)ROADC_CYCLE_COVER_MAX_SCALED){
+    /* the sum is at most n below the largest sum */
+    scale = 1;
+  }
+  epsilon = maxOverlap*scale/4;
+  if(epsilon<1){
+    epsilon = 1;
+  }
+  while(1){
+    for(i=0;i<numberEntries;i++){
+      pCycleCover->pSuccessor[i] = ROADC_CYCLE_COVER_NONE;
+      pCycleCover->pColumnRow[i] = ROADC_CYCLE_COVER_NONE;
+      pCycleCover->pUnassigned[i] = numberEntries-1-i;
+    }
+    numberUnassigned = numberEntries;
+    while(numberUnassigned>0){
+      row = pCycleCover->pUnassigned[--numberUnassigned];
+      pCandidates = &pCycleCover->pCandidates[row*ROADC_CYCLE_COVER_SLOTS];
+      pOverlaps = &pCycleCover->pCandidateOverlaps[row*ROADC_CYCLE_COVER_SLOTS];
+      best = -2*ROADC_CYCLE_COVER_INFINITE;
+      second = -2*ROADC_CYCLE_COVER_INFINITE;
+      bestIndex = 0;
+      for(k=0;k<pCycleCover->pNumberCandidates[row];k++){
+        value = (tRoadcCycleCoverValue)pOverlaps[k]*scale-pCycleCover->pPrice[pCandidates[k]];
+        if(value>best){
+          second = best;
+          best = value;
+          bestIndex = k;
+        } else if(value>second){
+          second = value;
+        }
+      }
+      column = pCandidates[bestIndex];
+      if(pCycleCover->pNumberCandidates[row]==1){
+        /* the row has no other column, no other row gets it, the prices never fall */
+        if(pCycleCover->pPrice[column]<ROADC_CYCLE_COVER_INFINITE){
+          pCycleCover->pPrice[column] = ROADC_CYCLE_COVER_INFINITE;
+        } else {
+          pCycleCover->pPrice[column] += epsilon;
+        }
+      } else {
+        pCycleCover->pPrice[column] += best-second+epsilon;
+      }
+      if(pCycleCover->pColumnRow[column]!=ROADC_CYCLE_COVER_NONE){
+        /* the previous row of the column bids again */
+        pCycleCover->pSuccessor[pCycleCover->pColumnRow[column]] = ROADC_CYCLE_COVER_NONE;
+        pCycleCover->pUnassigned[numberUnassigned++] = pCycleCover->pColumnRow[column];
+      }
+      pCycleCover->pColumnRow[column] = row;
+      pCycleCover->pSuccessor[row] = column;
+      pCycleCover->pSuccessorOverlap[row] = pOverlaps[bestIndex];
+    }
+    if(epsilon==1){
+      break;
+    }
+    /* next phase with smaller epsilon, the prices are kept */
+    epsilon = epsilon/4;
+    if(epsilon<1){
+      epsilon = 1;
+    }
+  }
+}
+
+/* merge order: every cycle starts behind its smallest overlap, return: number of cycles */
+tRoadcUInt32 roadcCycleCoverOrder(tRoadcCycleCoverPtr pCycleCover,
+                                  tRoadcUInt32 *pCycleLengths){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 numberCycles;
+  tRoadcUInt32 position;
+  tRoadcUInt32 i, current, weakest;
+  tRoadcBytePtr pDone;
+
+  numberEntries = pCycleCover->numberEntries;
+  pDone = pCycleCover->pDone;
+  for(i=0;i<numberEntries;i++){
+    pDone[i] = 0;
+  }
+  numberCycles = 0;
+  position = 0;
+  for(i=0;i<numberEntries;i++){
+    if(pDone[i]){
+      continue;
+    }
+    /* smallest overlap of the cycle from weakest to its successor */
+    weakest = i;
+    current = pCycleCover->pSuccessor[i];
+    while(current!=i){
+      if(pCycleCover->pSuccessorOverlap[current]<pCycleCover->pSuccessorOverlap[weakest]){
+        weakest = current;
+      }
+      current = pCycleCover->pSuccessor[current];
+    }
+    pCycleLengths[numberCycles] = 0;
+    current = pCycleCover->pSuccessor[weakest];
+    do{
+      pDone[current] = 1;
+      pCycleCover->pOrder[position++] = current;
+      pCycleLengths[numberCycles]++;
+      current = pCycleCover->pSuccessor[current];
+    } while(!pDone[current]);
+    numberCycles++;
+  }
+  return numberCycles;
+}
+
+/* one round: cycle cover of all arrays and merge of every cycle,
+   return: 0: ok, 1: malloc error or timeout */
+tRoadcByte roadcCycleCoverRound(tRoadcPtr pRoadc,
+                                tRoadcUInt32 maxTimeInSeconds,
+                                tRoadcCycleCoverPtr pCycleCover){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 numberCycles;
+  tRoadcUInt32 *pCycleLengths;
+  tRoadcUInt32 i, position;
+  tRoadc result;
+
+  numberEntries = pCycleCover->numberEntries;
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pCycleCover->ppEntries[i++] = pCurrent;
+    pCurrent = pCurrent->pNext;
+  }
+  for(i=0;i<numberEntries;i++){
+    if(roadcOverlapRow(pCycleCover->ppEntries, numberEntries, i, pCycleCover->pRowOverlaps)){
+      return 1;
+    }
+    roadcCycleCoverCandidates(pCycleCover, i);
+    if((maxTimeInSeconds!=ROADC_NO_TIMEOUT)&&
+       (roadcTimerRead(pRoadc)>=maxTimeInSeconds)){
+      pRoadc->roadcStopedByTimeout=1;
+      ROADC_NOTIFICATION_MSG(pRoadc, "Cycle cover stop due to elapsed time\n");
+      return 1;
+    }
+  }
+  roadcCycleCoverAssignment(pCycleCover);
+  /* the cycle lengths use the column rows of the assignment, they are not needed any more */
+  pCycleLengths = pCycleCover->pColumnRow;
+  numberCycles = roadcCycleCoverOrder(pCycleCover, pCycleLengths);
+
+  roadcInitialize(&result);
+  position = 0;
+  for(i=0;i<numberCycles;i++){
+    if(roadcOverlapMergeOrder(pCycleCover->ppEntries, pCycleLengths[i], 
+                              &pCycleCover->pOrder[position], &result)){
+      roadcDeleteEntries(&result);
+      return 1;
+    }
+    position += pCycleLengths[i];
+  }
+  roadcReplaceDataEntries(pRoadc, &result);
+  return 0;
+}
+
+/* memory of a cycle cover round: candidates, auction, and the merged arrays */
+tRoadcUInt64 roadcCycleCoverMemory(tRoadcPtr pRoadc){
+  tRoadcUInt64 numberEntries;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  return numberEntries*(2*ROADC_CYCLE_COVER_SLOTS*sizeof(tRoadcUInt32)+
+                        sizeof(tRoadcCycleCoverValue)+7*sizeof(tRoadcUInt32)+sizeof(tRoadcDataEntryPtr)+1)+
+    roadcDataEntriesMemory(pRoadc);
+}
+
+tRoadcByte roadcCycleCoverCalculation(tRoadcPtr pRoadc,
+                                      tRoadcUInt32 maxTimeInSeconds){
+  tRoadcCycleCover cycleCover;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 round;
+
+  round = 0;
+  while(pRoadc->roadcNumberDataEntries>1){
+    numberEntries = pRoadc->roadcNumberDataEntries;
+    if(!roadcMemoryAvailable(pRoadc, roadcCycleCoverMemory(pRoadc), "cycle cover")){
+      return 1;
+    }
+    if(roadcCycleCoverAlloc(&cycleCover, numberEntries)){
+      ROADC_NOTIFICATION_MSG(pRoadc, "cycle cover skipped: malloc error\n");
+      return 1;
+    }
+    if(roadcCycleCoverRound(pRoadc, maxTimeInSeconds, &cycleCover)){
+      roadcCycleCoverFree(&cycleCover);
+      /* the arrays of the last round are kept */
+      return (tRoadcByte)(round==0);
+    }
+    roadcCycleCoverFree(&cycleCover);
+    round++;
+    ROADC_NOTIFICATION_MSG(pRoadc, "cycle cover round %lu: %lu arrays\n", round, pRoadc->roadcNumberDataEntries);
+    if(pRoadc->roadcNumberDataEntries==numberEntries){
+      /* no overlaps any more */
+      return 0;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcDispatch.c
+ *  @brief Selection of the calculation kernels by statistics of the arrays.
+ *
+ *  A profile of the arrays (number, sizes, padding bits and alignment,
+ *  number of greedy compares) is collected in a single pass over the
+ *  list of arrays. It selects the calculation engine for ROADC_ENGINE_AUTO
+ *  and the kernel of the removal of multiple arrays. Every decision is
+ *  notified in verbose mode.
+ */
+
+#include "roadcInternal.h"
+
+/* arrays up to this number: greedy and cycle cover calculation (ROADC_ENGINE_BEST) */
+#ifndef ROADC_DISPATCH_BEST_MAX_ENTRIES
+#define ROADC_DISPATCH_BEST_MAX_ENTRIES 256
+#endif /* ROADC_DISPATCH_BEST_MAX_ENTRIES */
+/* greedy compares from this number: suffix greedy calculation */
+#ifndef ROADC_DISPATCH_SUFFIX_MIN_COMPARES
+#define ROADC_DISPATCH_SUFFIX_MIN_COMPARES 1.0e9
+#endif /* ROADC_DISPATCH_SUFFIX_MIN_COMPARES */
+/* number of arrays of the overlap memo of the greedy calculation, see roadcOverlap.c */
+#ifndef ROADC_OVERLAP_MEMO_MAX_ENTRIES
+#define ROADC_OVERLAP_MEMO_MAX_ENTRIES 1024
+#endif /* ROADC_OVERLAP_MEMO_MAX_ENTRIES */
+
+/* names of the engines for notifications */
+static const char *roadcDispatchEngineNames[] = {"greedy", "cycle", "best", "suffix", "auto"};
+
+const char *roadcDispatchEngineName(tRoadcByte engine){
+  if(engine>ROADC_ENGINE_AUTO){
+    engine = ROADC_ENGINE_GREEDY;
+  }
+  return roadcDispatchEngineNames[engine];
+}
+
+void roadcProfile(tRoadcPtr pRoadc,
+                  tRoadcProfilePtr pProfile){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcFloat64 j, jSuffix;
+  tRoadcUInt32 nextSize;
+
+  pProfile->numberEntries = 0;
+  pProfile->numberSizes = 0;
+  pProfile->numberPlain = 0;
+  pProfile->numberMasked = 0;
+  pProfile->sumSizes = 0;
+  pProfile->compares = 0.0;
+  pProfile->suffixCompares = 0.0;
+  j = 0.0;
+  jSuffix = 0.0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pProfile->numberEntries++;
+    pProfile->sumSizes += pCurrent->size;
+    if((pCurrent->pPrevious==NULL)||(pCurrent->pPrevious->size!=pCurrent->size)){
+      /* the list is sorted by size */
+      pProfile->numberSizes++;
+    }
+    j += 1.0;
+    if(pCurrent->ppPaddingByteMaskBlocks!=NULL){
+      pProfile->numberMasked++;
+    }
+    if(roadcSuffixIsPossible(pCurrent)){
+      pProfile->numberPlain++;
+    } else {
+      /* merged by the greedy calculation after the suffix greedy calculation */
+      jSuffix += 1.0;
+    }
+    /* number of compares of the greedy calculation: every pair of the arrays
+       larger than the overlap size, both directions, for every overlap size */
+    nextSize = (pCurrent->pNext!=NULL) ? pCurrent->pNext->size : 1;
+    if(nextSize<1){
+      nextSize = 1;
+    }
+    if(pCurrent->size>nextSize){
+      pProfile->compares += (tRoadcFloat64)(pCurrent->size-nextSize)*j*(j-1.0);
+      pProfile->suffixCompares += (tRoadcFloat64)(pCurrent->size-nextSize)*jSuffix*(jSuffix-1.0);
+    }
+    pCurrent = pCurrent->pNext;
+  }
+}
+
+tRoadcByte roadcDispatchEngineSelect(tRoadcProfilePtr pProfile){
+  if(pProfile->numberEntries<=1){
+    return ROADC_ENGINE_GREEDY;
+  }
+  if((pProfile->compares>=ROADC_DISPATCH_SUFFIX_MIN_COMPARES)&&
+     (2*pProfile->numberPlain>=pProfile->numberEntries)){
+    /* most arrays merged without compares of pairs */
+    return ROADC_ENGINE_SUFFIX;
+  }
+  if(pProfile->numberEntries<=ROADC_DISPATCH_BEST_MAX_ENTRIES){
+    /* both calculations are fast */
+    return ROADC_ENGINE_BEST;
+  }
+  return ROADC_ENGINE_GREEDY;
+}
+
+tRoadcByte roadcDispatchEngine(tRoadcPtr pRoadc){
+  tRoadcProfile profile;
+  tRoadcByte engine;
+
+  roadcProfile(pRoadc, &profile);
+  engine = roadcDispatchEngineSelect(&profile);
+  ROADC_NOTIFICATION_MSG(pRoadc, "dispatch: %lu arrays, %lu without padding bits and alignment, %g greedy compares: engine %s, greedy %s\n",
+                         profile.numberEntries, profile.numberPlain, profile.compares,
+                         roadcDispatchEngineName(engine),
+                         ((profile.numberMasked>0)&&(profile.numberMasked<=ROADC_OVERLAP_MEMO_MAX_ENTRIES)) ? "with overlap memo" : "list based");
+  return engine;
+}
+
+tRoadcByte roadcDispatchMultipleIsHash(tRoadcProfilePtr pProfile){
+  /* hashes need about d passes over all arrays for d sizes,
+     the compares about n/2 passes for n arrays */
+  return (tRoadcByte)((pProfile->numberEntries>1)&&
+                      (pProfile->numberPlain==pProfile->numberEntries)&&
+                      (2*pProfile->numberSizes<pProfile->numberEntries));
+}
+
+tRoadcByte roadcDispatchMultiple(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds){
+  tRoadcProfile profile;
+
+  roadcProfile(pRoadc, &profile);
+  if(!roadcDispatchMultipleIsHash(&profile)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "dispatch: remove multiple arrays by compares, %lu arrays, %lu sizes, %lu without padding bits and alignment\n",
+                           profile.numberEntries, profile.numberSizes, profile.numberPlain);
+    return 1;
+  }
+  if(!roadcMemoryAvailable(pRoadc, (tRoadcUInt64)profile.numberEntries*(2*sizeof(tRoadcUInt64)+4*sizeof(tRoadcUInt32)+1),
+                           "multiple hash")){
+    return 1;
+  }
+  ROADC_NOTIFICATION_MSG(pRoadc, "dispatch: remove multiple arrays by hashes, %lu arrays, %lu sizes\n",
+                         profile.numberEntries, profile.numberSizes);
+  if(roadcMultipleHashCalculation(pRoadc, maxTimeInSeconds)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "WARNING: not enough memory for the multiple hash, using compares\n");
+    return 1;
+  }
+  return 0;
+}
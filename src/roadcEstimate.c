@@ -0,0 +1,625 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcEstimate.c
+ *  @brief Fast estimate of the compacted data size and the calculation time.
+ *
+ *  The arrays are not changed. Up to ROADC_ESTIMATE_MAX_SAMPLES arrays are
+ *  sampled at equal distances in the list of arrays (sorted by size). A single
+ *  pass over all arrays with polynomial hashes finds for every sampled array
+ *
+ *    - arrays containing its first k-gram, up to ROADC_ESTIMATE_MAX_CANDIDATES
+ *      of them are checked by the compare of the multiple removal,
+ *    - the largest overlap to a successor, i.e. the longest suffix equal to
+ *      the prefix of another array, and the largest overlap to a predecessor.
+ *
+ *  The size saved by the sampled arrays (the array size if it is contained,
+ *  otherwise the smaller sum of overlaps to successors and to predecessors as
+ *  for the lower bound) is extrapolated to all arrays. Overlaps ignore padding
+ *  bits and alignment, so more arrays may be merged than estimated.
+ *
+ *  The calculation time is extrapolated from the measured time of a compare
+ *  of the multiple removal, of the greedy calculation, and of the overlap
+ *  calculation for pairs of sampled arrays, and from the number of compares
+ *  of the selected calculation: the multiple removal compares all pairs of
+ *  arrays or hashes all arrays once per array size, the greedy calculation compares every pair of arrays larger than
+ *  the overlap size for every overlap size, the cycle cover calculation and
+ *  the exact calculation need the overlaps of all pairs and O(n^3) and
+ *  O(2^n * n^2) steps, the suffix greedy calculation a few steps per byte.
+ */
+
+#include <unistd.h>
+#include "roadcInternal.h"
+
+/* maximal number of sampled arrays */
+#ifndef ROADC_ESTIMATE_MAX_SAMPLES
+#define ROADC_ESTIMATE_MAX_SAMPLES 256
+#endif /* ROADC_ESTIMATE_MAX_SAMPLES */
+/* length of the k-gram for the arrays containing a sampled array */
+#define ROADC_ESTIMATE_GRAM_LENGTH 8
+/* maximal number of arrays checked for containing a sampled array */
+#define ROADC_ESTIMATE_MAX_CANDIDATES 16
+/* maximal overlap length searched */
+#define ROADC_ESTIMATE_MAX_OVERLAP 1024
+/* maximal number of hashed bytes of all arrays, more arrays are skipped */
+#define ROADC_ESTIMATE_MAX_SCAN (32UL*1024UL*1024UL)
+/* maximal time and number of measured compares of every kind */
+#define ROADC_ESTIMATE_MEASURE_TIME 0.01
+#define ROADC_ESTIMATE_MEASURE_COMPARES 4096
+/* number of arrays with overlap matrix (cycle cover, local search, lower bound) */
+#define ROADC_ESTIMATE_MATRIX_MAX_ENTRIES 1024
+/* hash base and key offsets of the three kinds of hashes */
+#define ROADC_ESTIMATE_HASH_BASE 0x100000001B3ULL
+#define ROADC_ESTIMATE_KEY_GRAM 0x9E3779B97F4A7C15ULL
+#define ROADC_ESTIMATE_KEY_SUFFIX 0xC2B2AE3D27D4EB4FULL
+#define ROADC_ESTIMATE_KEY_PREFIX 0x165667B19E3779F9ULL
+#define ROADC_ESTIMATE_KEY_LENGTH 0xD6E8FEB86659FD93ULL
+/* end of a hash chain */
+#define ROADC_ESTIMATE_NONE 0xFFFFFFFFUL
+
+struct tRoadcEstimateSampleStruct{
+  tRoadcDataEntryPtr pEntry;
+  /* position in the list of arrays */
+  tRoadcUInt32 index;
+  tRoadcDataEntryPtr ppCandidates[ROADC_ESTIMATE_MAX_CANDIDATES];
+  tRoadcUInt32 numberCandidates;
+  tRoadcUInt32 overlapOut;
+  tRoadcUInt32 overlapIn;
+  tRoadcByte contained;
+};
+
+typedef struct tRoadcEstimateSampleStruct tRoadcEstimateSample;
+typedef tRoadcEstimateSample* tRoadcEstimateSamplePtr;
+
+/* hash keys of the sampled arrays, chained per bucket */
+struct tRoadcEstimateHashStruct{
+  tRoadcUInt32 *pBucketFirst;
+  tRoadcUInt64 *pKey;
+  tRoadcUInt32 *pSample;
+  tRoadcUInt32 *pNext;
+  tRoadcUInt64 *pPower;
+  tRoadcUInt32 numberBuckets;
+  tRoadcUInt32 numberKeys;
+};
+
+typedef struct tRoadcEstimateHashStruct tRoadcEstimateHash;
+typedef tRoadcEstimateHash* tRoadcEstimateHashPtr;
+
+/* measured time of a single compare or step in seconds */
+struct tRoadcEstimateCostStruct{
+  tRoadcFloat64 contain;
+  tRoadcFloat64 overlap;
+  tRoadcFloat64 largest;
+  tRoadcFloat64 operation;
+  tRoadcFloat64 byte;
+};
+
+typedef struct tRoadcEstimateCostStruct tRoadcEstimateCost;
+typedef tRoadcEstimateCost* tRoadcEstimateCostPtr;
+
+tRoadcUInt64 roadcEstimateKey(tRoadcUInt64 hash,
+                              tRoadcUInt64 kind,
+                              tRoadcUInt32 length){
+  return hash + kind + (tRoadcUInt64)length*ROADC_ESTIMATE_KEY_LENGTH;
+}
+
+tRoadcUInt32 roadcEstimateBucket(tRoadcEstimateHashPtr pHash,
+                                 tRoadcUInt64 key){
+  return (tRoadcUInt32)((key ^ (key>>29))*ROADC_ESTIMATE_KEY_GRAM>>32)&(pHash->numberBuckets-1);
+}
+
+void roadcEstimateHashInsert(tRoadcEstimateHashPtr pHash,
+                             tRoadcUInt64 key,
+                             tRoadcUInt32 sample){
+  tRoadcUInt32 bucket;
+
+  bucket = roadcEstimateBucket(pHash, key);
+  pHash->pKey[pHash->numberKeys] = key;
+  pHash->pSample[pHash->numberKeys] = sample;
+  pHash->pNext[pHash->numberKeys] = pHash->pBucketFirst[bucket];
+  pHash->pBucketFirst[bucket] = pHash->numberKeys;
+  pHash->numberKeys++;
+}
+
+void roadcEstimateHashFree(tRoadcEstimateHashPtr pHash){
+  free(pHash->pBucketFirst);
+  free(pHash->pKey);
+  free(pHash->pSample);
+  free(pHash->pNext);
+  free(pHash->pPower);
+}
+
+/* return: 0: ok, 1: malloc error */
+tRoadcByte roadcEstimateHashAlloc(tRoadcEstimateHashPtr pHash,
+                                  tRoadcUInt32 numberKeys,
+                                  tRoadcUInt32 maxOverlap){
+  tRoadcUInt32 i;
+
+  pHash->numberBuckets = 1;
+  while(pHash->numberBuckets<2*numberKeys){
+    pHash->numberBuckets *= 2;
+  }
+  pHash->numberKeys = 0;
+  pHash->pBucketFirst = (tRoadcUInt32 *)malloc(pHash->numberBuckets*sizeof(tRoadcUInt32));
+  pHash->pKey = (tRoadcUInt64 *)malloc(numberKeys*sizeof(tRoadcUInt64));
+  pHash->pSample = (tRoadcUInt32 *)malloc(numberKeys*sizeof(tRoadcUInt32));
+  pHash->pNext = (tRoadcUInt32 *)malloc(numberKeys*sizeof(tRoadcUInt32));
+  pHash->pPower = (tRoadcUInt64 *)malloc((maxOverlap+ROADC_ESTIMATE_GRAM_LENGTH+1)*sizeof(tRoadcUInt64));
+  if((pHash->pBucketFirst==NULL)||(pHash->pKey==NULL)||(pHash->pSample==NULL)||
+     (pHash->pNext==NULL)||(pHash->pPower==NULL)){
+    roadcEstimateHashFree(pHash);
+    return 1;
+  }
+  for(i=0;i<pHash->numberBuckets;i++){
+    pHash->pBucketFirst[i] = ROADC_ESTIMATE_NONE;
+  }
+  pHash->pPower[0] = 1;
+  for(i=1;i<=maxOverlap+ROADC_ESTIMATE_GRAM_LENGTH;i++){
+    pHash->pPower[i] = pHash->pPower[i-1]*ROADC_ESTIMATE_HASH_BASE;
+  }
+  return 0;
+}
+
+/* the sampled array could be removed as contained in the array at position index */
+tRoadcByte roadcEstimateIsCandidate(tRoadcEstimateSamplePtr pSample,
+                                    tRoadcDataEntryPtr pEntry,
+                                    tRoadcUInt32 index){
+  if((pEntry==pSample->pEntry)||(pSample->numberCandidates==ROADC_ESTIMATE_MAX_CANDIDATES)){
+    return 0;
+  }
+  if((pSample->numberCandidates>0)&&
+     (pSample->ppCandidates[pSample->numberCandidates-1]==pEntry)){
+    /* k-gram found again in the same array */
+    return 0;
+  }
+  /* the multiple removal keeps the first one of equal arrays */
+  return (tRoadcByte)((pEntry->size>pSample->pEntry->size)||
+                      ((pEntry->size==pSample->pEntry->size)&&(index<pSample->index)));
+}
+
+/* hashes of k-gram, suffixes, and prefixes of the sampled arrays */
+void roadcEstimateHashSamples(tRoadcEstimateHashPtr pHash,
+                              tRoadcEstimateSamplePtr pSamples,
+                              tRoadcUInt32 numberSamples,
+                              tRoadcUInt32 gramLength,
+                              tRoadcUInt32 maxOverlap){
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt64 prefixHash;
+  tRoadcUInt64 suffixHash;
+  tRoadcUInt32 s, l;
+
+  for(s=0;s<numberSamples;s++){
+    pEntry = pSamples[s].pEntry;
+    prefixHash = 0;
+    suffixHash = 0;
+    for(l=1;l<=gramLength;l++){
+      prefixHash = prefixHash*ROADC_ESTIMATE_HASH_BASE + pEntry->pData[l-1];
+    }
+    roadcEstimateHashInsert(pHash, roadcEstimateKey(prefixHash, ROADC_ESTIMATE_KEY_GRAM, gramLength), s);
+    prefixHash = 0;
+    for(l=1;(l<pEntry->size)&&(l<=maxOverlap);l++){
+      prefixHash = prefixHash*ROADC_ESTIMATE_HASH_BASE + pEntry->pData[l-1];
+      suffixHash = suffixHash + pEntry->pData[pEntry->size-l]*pHash->pPower[l-1];
+      roadcEstimateHashInsert(pHash, roadcEstimateKey(prefixHash, ROADC_ESTIMATE_KEY_PREFIX, l), s);
+      roadcEstimateHashInsert(pHash, roadcEstimateKey(suffixHash, ROADC_ESTIMATE_KEY_SUFFIX, l), s);
+    }
+  }
+}
+
+/* k-grams, prefixes, and suffixes of an array compared to the sampled arrays,
+   return: number of hashed bytes */
+tRoadcUInt64 roadcEstimateScanEntry(tRoadcEstimateHashPtr pHash,
+                                    tRoadcEstimateSamplePtr pSamples,
+                                    tRoadcDataEntryPtr pEntry,
+                                    tRoadcUInt32 index,
+                                    tRoadcUInt32 gramLength,
+                                    tRoadcUInt32 maxOverlap){
+  tRoadcUInt64 hash;
+  tRoadcUInt64 suffixHash;
+  tRoadcUInt64 key;
+  tRoadcUInt32 node;
+  tRoadcUInt32 i, l;
+  tRoadcEstimateSamplePtr pSample;
+
+  hash = 0;
+  for(i=0;i<pEntry->size;i++){
+    if(i>=gramLength){
+      hash = hash - pEntry->pData[i-gramLength]*pHash->pPower[gramLength-1];
+    }
+    hash = hash*ROADC_ESTIMATE_HASH_BASE + pEntry->pData[i];
+    if(i+1>=gramLength){
+      key = roadcEstimateKey(hash, ROADC_ESTIMATE_KEY_GRAM, gramLength);
+      for(node=pHash->pBucketFirst[roadcEstimateBucket(pHash, key)];node!=ROADC_ESTIMATE_NONE;node=pHash->pNext[node]){
+        pSample = &pSamples[pHash->pSample[node]];
+        if((pHash->pKey[node]==key)&&roadcEstimateIsCandidate(pSample, pEntry, index)){
+          pSample->ppCandidates[pSample->numberCandidates++] = pEntry;
+        }
+      }
+    }
+  }
+  /* prefix of the array equal to the suffix of a sampled array: overlap to a successor,
+     suffix of the array equal to the prefix of a sampled array: overlap to a predecessor */
+  hash = 0;
+  suffixHash = 0;
+  for(l=1;(l<pEntry->size)&&(l<=maxOverlap);l++){
+    hash = hash*ROADC_ESTIMATE_HASH_BASE + pEntry->pData[l-1];
+    suffixHash = suffixHash + pEntry->pData[pEntry->size-l]*pHash->pPower[l-1];
+    key = roadcEstimateKey(hash, ROADC_ESTIMATE_KEY_SUFFIX, l);
+    for(node=pHash->pBucketFirst[roadcEstimateBucket(pHash, key)];node!=ROADC_ESTIMATE_NONE;node=pHash->pNext[node]){
+      pSample = &pSamples[pHash->pSample[node]];
+      if((pHash->pKey[node]==key)&&(pSample->pEntry!=pEntry)&&(pSample->overlapOut<l)){
+        pSample->overlapOut = l;
+      }
+    }
+    key = roadcEstimateKey(suffixHash, ROADC_ESTIMATE_KEY_PREFIX, l);
+    for(node=pHash->pBucketFirst[roadcEstimateBucket(pHash, key)];node!=ROADC_ESTIMATE_NONE;node=pHash->pNext[node]){
+      pSample = &pSamples[pHash->pSample[node]];
+      if((pHash->pKey[node]==key)&&(pSample->pEntry!=pEntry)&&(pSample->overlapIn<l)){
+        pSample->overlapIn = l;
+      }
+    }
+  }
+  return (tRoadcUInt64)pEntry->size + 2*(tRoadcUInt64)(l-1);
+}
+
+/* time of the compares of sampled arrays in seconds per compare */
+void roadcEstimateMeasure(tRoadcEstimateSamplePtr pSamples,
+                          tRoadcUInt32 numberSamples,
+                          tRoadcEstimateCostPtr pCost){
+  tRoadcFloat64 startTime;
+  tRoadcFloat64 elapsedTime;
+  tRoadcDataEntryPtr pLeft;
+  tRoadcDataEntryPtr pRight;
+  tRoadcDataEntry calcResult;
+  tRoadcUInt32 count, kind, i;
+  tRoadcUInt32 minSize;
+  tRoadcByte mallocError;
+  volatile tRoadcUInt32 sink;
+
+  roadcInitDataEntry(&calcResult);
+  sink = 0;
+  for(kind=0;kind<3;kind++){
+    startTime = roadcTimerNow();
+    elapsedTime = 0.0;
+    count = 0;
+    for(i=0;(i<ROADC_ESTIMATE_MEASURE_COMPARES)&&(elapsedTime<ROADC_ESTIMATE_MEASURE_TIME);i++){
+      pLeft = pSamples[(i*7)%numberSamples].pEntry;
+      pRight = pSamples[(i*13+1)%numberSamples].pEntry;
+      minSize = (pLeft->size<pRight->size) ? pLeft->size : pRight->size;
+      if(kind==0){
+        /* multiple removal: smaller array in larger array */
+        if(pLeft->size<=pRight->size){
+          sink += roadcArrayGetPosition(pLeft, pRight);
+        } else {
+          sink += roadcArrayGetPosition(pRight, pLeft);
+        }
+        count++;
+      } else if(minSize>1){
+        if(kind==1){
+          /* greedy: one overlap size */
+          sink += roadcIsOverlap(pLeft, pRight, 1+i%(minSize-1));
+        } else {
+          /* overlap matrix: largest overlap */
+          sink += roadcOverlapLargest(pLeft, pRight, minSize-1, &calcResult, &mallocError);
+        }
+        count++;
+      }
+      if((i&15)==15){
+        elapsedTime = roadcTimerNow()-startTime;
+      }
+    }
+    elapsedTime = roadcTimerNow()-startTime;
+    if(count==0){
+      elapsedTime = 0.0;
+      count = 1;
+    }
+    if(kind==0){
+      pCost->contain = elapsedTime/count;
+    } else if(kind==1){
+      pCost->overlap = elapsedTime/count;
+    } else {
+      pCost->largest = elapsedTime/count;
+    }
+  }
+  /* a step of the assignment or of the dynamic program */
+  startTime = roadcTimerNow();
+  for(i=0;i<65536;i++){
+    sink = sink*3 + i;
+  }
+  pCost->operation = (roadcTimerNow()-startTime)/65536.0;
+}
+
+/* time of the multiple removal and the calculation of the order of n arrays,
+   a share of them contained in other arrays, removed by hashes for numberSizes>0 */
+tRoadcFloat64 roadcEstimateCalculationTime(tRoadcPtr pRoadc,
+                                           tRoadcEstimateCostPtr pCost,
+                                           tRoadcByte engine,
+                                           tRoadcUInt32 maxTimeInSeconds,
+                                           tRoadcFloat64 n,
+                                           tRoadcFloat64 compares,
+                                           tRoadcFloat64 suffixCompares,
+                                           tRoadcFloat64 sumSizes,
+                                           tRoadcFloat64 numberSizes,
+                                           tRoadcFloat64 containedShare){
+  tRoadcFloat64 time;
+  tRoadcFloat64 orderTime;
+  tRoadcFloat64 n1;
+  tRoadcFloat64 left;
+  tRoadcFloat64 greedy;
+  tRoadcFloat64 cycleCover;
+  tRoadcFloat64 localSearch;
+  tRoadcFloat64 rounds;
+  long numberProcessors;
+
+  n1 = n*(1.0-containedShare);
+  left = (1.0-containedShare)*(1.0-containedShare);
+  if(numberSizes>0.0){
+    time = pCost->byte*numberSizes*sumSizes;
+  } else {
+    time = pCost->contain*n*(n-1.0)/2.0*(1.0-containedShare/2.0);
+  }
+  if((pRoadc->roadcVerbose || (pRoadc->roadcTargetGap>=0.0))&&(n1<=ROADC_ESTIMATE_MATRIX_MAX_ENTRIES)){
+    time += pCost->largest*n1*n1;
+  }
+  orderTime = 0.0;
+  if((n1>=2.0)&&(n1<=(tRoadcFloat64)roadcExactMaxEntries(pRoadc))){
+    orderTime += pCost->largest*n1*n1 + pCost->operation*(tRoadcFloat64)(1UL<<(tRoadcUInt32)n1)*n1*n1;
+  }
+  greedy = pCost->overlap*compares*left;
+  localSearch = 0.0;
+  if((pRoadc->roadcLocalSearchTimeShare>0)&&(n1<=ROADC_ESTIMATE_MATRIX_MAX_ENTRIES)){
+    if(maxTimeInSeconds!=ROADC_NO_TIMEOUT){
+      localSearch = (tRoadcFloat64)maxTimeInSeconds*pRoadc->roadcLocalSearchTimeShare/100.0;
+    } else {
+      /* overlap matrix and some passes of moves of up to three arrays */
+      localSearch = pCost->largest*n1*n1 + pCost->operation*3.0*n1*n1*(n1/8.0+1.0);
+    }
+  }
+  cycleCover = -1.0;
+  if(n1<=ROADC_ESTIMATE_MATRIX_MAX_ENTRIES){
+    cycleCover = pCost->largest*n1*n1 + pCost->operation*2.0*n1*n1*n1;
+  }
+  switch(engine){
+  case ROADC_ENGINE_SUFFIX:
+    orderTime += pCost->byte*sumSizes*8.0 + pCost->overlap*suffixCompares*left;
+    break;
+  case ROADC_ENGINE_CYCLE_COVER:
+    orderTime += (cycleCover>=0.0) ? cycleCover : greedy+localSearch;
+    break;
+  case ROADC_ENGINE_BEST:
+    orderTime += ((cycleCover>=0.0) ? cycleCover : 0.0) + greedy + localSearch;
+    break;
+  default:
+    orderTime += greedy + localSearch;
+    break;
+  }
+  if(pRoadc->roadcPortfolioSize>1){
+    /* one thread per calculation */
+    numberProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    if(numberProcessors<1){
+      numberProcessors = 1;
+    }
+    rounds = (tRoadcFloat64)((pRoadc->roadcPortfolioSize+numberProcessors-1)/numberProcessors);
+    orderTime *= rounds;
+  }
+  return time + orderTime;
+}
+
+/* time of roadcCalculation() with the engine */
+tRoadcFloat64 roadcEstimateTime(tRoadcPtr pRoadc,
+                                tRoadcEstimateCostPtr pCost,
+                                tRoadcByte engine,
+                                tRoadcUInt32 maxTimeInSeconds,
+                                tRoadcProfilePtr pProfile,
+                                tRoadcFloat64 containedShare){
+  tRoadcFloat64 time;
+  tRoadcFloat64 n;
+  tRoadcFloat64 k;
+  tRoadcFloat64 sumSizes;
+  tRoadcFloat64 numberSizes;
+  long numberProcessors;
+
+  if(engine==ROADC_ENGINE_AUTO){
+    engine = roadcDispatchEngineSelect(pProfile);
+  }
+  numberSizes = roadcDispatchMultipleIsHash(pProfile) ? (tRoadcFloat64)pProfile->numberSizes : 0.0;
+  n = (tRoadcFloat64)pRoadc->roadcNumberDataEntries;
+  sumSizes = (tRoadcFloat64)pRoadc->roadcCurrentInputSize;
+  if((pRoadc->roadcNumberShards>1)&&(pRoadc->pRoadcOrder==NULL)&&
+     (pRoadc->roadcNumberDataEntries>pRoadc->roadcNumberShards)){
+    /* shards of n/k similar arrays in parallel, then the k merged shards */
+    k = (tRoadcFloat64)pRoadc->roadcNumberShards;
+    numberProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    if(numberProcessors<1){
+      numberProcessors = 1;
+    }
+    time = pCost->byte*sumSizes +
+      (tRoadcFloat64)((pRoadc->roadcNumberShards+numberProcessors-1)/numberProcessors)*
+      roadcEstimateCalculationTime(pRoadc, pCost, engine, maxTimeInSeconds, n/k,
+                                   pProfile->compares/(k*k), pProfile->suffixCompares/(k*k), sumSizes/k,
+                                   numberSizes, containedShare);
+  } else {
+    time = roadcEstimateCalculationTime(pRoadc, pCost, engine, maxTimeInSeconds, n,
+                                        pProfile->compares, pProfile->suffixCompares, sumSizes,
+                                        numberSizes, containedShare);
+  }
+  if((maxTimeInSeconds!=ROADC_NO_TIMEOUT)&&(time>(tRoadcFloat64)maxTimeInSeconds)){
+    time = (tRoadcFloat64)maxTimeInSeconds;
+  }
+  /* concatenation */
+  return time + pCost->byte*sumSizes;
+}
+
+tRoadcByte roadcEstimate(tRoadcPtr pRoadc,
+                         tRoadcUInt32 maxTimeInSeconds,
+                         tRoadcUInt32 *pCompactedDataSize,
+                         tRoadcFloat64 *pTimeInSeconds){
+  tRoadcEstimateSamplePtr pSamples;
+  tRoadcEstimateHash hash;
+  tRoadcEstimateCost cost;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 numberSamples;
+  tRoadcUInt32 numberKeys;
+  tRoadcUInt32 gramLength;
+  tRoadcUInt32 maxOverlap;
+  tRoadcUInt32 scanStep;
+  tRoadcUInt32 numberContained;
+  tRoadcUInt32 index, s, c;
+  tRoadcUInt64 scannedBytes;
+  tRoadcUInt64 savedContained;
+  tRoadcUInt64 sumOverlapOut;
+  tRoadcUInt64 sumOverlapIn;
+  tRoadcFloat64 saved;
+  tRoadcFloat64 size;
+  tRoadcFloat64 startTime;
+  tRoadcProfile profile;
+  tRoadcFloat64 containedShare;
+  tRoadcByte engine;
+
+  if((NULL == pRoadc)||(pCompactedDataSize==NULL)||(pTimeInSeconds==NULL)){
+    return 0;
+  }
+  *pCompactedDataSize = pRoadc->roadcCurrentInputSize;
+  *pTimeInSeconds = 0.0;
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  if(numberEntries<2){
+    return 0;
+  }
+  startTime = roadcTimerNow();
+
+  /* samples at equal distances, the k-gram fits into every sampled array */
+  numberSamples = (numberEntries<ROADC_ESTIMATE_MAX_SAMPLES) ? numberEntries : ROADC_ESTIMATE_MAX_SAMPLES;
+  pSamples = (tRoadcEstimateSamplePtr)malloc(numberSamples*sizeof(tRoadcEstimateSample));
+  if(pSamples==NULL){
+    return 1;
+  }
+  gramLength = ROADC_ESTIMATE_GRAM_LENGTH;
+  index = 0;
+  s = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while((pCurrent!=NULL)&&(s<numberSamples)){
+    if(index==(tRoadcUInt32)(((tRoadcUInt64)s*numberEntries)/numberSamples)){
+      pSamples[s].pEntry = pCurrent;
+      pSamples[s].index = index;
+      pSamples[s].numberCandidates = 0;
+      pSamples[s].overlapOut = 0;
+      pSamples[s].overlapIn = 0;
+      pSamples[s].contained = 0;
+      if(pCurrent->size<gramLength){
+        gramLength = pCurrent->size;
+      }
+      s++;
+    }
+    index++;
+    pCurrent = pCurrent->pNext;
+  }
+  numberSamples = s;
+  if(gramLength==0){
+    gramLength = 1;
+  }
+
+  /* overlaps up to the length keeping the pass over all arrays short */
+  maxOverlap = (tRoadcUInt32)(ROADC_ESTIMATE_MAX_SCAN/numberEntries);
+  if(maxOverlap>ROADC_ESTIMATE_MAX_OVERLAP){
+    maxOverlap = ROADC_ESTIMATE_MAX_OVERLAP;
+  }
+  if(maxOverlap<8){
+    maxOverlap = 8;
+  }
+  numberKeys = 0;
+  for(s=0;s<numberSamples;s++){
+    numberKeys += 1 + 2*((pSamples[s].pEntry->size-1<maxOverlap) ? pSamples[s].pEntry->size-1 : maxOverlap);
+  }
+  if(roadcEstimateHashAlloc(&hash, numberKeys, maxOverlap)){
+    free(pSamples);
+    return 1;
+  }
+  roadcEstimateHashSamples(&hash, pSamples, numberSamples, gramLength, maxOverlap);
+
+  /* single pass over the arrays, every scanStep-th array for very large input */
+  scanStep = (tRoadcUInt32)(pRoadc->roadcCurrentInputSize/ROADC_ESTIMATE_MAX_SCAN) + 1;
+  scannedBytes = 0;
+  index = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  cost.byte = roadcTimerNow();
+  while(pCurrent!=NULL){
+    if((index%scanStep)==0){
+      scannedBytes += roadcEstimateScanEntry(&hash, pSamples, pCurrent, index, gramLength, maxOverlap);
+    }
+    index++;
+    pCurrent = pCurrent->pNext;
+  }
+  cost.byte = (roadcTimerNow()-cost.byte)/(tRoadcFloat64)(scannedBytes+1);
+  roadcEstimateHashFree(&hash);
+
+  /* candidates checked by the compare of the multiple removal */
+  numberContained = 0;
+  savedContained = 0;
+  sumOverlapOut = 0;
+  sumOverlapIn = 0;
+  for(s=0;s<numberSamples;s++){
+    for(c=0;(c<pSamples[s].numberCandidates)&&(!pSamples[s].contained);c++){
+      if(roadcArrayGetPosition(pSamples[s].pEntry, pSamples[s].ppCandidates[c])!=pSamples[s].ppCandidates[c]->size){
+        pSamples[s].contained = 1;
+      }
+    }
+    if(pSamples[s].contained){
+      numberContained++;
+      savedContained += pSamples[s].pEntry->size;
+    } else {
+      sumOverlapOut += pSamples[s].overlapOut;
+      sumOverlapIn += pSamples[s].overlapIn;
+    }
+  }
+  saved = (tRoadcFloat64)savedContained +
+    (tRoadcFloat64)((sumOverlapOut<sumOverlapIn) ? sumOverlapOut : sumOverlapIn);
+  size = (tRoadcFloat64)pRoadc->roadcCurrentInputSize - saved*(tRoadcFloat64)numberEntries/(tRoadcFloat64)numberSamples;
+  if(size<(tRoadcFloat64)pRoadc->pRoadcFirstDataEntry->size){
+    /* the largest array is not merged into another one */
+    size = (tRoadcFloat64)pRoadc->pRoadcFirstDataEntry->size;
+  }
+  *pCompactedDataSize = (tRoadcUInt32)size;
+  containedShare = (tRoadcFloat64)numberContained/(tRoadcFloat64)numberSamples;
+
+  roadcEstimateMeasure(pSamples, numberSamples, &cost);
+  free(pSamples);
+  roadcProfile(pRoadc, &profile);
+  *pTimeInSeconds = roadcEstimateTime(pRoadc, &cost, pRoadc->roadcEngine, maxTimeInSeconds,
+                                      &profile, containedShare);
+
+  ROADC_NOTIFICATION_MSG(pRoadc, "estimate: %lu of %lu arrays sampled, %lu contained, overlaps to successors %llu, to predecessors %llu\n",
+                         numberSamples, numberEntries, numberContained, sumOverlapOut, sumOverlapIn);
+  ROADC_NOTIFICATION_MSG(pRoadc, "estimate: time (s) per compare multiple %g, greedy %g, overlap %g, per byte %g\n",
+                         cost.contain, cost.overlap, cost.largest, cost.byte);
+  for(engine=ROADC_ENGINE_GREEDY;engine<=ROADC_ENGINE_AUTO;engine++){
+    ROADC_NOTIFICATION_MSG(pRoadc, "estimate: time (s) of engine %s: %f\n", roadcDispatchEngineName(engine),
+                           roadcEstimateTime(pRoadc, &cost, engine, maxTimeInSeconds,
+                                             &profile, containedShare));
+  }
+  ROADC_NOTIFICATION_MSG(pRoadc, "estimate time (s): %f\n", roadcTimerNow()-startTime);
+  return 0;
+}
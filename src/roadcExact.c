@@ -0,0 +1,212 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcExact.c
+ *  @brief Exact calculation for a small number of arrays.
+ *
+ *  After removing multiple arrays no array is included in another one, so
+ *  the compacted data for a given order of the arrays is smallest if every
+ *  array overlaps its predecessor as much as possible. The order with the
+ *  largest sum of overlaps is calculated by the Held-Karp dynamic program
+ *  over all subsets of arrays:
+ *
+ *    best(S, j) = max over i in S\{j}: best(S\{j}, i) + overlap(i, j)
+ *
+ *  with overlap(i, j) the largest alignment compatible overlap of array i
+ *  followed by array j (0 if not compatible). This needs O(2^n * n^2) time
+ *  and O(2^n * n) memory for n arrays.
+ */
+
+#include "roadcInternal.h"
+
+/* maximal number of arrays for the automatic selection of the exact calculation */
+#ifndef ROADC_EXACT_AUTO_MAX_ENTRIES
+#define ROADC_EXACT_AUTO_MAX_ENTRIES 16
+#endif /* ROADC_EXACT_AUTO_MAX_ENTRIES */
+/* maximal number of arrays for the exact calculation at all */
+#ifndef ROADC_EXACT_MAX_ENTRIES
+#define ROADC_EXACT_MAX_ENTRIES 20
+#endif /* ROADC_EXACT_MAX_ENTRIES */
+/* number of subsets calculated between two timeout checks */
+#define ROADC_EXACT_TIMEOUT_CHECK_SUBSETS 4096
+
+/* values of the dynamic program, 32 bit halves the memory, 
+   the sum of all array sizes has to fit */
+typedef unsigned int tRoadcExactValue;
+
+/* maximal number of arrays for the exact calculation in the exact mode, 0 if never */
+tRoadcUInt32 roadcExactMaxEntries(tRoadcPtr pRoadc){
+  if(pRoadc->roadcExactMode==ROADC_EXACT_NEVER){
+    return 0;
+  }
+  if(pRoadc->roadcExactMode==ROADC_EXACT_ALWAYS){
+    return ROADC_EXACT_MAX_ENTRIES;
+  }
+  return ROADC_EXACT_AUTO_MAX_ENTRIES;
+}
+
+tRoadcByte roadcExactIsSelected(tRoadcPtr pRoadc){
+  tRoadcUInt32 maxEntries;
+
+  if(pRoadc->roadcExactMode==ROADC_EXACT_NEVER){
+    return 0;
+  }
+  maxEntries = roadcExactMaxEntries(pRoadc);
+  if((pRoadc->roadcNumberDataEntries<2)||
+     (pRoadc->roadcNumberDataEntries>maxEntries)){
+    if(pRoadc->roadcExactMode==ROADC_EXACT_ALWAYS){
+      ROADC_NOTIFICATION_MSG(pRoadc, "no exact calculation for more than %lu arrays\n", 
+                             (tRoadcUInt32)ROADC_EXACT_MAX_ENTRIES);
+    }
+    return 0;
+  }
+  if(pRoadc->roadcCurrentInputSize>(tRoadcUInt32)UINT_MAX){
+    return 0;
+  }
+  /* dynamic program, overlap matrix, and the merged arrays */
+  if(!roadcMemoryAvailable(pRoadc, 
+                           (((tRoadcUInt64)1)<<pRoadc->roadcNumberDataEntries)*pRoadc->roadcNumberDataEntries*sizeof(tRoadcExactValue)+
+                           (tRoadcUInt64)pRoadc->roadcNumberDataEntries*pRoadc->roadcNumberDataEntries*sizeof(tRoadcUInt32)+
+                           roadcDataEntriesMemory(pRoadc),
+                           "exact calculation")){
+    return 0;
+  }
+  return 1;
+}
+
+/* calculate the order with the largest sum of overlaps into pOrder, 
+   return: 0: ok, 1: malloc error or timeout */
+tRoadcByte roadcExactOrder(tRoadcPtr pRoadc,
+                           tRoadcUInt32 maxTimeInSeconds,
+                           tRoadcDataEntryPtrPtr ppEntries,
+                           tRoadcUInt32 *pOverlaps,
+                           tRoadcExactValue *pBest,
+                           tRoadcUInt32 *pOrder){
+  tRoadcUInt32 numberEntries;
+  tRoadcExactValue value;
+  tRoadcUInt32 subset, fullSet, nextSet;
+  tRoadcUInt32 i, j, last, position;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  fullSet = (((tRoadcUInt32)1)<<numberEntries)-1;
+  for(i=0;i<numberEntries;i++){
+    if(roadcOverlapMatrixRow(ppEntries, numberEntries, i, pOverlaps)){
+      return 1;
+    }
+  }
+
+  /* best(S, j) at S*numberEntries+j, all values are reachable and start with 0 */
+  for(subset=1;subset<fullSet;subset++){
+    for(last=0;last<numberEntries;last++){
+      if((subset&(((tRoadcUInt32)1)<<last))==0){
+        continue;
+      }
+      value = pBest[subset*numberEntries+last];
+      for(j=0;j<numberEntries;j++){
+        if(subset&(((tRoadcUInt32)1)<<j)){
+          continue;
+        }
+        nextSet = subset|(((tRoadcUInt32)1)<<j);
+        if(value+pOverlaps[last*numberEntries+j]>pBest[nextSet*numberEntries+j]){
+          pBest[nextSet*numberEntries+j] = value+(tRoadcExactValue)pOverlaps[last*numberEntries+j];
+        }
+      }
+    }
+    if(((subset%ROADC_EXACT_TIMEOUT_CHECK_SUBSETS)==0)&&
+       (maxTimeInSeconds!=ROADC_NO_TIMEOUT)&&
+       (roadcTimerRead(pRoadc)>=maxTimeInSeconds)){
+      ROADC_NOTIFICATION_MSG(pRoadc, "Exact calculation stop due to elapsed time\n");
+      return 1;
+    }
+  }
+
+  /* reconstruct the order backwards from the best last array */
+  last = 0;
+  for(j=1;j<numberEntries;j++){
+    if(pBest[fullSet*numberEntries+j]>pBest[fullSet*numberEntries+last]){
+      last = j;
+    }
+  }
+  ROADC_NOTIFICATION_MSG(pRoadc, "exact sum of overlaps: %lu\n", 
+                         (tRoadcUInt32)pBest[fullSet*numberEntries+last]);
+  subset = fullSet;
+  position = numberEntries;
+  while(1){
+    position--;
+    pOrder[position] = last;
+    nextSet = subset&(~(((tRoadcUInt32)1)<<last));
+    if(nextSet==0){
+      return 0;
+    }
+    for(i=0;i<numberEntries;i++){
+      if((nextSet&(((tRoadcUInt32)1)<<i))&&
+         (pBest[nextSet*numberEntries+i]+pOverlaps[i*numberEntries+last]==pBest[subset*numberEntries+last])){
+        break;
+      }
+    }
+    subset = nextSet;
+    last = i;
+  }
+}
+
+/* merge the arrays in the exact order into pResult, return: 0: ok, 1: malloc error or timeout */
+tRoadcByte roadcExactCalculation(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds,
+                                 tRoadcPtr pResult){
+  tRoadcUInt32 numberEntries;
+  tRoadcDataEntryPtrPtr ppEntries;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 *pOverlaps;
+  tRoadcUInt32 *pOrder;
+  tRoadcExactValue *pBest;
+  tRoadcUInt32 i;
+  tRoadcByte result;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  pOverlaps = (tRoadcUInt32 *)malloc(numberEntries*numberEntries*sizeof(tRoadcUInt32));
+  pOrder = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pBest = (tRoadcExactValue *)calloc((((tRoadcUInt32)1)<<numberEntries)*numberEntries, 
+                                     sizeof(tRoadcExactValue));
+  result = 1;
+  if((ppEntries!=NULL)&&(pOverlaps!=NULL)&&(pOrder!=NULL)&&(pBest!=NULL)){
+    i = 0;
+    pCurrent = pRoadc->pRoadcFirstDataEntry;
+    while(pCurrent!=NULL){
+      ppEntries[i++] = pCurrent;
+      pCurrent = pCurrent->pNext;
+    }
+    result = roadcExactOrder(pRoadc, maxTimeInSeconds, ppEntries, pOverlaps, pBest, pOrder);
+    if(result==0){
+      result = roadcOverlapMergeOrder(ppEntries, numberEntries, pOrder, pResult);
+    }
+  }
+  free(ppEntries);
+  free(pOverlaps);
+  free(pOrder);
+  free(pBest);
+  return result;
+}
@@ -0,0 +1,432 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcLocalSearch.c
+ *  @brief Local search after the greedy calculation.
+ *
+ *  The greedy merges the arrays left after removing multiple arrays to 
+ *  chains. The merge chains are recorded during the greedy, the order of 
+ *  all arrays given by the chains is improved afterwards by moves of the
+ *  order:
+ *    - Or-opt: move a part of one to three arrays to another position,
+ *    - 2-opt: reverse a part of the order.
+ *  Moves are scored by the change of the sum of overlaps between neighbours
+ *  (overlap matrix of all pairs, alignment compatible). Moves with a better 
+ *  score are checked by building the merged arrays for the new order, a move
+ *  is only kept if the size of the compacted data shrinks.
+ */
+
+#include "roadcInternal.h"
+
+/* maximal number of arrays for the local search, the overlap matrix has one value per pair */
+#ifndef ROADC_LOCAL_SEARCH_MAX_ENTRIES
+#define ROADC_LOCAL_SEARCH_MAX_ENTRIES 1024
+#endif /* ROADC_LOCAL_SEARCH_MAX_ENTRIES */
+/* maximal number of arrays moved by an Or-opt move */
+#define ROADC_LOCAL_SEARCH_MAX_MOVE 3
+
+/* result values of a local search pass */
+#define ROADC_LOCAL_SEARCH_NO_MOVE 0
+#define ROADC_LOCAL_SEARCH_MOVE 1
+#define ROADC_LOCAL_SEARCH_STOP 2
+
+typedef struct {
+  tRoadcLocalSearchPtr pLocalSearch;
+  /* overlap of index i followed by index j at i*numberEntries+j */
+  tRoadcUInt32 *pOverlaps;
+  tRoadcUInt32 *pOrder;
+  tRoadcUInt32 *pCandidate;
+  /* merged arrays of the best order, empty while the greedy result is the best */
+  tRoadc best;
+  tRoadcUInt32 bestSize;
+  tRoadcByte withTimeout;
+  tRoadcFloat64 endTime;
+  tRoadcUInt32 numberMoves;
+  tRoadcUInt32 numberRejectedMoves;
+} tRoadcLocalSearchState;
+
+void roadcLocalSearchNew(tRoadcPtr pRoadc){
+  tRoadcLocalSearchPtr pLocalSearch;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 i;
+  void *pTmp;
+
+  pRoadc->pRoadcLocalSearch = NULL;
+  if((pRoadc->roadcLocalSearchTimeShare==0)||
+     (pRoadc->roadcNumberDataEntries<2)){
+    return;
+  }
+  if(pRoadc->roadcNumberDataEntries>ROADC_LOCAL_SEARCH_MAX_ENTRIES){
+    ROADC_NOTIFICATION_MSG(pRoadc, "no local search for more than %lu arrays\n", 
+                           (tRoadcUInt32)ROADC_LOCAL_SEARCH_MAX_ENTRIES);
+    return;
+  }
+  /* copy of the arrays and overlap matrix */
+  if(!roadcMemoryAvailable(pRoadc, 
+                           roadcDataEntriesMemory(pRoadc)+
+                           (tRoadcUInt64)pRoadc->roadcNumberDataEntries*pRoadc->roadcNumberDataEntries*sizeof(tRoadcUInt32),
+                           "local search")){
+    return;
+  }
+  pTmp = malloc(sizeof(tRoadcLocalSearch));
+  if(pTmp==NULL){
+    ROADC_NOTIFICATION_MSG(pRoadc, "local search skipped: malloc error\n");
+    return;
+  }
+  pLocalSearch = (tRoadcLocalSearchPtr)pTmp;
+  pLocalSearch->numberEntries = pRoadc->roadcNumberDataEntries;
+  pLocalSearch->ppEntries = (tRoadcDataEntryPtrPtr)calloc(pLocalSearch->numberEntries, 
+                                                          sizeof(tRoadcDataEntryPtr));
+  pLocalSearch->pChainNext = (tRoadcUInt32 *)malloc(pLocalSearch->numberEntries*sizeof(tRoadcUInt32));
+  pLocalSearch->pChainLast = (tRoadcUInt32 *)malloc(pLocalSearch->numberEntries*sizeof(tRoadcUInt32));
+  pRoadc->pRoadcLocalSearch = pLocalSearch;
+  if((pLocalSearch->ppEntries==NULL)||
+     (pLocalSearch->pChainNext==NULL)||
+     (pLocalSearch->pChainLast==NULL)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "local search skipped: malloc error\n");
+    roadcLocalSearchDelete(pRoadc);
+    return;
+  }
+  /* the data entries are indexed by roadcIndexDataEntries() */
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    i = pCurrent->index;
+    pLocalSearch->ppEntries[i] = roadcNewRoadcDataEntryByCopy(pCurrent);
+    if(pLocalSearch->ppEntries[i]==NULL){
+      ROADC_NOTIFICATION_MSG(pRoadc, "local search skipped: malloc error\n");
+      roadcLocalSearchDelete(pRoadc);
+      return;
+    }
+    pLocalSearch->pChainNext[i] = pLocalSearch->numberEntries;
+    pLocalSearch->pChainLast[i] = i;
+    pCurrent = pCurrent->pNext;
+  }
+}
+
+void roadcLocalSearchDelete(tRoadcPtr pRoadc){
+  tRoadcLocalSearchPtr pLocalSearch;
+  tRoadcUInt32 i;
+
+  pLocalSearch = pRoadc->pRoadcLocalSearch;
+  if(pLocalSearch==NULL){
+    return;
+  }
+  if(pLocalSearch->ppEntries!=NULL){
+    for(i=0;i<pLocalSearch->numberEntries;i++){
+      roadcFreeRoadcDataEntry(pLocalSearch->ppEntries[i]);
+    }
+    free(pLocalSearch->ppEntries);
+  }
+  free(pLocalSearch->pChainNext);
+  free(pLocalSearch->pChainLast);
+  free(pLocalSearch);
+  pRoadc->pRoadcLocalSearch = NULL;
+}
+
+void roadcLocalSearchRecordMerge(tRoadcPtr pRoadc,
+                                 tRoadcDataEntryPtr pLeft,
+                                 tRoadcDataEntryPtr pRight){
+  tRoadcLocalSearchPtr pLocalSearch;
+
+  pLocalSearch = pRoadc->pRoadcLocalSearch;
+  if(pLocalSearch==NULL){
+    return;
+  }
+  /* the index of a merged array is the first index of its chain */
+  pLocalSearch->pChainNext[pLocalSearch->pChainLast[pLeft->index]] = pRight->index;
+  pLocalSearch->pChainLast[pLeft->index] = pLocalSearch->pChainLast[pRight->index];
+}
+
+tRoadcByte roadcLocalSearchIsTimeout(tRoadcLocalSearchState *pState){
+  return (tRoadcByte)(pState->withTimeout && (roadcTimerNow()>=pState->endTime));
+}
+
+/* overlap of index from followed by index to, numberEntries: no neighbour */
+tRoadcUInt32 roadcLocalSearchOverlap(tRoadcLocalSearchState *pState,
+                                     tRoadcUInt32 from,
+                                     tRoadcUInt32 to){
+  tRoadcUInt32 numberEntries;
+
+  numberEntries = pState->pLocalSearch->numberEntries;
+  if((from==numberEntries)||(to==numberEntries)){
+    return 0;
+  }
+  return pState->pOverlaps[from*numberEntries+to];
+}
+
+/* return: 0: ok, 1: malloc error or timeout */
+tRoadcByte roadcLocalSearchOverlapMatrix(tRoadcLocalSearchState *pState){
+  tRoadcUInt32 i;
+
+  for(i=0;i<pState->pLocalSearch->numberEntries;i++){
+    if(roadcOverlapMatrixRow(pState->pLocalSearch->ppEntries, pState->pLocalSearch->numberEntries,
+                             i, pState->pOverlaps) ||
+       roadcLocalSearchIsTimeout(pState)){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* check the candidate order, return: ROADC_LOCAL_SEARCH_MOVE if it is kept */
+tRoadcByte roadcLocalSearchCheckCandidate(tRoadcLocalSearchState *pState){
+  tRoadc result;
+  tRoadcUInt32 size;
+  tRoadcUInt32 *pTmp;
+
+  roadcInitialize(&result);
+  if(roadcOverlapMergeOrder(pState->pLocalSearch->ppEntries, pState->pLocalSearch->numberEntries,
+                            pState->pCandidate, &result)){
+    roadcDeleteEntries(&result);
+    return ROADC_LOCAL_SEARCH_STOP;
+  }
+  size = roadcConcatenationSize(result.pRoadcFirstDataEntry);
+  if(size>=pState->bestSize){
+    roadcDeleteEntries(&result);
+    pState->numberRejectedMoves++;
+    return ROADC_LOCAL_SEARCH_NO_MOVE;
+  }
+  roadcDeleteEntries(&pState->best);
+  pState->best = result;
+  pState->bestSize = size;
+  pTmp = pState->pOrder;
+  pState->pOrder = pState->pCandidate;
+  pState->pCandidate = pTmp;
+  pState->numberMoves++;
+  return ROADC_LOCAL_SEARCH_MOVE;
+}
+
+/* move the part of length moveLength at position to the position after target */
+void roadcLocalSearchOrOptCandidate(tRoadcLocalSearchState *pState,
+                                    tRoadcUInt32 position,
+                                    tRoadcUInt32 moveLength,
+                                    tRoadcUInt32 target){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 i, j, k;
+
+  numberEntries = pState->pLocalSearch->numberEntries;
+  j = 0;
+  if(target==numberEntries){
+    /* move to the front */
+    for(k=0;k<moveLength;k++){
+      pState->pCandidate[j++] = pState->pOrder[position+k];
+    }
+  }
+  for(i=0;i<numberEntries;i++){
+    if((i>=position)&&(i<position+moveLength)){
+      continue;
+    }
+    pState->pCandidate[j++] = pState->pOrder[i];
+    if(i==target){
+      for(k=0;k<moveLength;k++){
+        pState->pCandidate[j++] = pState->pOrder[position+k];
+      }
+    }
+  }
+}
+
+tRoadcByte roadcLocalSearchOrOpt(tRoadcLocalSearchState *pState){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 *pOrder;
+  tRoadcUInt32 moveLength, position, target;
+  tRoadcUInt32 previous, next, first, last, targetLeft, targetRight;
+  tRoadcUInt32 gain, loss;
+  tRoadcByte result;
+
+  numberEntries = pState->pLocalSearch->numberEntries;
+  pOrder = pState->pOrder;
+  for(moveLength=1;(moveLength<=ROADC_LOCAL_SEARCH_MAX_MOVE)&&(moveLength<numberEntries);moveLength++){
+    for(position=0;position+moveLength<=numberEntries;position++){
+      previous = (position>0) ? pOrder[position-1] : numberEntries;
+      next = (position+moveLength<numberEntries) ? pOrder[position+moveLength] : numberEntries;
+      first = pOrder[position];
+      last = pOrder[position+moveLength-1];
+      /* target numberEntries: move to the front */
+      for(target=0;target<=numberEntries;target++){
+        if((target==numberEntries)&&(position==0)){
+          continue;
+        }
+        if((target<numberEntries)&&(target+1>=position)&&(target<position+moveLength)){
+          /* target inside or directly before the moved part */
+          continue;
+        }
+        targetLeft = (target<numberEntries) ? pOrder[target] : numberEntries;
+        if(target==numberEntries){
+          targetRight = pOrder[0];
+        } else {
+          targetRight = (target+1<numberEntries) ? pOrder[target+1] : numberEntries;
+        }
+        gain = roadcLocalSearchOverlap(pState, previous, next) +
+          roadcLocalSearchOverlap(pState, targetLeft, first) +
+          roadcLocalSearchOverlap(pState, last, targetRight);
+        loss = roadcLocalSearchOverlap(pState, previous, first) +
+          roadcLocalSearchOverlap(pState, last, next) +
+          roadcLocalSearchOverlap(pState, targetLeft, targetRight);
+        if(gain>loss){
+          roadcLocalSearchOrOptCandidate(pState, position, moveLength, target);
+          result = roadcLocalSearchCheckCandidate(pState);
+          if(result!=ROADC_LOCAL_SEARCH_NO_MOVE){
+            return result;
+          }
+          if(roadcLocalSearchIsTimeout(pState)){
+            return ROADC_LOCAL_SEARCH_STOP;
+          }
+        }
+      }
+    }
+  }
+  return ROADC_LOCAL_SEARCH_NO_MOVE;
+}
+
+tRoadcByte roadcLocalSearchTwoOpt(tRoadcLocalSearchState *pState){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 *pOrder;
+  tRoadcUInt32 i, j, k;
+  tRoadcUInt32 previous, next;
+  tRoadcUInt32 forward, backward;
+  tRoadcUInt32 gain, loss;
+  tRoadcByte result;
+
+  numberEntries = pState->pLocalSearch->numberEntries;
+  pOrder = pState->pOrder;
+  for(i=0;i+1<numberEntries;i++){
+    previous = (i>0) ? pOrder[i-1] : numberEntries;
+    /* sum of overlaps inside the reversed part in both directions */
+    forward = 0;
+    backward = 0;
+    for(j=i+1;j<numberEntries;j++){
+      forward = forward + roadcLocalSearchOverlap(pState, pOrder[j-1], pOrder[j]);
+      backward = backward + roadcLocalSearchOverlap(pState, pOrder[j], pOrder[j-1]);
+      next = (j+1<numberEntries) ? pOrder[j+1] : numberEntries;
+      gain = roadcLocalSearchOverlap(pState, previous, pOrder[j]) +
+        roadcLocalSearchOverlap(pState, pOrder[i], next) + backward;
+      loss = roadcLocalSearchOverlap(pState, previous, pOrder[i]) +
+        roadcLocalSearchOverlap(pState, pOrder[j], next) + forward;
+      if(gain>loss){
+        for(k=0;k<numberEntries;k++){
+          if((k>=i)&&(k<=j)){
+            pState->pCandidate[k] = pOrder[i+j-k];
+          } else {
+            pState->pCandidate[k] = pOrder[k];
+          }
+        }
+        result = roadcLocalSearchCheckCandidate(pState);
+        if(result!=ROADC_LOCAL_SEARCH_NO_MOVE){
+          return result;
+        }
+        if(roadcLocalSearchIsTimeout(pState)){
+          return ROADC_LOCAL_SEARCH_STOP;
+        }
+      }
+    }
+  }
+  return ROADC_LOCAL_SEARCH_NO_MOVE;
+}
+
+void roadcLocalSearchCalculation(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds){
+  tRoadcLocalSearchState state;
+  tRoadcLocalSearchPtr pLocalSearch;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 i, index;
+  tRoadcByte result;
+
+  pLocalSearch = pRoadc->pRoadcLocalSearch;
+  if((pLocalSearch==NULL)||(pRoadc->roadcNumberDataEntries==0)){
+    return;
+  }
+  numberEntries = pLocalSearch->numberEntries;
+  state.pLocalSearch = pLocalSearch;
+  state.withTimeout = (tRoadcByte)(maxTimeInSeconds!=ROADC_NO_TIMEOUT);
+  state.endTime = roadcTimerNow() + ((tRoadcFloat64)maxTimeInSeconds*
+                                     (tRoadcFloat64)pRoadc->roadcLocalSearchTimeShare)/100.0;
+  state.numberMoves = 0;
+  state.numberRejectedMoves = 0;
+  state.bestSize = roadcConcatenationSize(pRoadc->pRoadcFirstDataEntry);
+  roadcInitialize(&state.best);
+  state.pOverlaps = (tRoadcUInt32 *)malloc(numberEntries*numberEntries*sizeof(tRoadcUInt32));
+  state.pOrder = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  state.pCandidate = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  if((state.pOverlaps==NULL)||(state.pOrder==NULL)||(state.pCandidate==NULL)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "local search skipped: malloc error\n");
+    free(state.pOverlaps);
+    free(state.pOrder);
+    free(state.pCandidate);
+    return;
+  }
+
+  /* order of the greedy result: merge chains in the order of the merged arrays */
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    index = pCurrent->index;
+    while(index!=numberEntries){
+      state.pOrder[i++] = index;
+      index = pLocalSearch->pChainNext[index];
+    }
+    pCurrent = pCurrent->pNext;
+  }
+
+  result = ROADC_LOCAL_SEARCH_STOP;
+  if(!roadcLocalSearchOverlapMatrix(&state)){
+    /* merging with the largest possible overlaps may already improve the greedy result */
+    for(i=0;i<numberEntries;i++){
+      state.pCandidate[i] = state.pOrder[i];
+    }
+    result = roadcLocalSearchCheckCandidate(&state);
+  }
+  while(result!=ROADC_LOCAL_SEARCH_STOP){
+    if(roadcTargetGapReached(pRoadc, state.bestSize)){
+      ROADC_NOTIFICATION_MSG(pRoadc, "Local search stop due to target gap\n");
+      result = ROADC_LOCAL_SEARCH_STOP;
+    } else {
+      result = roadcLocalSearchOrOpt(&state);
+      if(result==ROADC_LOCAL_SEARCH_NO_MOVE){
+        result = roadcLocalSearchTwoOpt(&state);
+        if(result==ROADC_LOCAL_SEARCH_NO_MOVE){
+          /* local optimum */
+          result = ROADC_LOCAL_SEARCH_STOP;
+        }
+      }
+      if(roadcLocalSearchIsTimeout(&state)){
+        ROADC_NOTIFICATION_MSG(pRoadc, "Local search stop due to elapsed time\n");
+        result = ROADC_LOCAL_SEARCH_STOP;
+      }
+    }
+  }
+  ROADC_NOTIFICATION_MSG(pRoadc, "local search moves kept: %lu, rejected: %lu\n", 
+                         state.numberMoves, state.numberRejectedMoves);
+
+  if(state.best.roadcNumberDataEntries>0){
+    /* replace greedy result by the best order found */
+    roadcReplaceDataEntries(pRoadc, &state.best);
+    ROADC_NOTIFICATION_MSG(pRoadc, "number arrays after local search: %lu\n", pRoadc->roadcNumberDataEntries);
+  }
+  free(state.pOverlaps);
+  free(state.pOrder);
+  free(state.pCandidate);
+}
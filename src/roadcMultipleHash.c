@@ -0,0 +1,232 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcMultipleHash.c
+ *  @brief Removal of multiple arrays by hashes instead of compares.
+ *
+ *  The removal of multiple arrays compares every array with all larger
+ *  arrays, which needs O(n^2) compares for n arrays. Without padding bits
+ *  and alignment an array is removed exactly if it is part of an array
+ *  before it in the list of arrays (larger, or equal and first), and the
+ *  array containing it is not changed. So the arrays can be found by hashes:
+ *  for every size of arrays, starting with the largest size, the arrays of
+ *  this size are put into a hash table, and a rolling hash of this length
+ *  over all larger arrays left finds the arrays contained in them. Equal
+ *  arrays of the same size are found in the hash table. Every hit is
+ *  verified by a compare. This needs O(d * s) steps for d different sizes
+ *  and s bytes of all arrays, and gives the same arrays as the compares.
+ */
+
+#include <string.h>
+#include "roadcInternal.h"
+
+/* hash base */
+#define ROADC_MULTIPLE_HASH_BASE 0x100000001B3ULL
+/* empty slot of the hash table */
+#define ROADC_MULTIPLE_HASH_NONE 0xFFFFFFFFUL
+
+struct tRoadcMultipleHashStruct{
+  /* arrays in list order */
+  tRoadcDataEntryPtrPtr ppEntries;
+  tRoadcByte *pRemoved;
+  /* hashes of the arrays of the current size */
+  tRoadcUInt64 *pHash;
+  /* open addressing: index of the array */
+  tRoadcUInt32 *pSlots;
+  tRoadcUInt32 numberSlots;
+};
+
+typedef struct tRoadcMultipleHashStruct tRoadcMultipleHash;
+typedef tRoadcMultipleHash* tRoadcMultipleHashPtr;
+
+tRoadcUInt32 roadcMultipleHashSlot(tRoadcMultipleHashPtr pMultiple,
+                                   tRoadcUInt64 hash){
+  return (tRoadcUInt32)((hash ^ (hash>>31))*0x9E3779B97F4A7C15ULL>>32)&(pMultiple->numberSlots-1);
+}
+
+tRoadcUInt64 roadcMultipleHashData(tRoadcBytePtr pData,
+                                   tRoadcUInt32 size){
+  tRoadcUInt64 hash;
+  tRoadcUInt32 i;
+
+  hash = 0;
+  for(i=0;i<size;i++){
+    hash = hash*ROADC_MULTIPLE_HASH_BASE + pData[i];
+  }
+  return hash;
+}
+
+/* the first array of the size equal to the data, ROADC_MULTIPLE_HASH_NONE if none */
+tRoadcUInt32 roadcMultipleHashFind(tRoadcMultipleHashPtr pMultiple,
+                                   tRoadcUInt64 hash,
+                                   tRoadcBytePtr pData,
+                                   tRoadcUInt32 size){
+  tRoadcUInt32 slot;
+  tRoadcUInt32 index;
+
+  slot = roadcMultipleHashSlot(pMultiple, hash);
+  while(pMultiple->pSlots[slot]!=ROADC_MULTIPLE_HASH_NONE){
+    index = pMultiple->pSlots[slot];
+    if((pMultiple->pHash[index]==hash)&&
+       (memcmp(pMultiple->ppEntries[index]->pData, pData, size)==0)){
+      return index;
+    }
+    slot = (slot+1)&(pMultiple->numberSlots-1);
+  }
+  return ROADC_MULTIPLE_HASH_NONE;
+}
+
+/* arrays first..last-1 of equal size: hash table and removal of equal arrays
+   return: number of arrays left of this size */
+tRoadcUInt32 roadcMultipleHashSize(tRoadcMultipleHashPtr pMultiple,
+                                   tRoadcUInt32 first,
+                                   tRoadcUInt32 last){
+  tRoadcUInt32 i;
+  tRoadcUInt32 found;
+  tRoadcUInt32 size;
+  tRoadcUInt32 numberLeft;
+
+  size = pMultiple->ppEntries[first]->size;
+  pMultiple->numberSlots = 1;
+  while(pMultiple->numberSlots<2*(last-first)){
+    pMultiple->numberSlots *= 2;
+  }
+  for(i=0;i<pMultiple->numberSlots;i++){
+    pMultiple->pSlots[i] = ROADC_MULTIPLE_HASH_NONE;
+  }
+  numberLeft = 0;
+  for(i=first;i<last;i++){
+    pMultiple->pHash[i] = roadcMultipleHashData(pMultiple->ppEntries[i]->pData, size);
+    found = roadcMultipleHashFind(pMultiple, pMultiple->pHash[i], pMultiple->ppEntries[i]->pData, size);
+    if(found!=ROADC_MULTIPLE_HASH_NONE){
+      /* equal to an array before */
+      pMultiple->pRemoved[i] = 1;
+    } else {
+      found = roadcMultipleHashSlot(pMultiple, pMultiple->pHash[i]);
+      while(pMultiple->pSlots[found]!=ROADC_MULTIPLE_HASH_NONE){
+        found = (found+1)&(pMultiple->numberSlots-1);
+      }
+      pMultiple->pSlots[found] = i;
+      numberLeft++;
+    }
+  }
+  return numberLeft;
+}
+
+/* rolling hash of the size over the array, arrays of the size found are removed */
+void roadcMultipleHashScan(tRoadcMultipleHashPtr pMultiple,
+                           tRoadcDataEntryPtr pEntry,
+                           tRoadcUInt32 size,
+                           tRoadcUInt64 power){
+  tRoadcUInt64 hash;
+  tRoadcUInt32 found;
+  tRoadcUInt32 i;
+
+  hash = roadcMultipleHashData(pEntry->pData, size);
+  for(i=size;;i++){
+    found = roadcMultipleHashFind(pMultiple, hash, &pEntry->pData[i-size], size);
+    if(found!=ROADC_MULTIPLE_HASH_NONE){
+      pMultiple->pRemoved[found] = 1;
+    }
+    if(i==pEntry->size){
+      return;
+    }
+    hash = (hash - pEntry->pData[i-size]*power)*ROADC_MULTIPLE_HASH_BASE + pEntry->pData[i];
+  }
+}
+
+/* return: 0: ok, 1: malloc error, the arrays are unchanged */
+tRoadcByte roadcMultipleHashCalculation(tRoadcPtr pRoadc,
+                                        tRoadcUInt32 maxTimeInSeconds){
+  tRoadcMultipleHash multiple;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 first, last, i, j;
+  tRoadcUInt32 size;
+  tRoadcUInt32 elapsedTime;
+  tRoadcUInt64 power;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  multiple.ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  multiple.pRemoved = (tRoadcByte *)calloc(numberEntries, sizeof(tRoadcByte));
+  multiple.pHash = (tRoadcUInt64 *)malloc(numberEntries*sizeof(tRoadcUInt64));
+  multiple.pSlots = (tRoadcUInt32 *)malloc(4*numberEntries*sizeof(tRoadcUInt32));
+  if((multiple.ppEntries==NULL)||(multiple.pRemoved==NULL)||
+     (multiple.pHash==NULL)||(multiple.pSlots==NULL)){
+    free(multiple.ppEntries);
+    free(multiple.pRemoved);
+    free(multiple.pHash);
+    free(multiple.pSlots);
+    return 1;
+  }
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    multiple.ppEntries[i++] = pCurrent;
+    pCurrent = pCurrent->pNext;
+  }
+
+  /* sizes from the largest one, the arrays of a size follow each other in the list */
+  first = 0;
+  while(first<numberEntries){
+    size = multiple.ppEntries[first]->size;
+    last = first;
+    while((last<numberEntries)&&(multiple.ppEntries[last]->size==size)){
+      last++;
+    }
+    if((size>0)&&(roadcMultipleHashSize(&multiple, first, last)>0)){
+      power = 1;
+      for(j=1;j<size;j++){
+        power *= ROADC_MULTIPLE_HASH_BASE;
+      }
+      for(j=0;j<first;j++){
+        if(!multiple.pRemoved[j]){
+          roadcMultipleHashScan(&multiple, multiple.ppEntries[j], size, power);
+        }
+      }
+    }
+    first = last;
+    if(maxTimeInSeconds!=ROADC_NO_TIMEOUT){
+      elapsedTime = roadcTimerRead(pRoadc);
+      if(elapsedTime>=maxTimeInSeconds){
+        pRoadc->roadcStopedByTimeout=1;
+        ROADC_NOTIFICATION_MSG(pRoadc, "Multiple stop due to elapsed time: %lu\n", elapsedTime);
+        break;
+      }
+    }
+  }
+
+  for(i=0;i<numberEntries;i++){
+    if(multiple.pRemoved[i]){
+      roadcRemoveDataEntry(pRoadc, multiple.ppEntries[i]);
+    }
+  }
+  free(multiple.ppEntries);
+  free(multiple.pRemoved);
+  free(multiple.pHash);
+  free(multiple.pSlots);
+  return 0;
+}
@@ -0,0 +1,526 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcOverlap.c
+ *  @brief Bit-parallel calculation of all overlaps of two arrays.
+ *
+ *  The suffix of a left array overlaps the prefix of a right array with 
+ *  length l if both are equal, padding bits are wildcards. All overlap 
+ *  lengths of a pair are calculated in one pass by a Shift-And automaton 
+ *  with the prefix of the right array as pattern and the suffix of the left
+ *  array as text. Bit k of the state is set if the first k+1 bytes of the
+ *  right array match the text up to the current position, 64 candidate 
+ *  lengths are handled by one machine word. Padding bits are handled per 
+ *  position: the mismatching pattern positions of a text byte are the
+ *  OR of the bit planes of the not padded text bits.
+ *
+ *  The greedy asks for a single overlap length of a pair many times with 
+ *  decreasing lengths. For arrays with padding bits a compare may run long
+ *  before it fails, therefore the greedy keeps for each pair the largest 
+ *  overlap length below the last asked length (overlap memo) and only
+ *  recalculates it if this length was skipped. Whether this is cheaper
+ *  than the compares is estimated per pair by sampled compares.
+ */
+
+#include "roadcInternal.h"
+
+#define ROADC_OVERLAP_WORD_BITS 64
+#define ROADC_OVERLAP_BYTE_BITS 8
+#define ROADC_OVERLAP_NIBBLE_VALUES 16
+
+/* maximal number of arrays for the overlap memo of the greedy, 
+   the memo needs two values per ordered pair */
+#ifndef ROADC_OVERLAP_MEMO_MAX_ENTRIES
+#define ROADC_OVERLAP_MEMO_MAX_ENTRIES 1024
+#endif /* ROADC_OVERLAP_MEMO_MAX_ENTRIES */
+/* memo value of pLargest for pairs checked by compares */
+#define ROADC_OVERLAP_MEMO_COMPARE ((tRoadcUInt32)(-1))
+/* number of sampled overlap lengths to estimate the cost of the compares */
+#define ROADC_OVERLAP_SAMPLES 8
+/* estimated cost of the Shift-And step for one word relative to a single byte compare */
+#define ROADC_OVERLAP_WORD_COST 8
+
+tRoadcUInt32 roadcOverlapNumberWords(tRoadcUInt32 maxLength){
+  return (maxLength+ROADC_OVERLAP_WORD_BITS-1)/ROADC_OVERLAP_WORD_BITS;
+}
+
+tRoadcByte roadcOverlapLengths(tRoadcDataEntryPtr pLeftArray,
+                               tRoadcDataEntryPtr pRightArray,
+                               tRoadcUInt32 maxLength,
+                               tRoadcUInt64 *pLengths){
+  tRoadcUInt32 numberWords, activeWords;
+  tRoadcUInt32 i, j, k, w, textIndex;
+  tRoadcUInt64 *pBuffer;
+  tRoadcUInt64 *pPlanes;     /* [bit][value][word], mismatch if the text bit has this value */
+  tRoadcUInt64 *pNibbles;    /* [nibble][value][word], mismatch for not padded text nibbles */
+  tRoadcUInt64 *pLow;
+  tRoadcUInt64 *pHigh;
+  tRoadcUInt64 mismatch, carry, next;
+  tRoadcByte data, mask, value;
+
+  numberWords = roadcOverlapNumberWords(maxLength);
+  for(w=0;w<numberWords;w++){
+    pLengths[w] = 0;
+  }
+  if(maxLength==0){
+    return 0;
+  }
+  pBuffer = (tRoadcUInt64 *)calloc((2*ROADC_OVERLAP_BYTE_BITS+2*ROADC_OVERLAP_NIBBLE_VALUES)*numberWords,
+                                   sizeof(tRoadcUInt64));
+  if(pBuffer==NULL){
+    /* malloc error */
+    return 1;
+  }
+  pPlanes = pBuffer;
+  pNibbles = pBuffer+2*ROADC_OVERLAP_BYTE_BITS*numberWords;
+
+  /* bit planes of the pattern: a pattern bit mismatches a text bit with the other value */
+  for(k=0;k<maxLength;k++){
+    data = pRightArray->pData[k];
+    mask = roadcPaddingByteMaskGet(pRightArray, k);
+    for(j=0;j<ROADC_OVERLAP_BYTE_BITS;j++){
+      if(((mask>>j)&1)==0){
+        value = (tRoadcByte)(((data>>j)&1)^1);
+        pPlanes[(2*j+value)*numberWords+k/ROADC_OVERLAP_WORD_BITS] |= 
+          ((tRoadcUInt64)1)<<(k%ROADC_OVERLAP_WORD_BITS);
+      }
+    }
+  }
+  /* mismatches of complete nibbles without padding bits */
+  for(i=0;i<2;i++){
+    for(value=0;value<ROADC_OVERLAP_NIBBLE_VALUES;value++){
+      for(j=0;j<ROADC_OVERLAP_BYTE_BITS/2;j++){
+        pLow = &pPlanes[(2*(4*i+j)+((value>>j)&1))*numberWords];
+        pHigh = &pNibbles[(i*ROADC_OVERLAP_NIBBLE_VALUES+value)*numberWords];
+        for(w=0;w<numberWords;w++){
+          pHigh[w] |= pLow[w];
+        }
+      }
+    }
+  }
+
+  /* Shift-And over the last maxLength bytes of the left array */
+  textIndex = pLeftArray->size-maxLength;
+  for(i=0;i<maxLength;i++){
+    data = pLeftArray->pData[textIndex+i];
+    mask = roadcPaddingByteMaskGet(pLeftArray, textIndex+i);
+    /* states above bit i are still zero */
+    activeWords = i/ROADC_OVERLAP_WORD_BITS+1;
+    pLow = ((mask&0x0F)==0) ? &pNibbles[(data&0x0F)*numberWords] : NULL;
+    pHigh = ((mask&0xF0)==0) ? &pNibbles[(ROADC_OVERLAP_NIBBLE_VALUES+(data>>4))*numberWords] : NULL;
+    for(w=activeWords;w>0;w--){
+      mismatch = 0;
+      if(mask==ROADC_NO_PADDING_BITS){
+        mismatch = pLow[w-1]|pHigh[w-1];
+      } else if(mask!=ROADC_ALL_PADDING_BITS){
+        for(j=0;j<ROADC_OVERLAP_BYTE_BITS;j++){
+          if(((mask>>j)&1)==0){
+            mismatch |= pPlanes[(2*j+((data>>j)&1))*numberWords+w-1];
+          }
+        }
+      }
+      carry = (w>1) ? (pLengths[w-2]>>(ROADC_OVERLAP_WORD_BITS-1)) : 1;
+      next = ((pLengths[w-1]<<1)|carry) & (~mismatch);
+      pLengths[w-1] = next;
+    }
+  }
+  /* remove states of pattern positions above maxLength */
+  if((maxLength%ROADC_OVERLAP_WORD_BITS)!=0){
+    pLengths[numberWords-1] &= (((tRoadcUInt64)1)<<(maxLength%ROADC_OVERLAP_WORD_BITS))-1;
+  }
+  free(pBuffer);
+  return 0;
+}
+
+/* number of equal bytes of the overlap with given length, at most limit,
+   0 for an overlap larger than an array */
+tRoadcUInt32 roadcOverlapMatchLength(tRoadcDataEntryPtr pLeftArray,
+                                     tRoadcDataEntryPtr pRightArray,
+                                     tRoadcUInt32 overlap,
+                                     tRoadcUInt32 limit){
+  tRoadcUInt32 i;
+  tRoadcUInt32 leftIndex;
+  tRoadcByte mask;
+
+  if((overlap>pLeftArray->size)||(overlap>pRightArray->size)){
+    return 0;
+  }
+  leftIndex = pLeftArray->size-overlap;
+  for(i=0;(i<overlap)&&(i<limit);i++){
+    mask = (tRoadcByte)(roadcPaddingByteMaskGet(pLeftArray, leftIndex+i) |
+                        roadcPaddingByteMaskGet(pRightArray, i));
+    if((pLeftArray->pData[leftIndex+i]|mask)!=(pRightArray->pData[i]|mask)){
+      break;
+    }
+  }
+  return i;
+}
+
+/* estimate if the Shift-And is cheaper than compares for all overlaps up to maxLength */
+tRoadcByte roadcOverlapLengthsIsFaster(tRoadcDataEntryPtr pLeftArray,
+                                       tRoadcDataEntryPtr pRightArray,
+                                       tRoadcUInt32 maxLength){
+  tRoadcUInt64 costShiftAnd;
+  tRoadcUInt64 costCompare;
+  tRoadcUInt32 i;
+
+  /* every text byte updates about half of the words on average */
+  costShiftAnd = (tRoadcUInt64)ROADC_OVERLAP_WORD_COST * 
+    (tRoadcUInt64)maxLength * (tRoadcUInt64)(roadcOverlapNumberWords(maxLength)/2+1);
+  costCompare = 0;
+  for(i=0;i<ROADC_OVERLAP_SAMPLES;i++){
+    costCompare = costCompare + 1 +
+      roadcOverlapMatchLength(pLeftArray, pRightArray, 
+                              maxLength-(tRoadcUInt32)(((tRoadcUInt64)i*maxLength)/ROADC_OVERLAP_SAMPLES),
+                              maxLength);
+  }
+  costCompare = (costCompare*maxLength)/ROADC_OVERLAP_SAMPLES;
+  if(costCompare>costShiftAnd){
+    return 1;
+  }
+  return 0;
+}
+
+tRoadcUInt32 roadcOverlapLengthsLargest(tRoadcUInt64 *pLengths,
+                                        tRoadcUInt32 maxLength){
+  tRoadcUInt32 w;
+  tRoadcUInt32 bit;
+
+  w = roadcOverlapNumberWords(maxLength);
+  while(w>0){
+    if(pLengths[w-1]!=0){
+      bit = ROADC_OVERLAP_WORD_BITS-1;
+      while(((pLengths[w-1]>>bit)&1)==0){
+        bit--;
+      }
+      return (w-1)*ROADC_OVERLAP_WORD_BITS+bit+1;
+    }
+    w--;
+  }
+  return 0;
+}
+
+tRoadcUInt32 roadcOverlapLargest(tRoadcDataEntryPtr pLeftArray,
+                                 tRoadcDataEntryPtr pRightArray,
+                                 tRoadcUInt32 maxLength,
+                                 tRoadcDataEntryPtr pCalcResult,
+                                 tRoadcByte *pMallocError){
+  tRoadcUInt64 *pLengths;
+  tRoadcUInt32 length;
+
+  *pMallocError = 0;
+  if(maxLength==0){
+    return 0;
+  }
+  pLengths = (tRoadcUInt64 *)malloc(roadcOverlapNumberWords(maxLength)*sizeof(tRoadcUInt64));
+  if((pLengths==NULL)||
+     roadcOverlapLengths(pLeftArray, pRightArray, maxLength, pLengths)){
+    /* malloc error */
+    free(pLengths);
+    *pMallocError = 1;
+    return 0;
+  }
+  for(length=maxLength;length>0;length--){
+    if(((pLengths[(length-1)/ROADC_OVERLAP_WORD_BITS]>>((length-1)%ROADC_OVERLAP_WORD_BITS))&1)&&
+       roadcAlignmentMergeCalculation(pLeftArray, pRightArray, 
+                                      pLeftArray->size-length, pCalcResult)){
+      break;
+    }
+  }
+  free(pLengths);
+  if(length>0){
+    ROADC_STATISTICS_OVERLAP_HIT(length);
+  }
+  return length;
+}
+
+/* row of the overlap matrix: largest alignment compatible overlap of array row 
+   followed by array j at row*numberEntries+j, return: 0: ok, 1: malloc error */
+tRoadcByte roadcOverlapMatrixRow(tRoadcDataEntryPtrPtr ppEntries,
+                                 tRoadcUInt32 numberEntries,
+                                 tRoadcUInt32 row,
+                                 tRoadcUInt32 *pOverlaps){
+  return roadcOverlapRow(ppEntries, numberEntries, row, &pOverlaps[row*numberEntries]);
+}
+
+/* largest alignment compatible overlap of array row followed by array j at pRowOverlaps[j],
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcOverlapRow(tRoadcDataEntryPtrPtr ppEntries,
+                           tRoadcUInt32 numberEntries,
+                           tRoadcUInt32 row,
+                           tRoadcUInt32 *pRowOverlaps){
+  tRoadcDataEntry calcResult;
+  tRoadcUInt32 j;
+  tRoadcUInt32 maxLength;
+  tRoadcByte mallocError;
+
+  roadcInitDataEntry(&calcResult);
+  for(j=0;j<numberEntries;j++){
+    pRowOverlaps[j] = 0;
+    if(j==row){
+      continue;
+    }
+    maxLength = ppEntries[row]->size;
+    if(ppEntries[j]->size<maxLength){
+      maxLength = ppEntries[j]->size;
+    }
+    /* same limit as in the greedy, included arrays are already removed */
+    maxLength--;
+    pRowOverlaps[j] = roadcOverlapLargest(ppEntries[row], ppEntries[j],
+                                          maxLength, &calcResult, &mallocError);
+    if(mallocError){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* merge copies of the arrays in the given order into the data entry list of pResult, 
+   every array is merged with the largest possible overlap to the previous merged arrays,
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcOverlapMergeOrder(tRoadcDataEntryPtrPtr ppEntries,
+                                  tRoadcUInt32 numberEntries,
+                                  tRoadcUInt32 *pOrder,
+                                  tRoadcPtr pResult){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntryPtr pNext;
+  tRoadcDataEntryPtr pNewElem;
+  tRoadcDataEntry calcResult;
+  tRoadcUInt32 i;
+  tRoadcUInt32 maxLength;
+  tRoadcUInt32 overlap;
+  tRoadcByte mallocError;
+
+  roadcInitDataEntry(&calcResult);
+  pCurrent = roadcNewRoadcDataEntryByCopy(ppEntries[pOrder[0]]);
+  if(pCurrent==NULL){
+    return 1;
+  }
+  for(i=1;i<numberEntries;i++){
+    pNext = roadcNewRoadcDataEntryByCopy(ppEntries[pOrder[i]]);
+    if(pNext==NULL){
+      roadcFreeRoadcDataEntry(pCurrent);
+      return 1;
+    }
+    maxLength = pCurrent->size;
+    if(pNext->size<maxLength){
+      maxLength = pNext->size;
+    }
+    maxLength--;
+    overlap = roadcOverlapLargest(pCurrent, pNext, maxLength, &calcResult, &mallocError);
+    if(mallocError){
+      roadcFreeRoadcDataEntry(pCurrent);
+      roadcFreeRoadcDataEntry(pNext);
+      return 1;
+    }
+    if(overlap==0){
+      /* end of chain */
+      roadcInsertDataEntry(pResult, pCurrent);
+      pCurrent = pNext;
+    } else {
+      roadcAdaptInPlacePaddingByteMaskForCaseOverlap(pCurrent, pCurrent->size-overlap, 
+                                                     pNext, overlap);
+      pNewElem = roadcNewRoadcDataEntryByConcatenation(pCurrent, pNext, 
+                                                       calcResult.alignment, 
+                                                       calcResult.alignmentOffset,
+                                                       overlap);
+      roadcFreeRoadcDataEntry(pCurrent);
+      roadcFreeRoadcDataEntry(pNext);
+      if(pNewElem==NULL){
+        return 1;
+      }
+      pCurrent = pNewElem;
+    }
+  }
+  roadcInsertDataEntry(pResult, pCurrent);
+  return 0;
+}
+
+/* the data entries have to be indexed by roadcIndexDataEntries() before */
+void roadcOverlapMemoNew(tRoadcPtr pRoadc){
+  tRoadcOverlapMemoPtr pMemo;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 numberMasked;
+  void *pTmp;
+
+  pRoadc->pRoadcOverlapMemo = NULL;
+  numberMasked = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    if(pCurrent->ppPaddingByteMaskBlocks!=NULL){
+      numberMasked++;
+    }
+    pCurrent = pCurrent->pNext;
+  }
+  if(numberMasked==0){
+    /* without padding bits a compare fails fast, no memo needed */
+    return;
+  }
+  if(numberMasked>ROADC_OVERLAP_MEMO_MAX_ENTRIES){
+    /* too large, the greedy runs without memo */
+    return;
+  }
+  if(!roadcMemoryAvailable(pRoadc, 
+                           2*(tRoadcUInt64)numberMasked*numberMasked*sizeof(tRoadcUInt32)+
+                           (tRoadcUInt64)pRoadc->roadcNumberDataEntries*sizeof(tRoadcUInt32),
+                           "overlap memo")){
+    return;
+  }
+  pTmp = malloc(sizeof(tRoadcOverlapMemo));
+  if(pTmp==NULL){
+    ROADC_NOTIFICATION_MSG(pRoadc, "overlap memo skipped: malloc error\n");
+    return;
+  }
+  pMemo = (tRoadcOverlapMemoPtr)pTmp;
+  pMemo->numberIndices = numberMasked;
+  pMemo->numberEntries = pRoadc->roadcNumberDataEntries;
+  pMemo->pIndex = (tRoadcUInt32 *)malloc(pMemo->numberEntries*sizeof(tRoadcUInt32));
+  if(pMemo->pIndex==NULL){
+    ROADC_NOTIFICATION_MSG(pRoadc, "overlap memo skipped: malloc error\n");
+    free(pMemo);
+    return;
+  }
+  /* the data entries are indexed 0..numberEntries-1 in list order */
+  numberMasked = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pMemo->pIndex[pCurrent->index] = pMemo->numberIndices;
+    if(pCurrent->ppPaddingByteMaskBlocks!=NULL){
+      pMemo->pIndex[pCurrent->index] = numberMasked;
+      numberMasked++;
+    }
+    pCurrent = pCurrent->pNext;
+  }
+  /* bound 0: nothing known for this pair */
+  pMemo->pBound = (tRoadcUInt32 *)calloc(pMemo->numberIndices*pMemo->numberIndices, 
+                                         sizeof(tRoadcUInt32));
+  pMemo->pLargest = (tRoadcUInt32 *)calloc(pMemo->numberIndices*pMemo->numberIndices, 
+                                           sizeof(tRoadcUInt32));
+  pMemo->pLengths = NULL;
+  pMemo->numberLengthWords = 0;
+  if((pMemo->pBound==NULL)||(pMemo->pLargest==NULL)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "overlap memo skipped: malloc error\n");
+    free(pMemo->pBound);
+    free(pMemo->pLargest);
+    free(pMemo->pIndex);
+    free(pMemo);
+    return;
+  }
+  pRoadc->pRoadcOverlapMemo = pMemo;
+}
+
+void roadcOverlapMemoDelete(tRoadcPtr pRoadc){
+  tRoadcOverlapMemoPtr pMemo;
+
+  pMemo = pRoadc->pRoadcOverlapMemo;
+  if(pMemo==NULL){
+    return;
+  }
+  free(pMemo->pBound);
+  free(pMemo->pLargest);
+  free(pMemo->pLengths);
+  free(pMemo->pIndex);
+  free(pMemo);
+  pRoadc->pRoadcOverlapMemo = NULL;
+}
+
+/* the new element reuses the index of a removed element */
+void roadcOverlapMemoReplace(tRoadcPtr pRoadc,
+                             tRoadcDataEntryPtr pNewElem){
+  tRoadcOverlapMemoPtr pMemo;
+  tRoadcUInt32 index;
+  tRoadcUInt32 i;
+
+  pMemo = pRoadc->pRoadcOverlapMemo;
+  if(pMemo==NULL){
+    return;
+  }
+  index = pMemo->pIndex[pNewElem->index];
+  if(index==pMemo->numberIndices){
+    /* the left array had no padding bits, the new element stays out of the memo */
+    return;
+  }
+  for(i=0;i<pMemo->numberIndices;i++){
+    pMemo->pBound[index*pMemo->numberIndices+i] = 0;
+    pMemo->pBound[i*pMemo->numberIndices+index] = 0;
+  }
+}
+
+tRoadcByte roadcOverlapMemoIsOverlap(tRoadcPtr pRoadc,
+                                     tRoadcDataEntryPtr pLeftArray,
+                                     tRoadcDataEntryPtr pRightArray,
+                                     tRoadcUInt32 overlap){
+  tRoadcOverlapMemoPtr pMemo;
+  tRoadcUInt32 leftIndex;
+  tRoadcUInt32 rightIndex;
+  tRoadcUInt32 pair;
+  tRoadcUInt32 numberWords;
+  void *pTmp;
+
+  if((overlap>pLeftArray->size)||(overlap>pRightArray->size)){
+    /* the overlap is not possible, nothing to calculate */
+    return 0;
+  }
+  pMemo = pRoadc->pRoadcOverlapMemo;
+  leftIndex = pMemo->pIndex[pLeftArray->index];
+  rightIndex = pMemo->pIndex[pRightArray->index];
+  if((leftIndex==pMemo->numberIndices)||(rightIndex==pMemo->numberIndices)){
+    /* only the pairs of arrays with padding bits are in the memo */
+    return roadcIsOverlap(pLeftArray, pRightArray, overlap);
+  }
+  pair = leftIndex*pMemo->numberIndices+rightIndex;
+  if(pMemo->pBound[pair]==0){
+    if(!roadcOverlapLengthsIsFaster(pLeftArray, pRightArray, overlap)){
+      pMemo->pBound[pair] = overlap;
+      pMemo->pLargest[pair] = ROADC_OVERLAP_MEMO_COMPARE;
+    }
+  }
+  if(pMemo->pLargest[pair]==ROADC_OVERLAP_MEMO_COMPARE){
+    return roadcIsOverlap(pLeftArray, pRightArray, overlap);
+  }
+  if((pMemo->pBound[pair]==0)||
+     (overlap>pMemo->pBound[pair])||
+     (overlap<pMemo->pLargest[pair])){
+    /* unknown or the largest overlap was skipped: calculate all overlaps up to overlap */
+    numberWords = roadcOverlapNumberWords(overlap);
+    if(numberWords>pMemo->numberLengthWords){
+      pTmp = realloc(pMemo->pLengths, numberWords*sizeof(tRoadcUInt64));
+      if(pTmp==NULL){
+        /* malloc error, compare directly */
+        return roadcIsOverlap(pLeftArray, pRightArray, overlap);
+      }
+      pMemo->pLengths = (tRoadcUInt64 *)pTmp;
+      pMemo->numberLengthWords = numberWords;
+    }
+    if(roadcOverlapLengths(pLeftArray, pRightArray, overlap, pMemo->pLengths)){
+      /* malloc error, compare directly */
+      return roadcIsOverlap(pLeftArray, pRightArray, overlap);
+    }
+    pMemo->pBound[pair] = overlap;
+    pMemo->pLargest[pair] = roadcOverlapLengthsLargest(pMemo->pLengths, overlap);
+  }
+  return (tRoadcByte)(overlap==pMemo->pLargest[pair]);
+}
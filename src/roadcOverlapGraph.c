@@ -0,0 +1,228 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcOverlapGraph.c
+ *  @brief Overlap graph export and calculation for a given order.
+ *
+ *  The order of the arrays with the smallest compacted data is a shortest
+ *  Hamiltonian path in the overlap graph. With an additional start/end node
+ *  0 this is an asymmetric traveling salesman problem (ATSP) with the 
+ *  distances
+ *
+ *    0 -> j: size(j)
+ *    i -> j: size(j) - overlap(i, j)
+ *    i -> 0: 0
+ *
+ *  for the arrays i, j (1..n) after removing multiple arrays, with
+ *  overlap(i, j) the largest alignment compatible overlap of array i 
+ *  followed by array j. The length of a tour is the compacted data size 
+ *  without alignment gaps. Edges from a node to itself are forbidden, their
+ *  distance is larger than the length of any tour.
+ *
+ *  A tour optimized by an external solver is given back as order of the 
+ *  arrays. The arrays are merged in this order, every array with the 
+ *  largest alignment compatible overlap to the previous merged arrays.
+ */
+
+#include "roadcInternal.h"
+
+tRoadcUInt32 *roadcGetOverlapGraph(tRoadcPtr pRoadc,
+                                   tRoadcUInt32 maxTimeInSeconds,
+                                   tRoadcUInt32 *pDimension){
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 dimension;
+  tRoadcUInt64 graphMemory;
+  tRoadcDataEntryPtrPtr ppEntries;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 *pOverlaps;
+  tRoadcUInt32 *pGraph;
+  tRoadcUInt32 forbidden;
+  tRoadcUInt32 i, j;
+
+  *pDimension = 0;
+  if((NULL == pRoadc) || (pRoadc->roadcNumberDataEntries==0)){
+    return (tRoadcUInt32 *)NULL;
+  }
+  roadcTimerStart(pRoadc);
+  pRoadc->roadcStopedByTimeout=0;
+  if(pRoadc->roadcNumberDataEntries>1){
+    roadcCalculationMultiple(pRoadc, maxTimeInSeconds);
+    if(pRoadc->roadcStopedByTimeout){
+      return (tRoadcUInt32 *)NULL;
+    }
+  }
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  dimension = numberEntries+1;
+  /* the matrix has dimension^2 values, the size must not overflow size_t */
+  if((tRoadcUInt64)dimension>((tRoadcUInt64)((size_t)(-1))/sizeof(tRoadcUInt32))/dimension){
+    ROADC_ERROR_MSG(pRoadc, "ERROR: overlap graph of %lu arrays too large.\n", numberEntries);
+    return (tRoadcUInt32 *)NULL;
+  }
+  graphMemory = (tRoadcUInt64)dimension*dimension*sizeof(tRoadcUInt32);
+  if(!roadcMemoryAvailable(pRoadc, 
+                           graphMemory+(tRoadcUInt64)numberEntries*(sizeof(tRoadcDataEntryPtr)+sizeof(tRoadcUInt32)),
+                           "overlap graph")){
+    return (tRoadcUInt32 *)NULL;
+  }
+  ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  /* overlaps of one row, the matrix is the graph itself */
+  pOverlaps = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pGraph = (tRoadcUInt32 *)malloc((size_t)graphMemory);
+  if((ppEntries==NULL)||(pOverlaps==NULL)||(pGraph==NULL)){
+    free(ppEntries);
+    free(pOverlaps);
+    free(pGraph);
+    return (tRoadcUInt32 *)NULL;
+  }
+  forbidden = 1;
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    ppEntries[i++] = pCurrent;
+    forbidden += pCurrent->size;
+    pCurrent = pCurrent->pNext;
+  }
+  pGraph[0] = forbidden;
+  for(j=1;j<dimension;j++){
+    pGraph[j] = ppEntries[j-1]->size;
+    pGraph[j*dimension] = 0;
+  }
+  for(i=1;i<dimension;i++){
+    if(roadcOverlapRow(ppEntries, numberEntries, i-1, pOverlaps) ||
+       ((maxTimeInSeconds!=ROADC_NO_TIMEOUT)&&(roadcTimerRead(pRoadc)>=maxTimeInSeconds))){
+      /* malloc error or timeout */
+      free(ppEntries);
+      free(pOverlaps);
+      free(pGraph);
+      return (tRoadcUInt32 *)NULL;
+    }
+    for(j=1;j<dimension;j++){
+      if(i==j){
+        pGraph[(size_t)i*dimension+j] = forbidden;
+      } else {
+        pGraph[(size_t)i*dimension+j] = ppEntries[j-1]->size-pOverlaps[j-1];
+      }
+    }
+  }
+  free(ppEntries);
+  free(pOverlaps);
+  *pDimension = dimension;
+  return pGraph;
+}
+
+tRoadcByte roadcSetOrder(tRoadcPtr pRoadc,
+                         tRoadcUInt32 *pOrder,
+                         tRoadcUInt32 numberArrays){
+  tRoadcUInt32 i;
+
+  if (NULL == pRoadc) {
+    return 1;
+  }
+  free(pRoadc->pRoadcOrder);
+  pRoadc->pRoadcOrder = NULL;
+  pRoadc->roadcOrderSize = 0;
+  pRoadc->roadcOrderError = 0;
+  if((pOrder==NULL)||(numberArrays==0)){
+    /* no order */
+    return 0;
+  }
+  pRoadc->pRoadcOrder = (tRoadcUInt32 *)malloc(numberArrays*sizeof(tRoadcUInt32));
+  if(pRoadc->pRoadcOrder==NULL){
+    return 1;
+  }
+  for(i=0;i<numberArrays;i++){
+    pRoadc->pRoadcOrder[i] = pOrder[i];
+  }
+  pRoadc->roadcOrderSize = numberArrays;
+  return 0;
+}
+
+tRoadcByte roadcGetOrderError(tRoadcPtr pRoadc){
+  if (NULL == pRoadc) {
+    return 0;
+  }
+  return pRoadc->roadcOrderError;
+}
+
+/* the given order has to contain every array after removing multiple arrays once */
+tRoadcByte roadcOverlapGraphOrderIsValid(tRoadcPtr pRoadc){
+  tRoadcBytePtr pUsed;
+  tRoadcUInt32 i;
+  tRoadcByte valid;
+
+  if(pRoadc->roadcOrderSize!=pRoadc->roadcNumberDataEntries){
+    ROADC_ERROR_MSG(pRoadc, "ERROR: the given order has %lu arrays, %lu arrays are left after removing multiple arrays.\n",
+                            pRoadc->roadcOrderSize, pRoadc->roadcNumberDataEntries);
+    return 0;
+  }
+  pUsed = (tRoadcBytePtr)calloc(pRoadc->roadcOrderSize, sizeof(tRoadcByte));
+  if(pUsed==NULL){
+    return 0;
+  }
+  valid = 1;
+  for(i=0;(i<pRoadc->roadcOrderSize)&&valid;i++){
+    if((pRoadc->pRoadcOrder[i]>=pRoadc->roadcOrderSize)||pUsed[pRoadc->pRoadcOrder[i]]){
+      ROADC_ERROR_MSG(pRoadc, "ERROR: array %lu is not valid in the given order or given more than once.\n",
+                              pRoadc->pRoadcOrder[i]);
+      valid = 0;
+    } else {
+      pUsed[pRoadc->pRoadcOrder[i]] = 1;
+    }
+  }
+  free(pUsed);
+  return valid;
+}
+
+/* merge the arrays in the given order, return: 0: ok, 1: malloc error */
+tRoadcByte roadcOverlapGraphOrderCalculation(tRoadcPtr pRoadc){
+  tRoadcUInt32 numberEntries;
+  tRoadcDataEntryPtrPtr ppEntries;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadc result;
+  tRoadcUInt32 i;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  if(ppEntries==NULL){
+    return 1;
+  }
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    ppEntries[i++] = pCurrent;
+    pCurrent = pCurrent->pNext;
+  }
+  roadcInitialize(&result);
+  if(roadcOverlapMergeOrder(ppEntries, numberEntries, pRoadc->pRoadcOrder, &result)){
+    roadcDeleteEntries(&result);
+    free(ppEntries);
+    return 1;
+  }
+  free(ppEntries);
+  roadcReplaceDataEntries(pRoadc, &result);
+  ROADC_NOTIFICATION_MSG(pRoadc, "number arrays after merge in given order: %lu\n", pRoadc->roadcNumberDataEntries);
+  return 0;
+}
@@ -0,0 +1,248 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcPortfolio.c
+ *  @brief Portfolio of greedy calculations running in parallel.
+ *
+ *  The greedy calculation merges the arrays with the largest overlap first,
+ *  but arrays of equal size and overlaps of equal size to the left and to the
+ *  right are taken in a fixed order. Which order gives the smallest result
+ *  depends on the data. The portfolio runs the exact calculation, the greedy
+ *  calculation, and the local search in several roadC contexts in parallel,
+ *  one thread per context, each with its own strategy:
+ *
+ *    context 0: strategy of the calling context (incl. exact calculation
+ *               and cycle cover calculation)
+ *    context 1: right first
+ *    context 2: alignment first
+ *    context 3: alignment first, right first
+ *    context k: random order with seed k, right first for odd k
+ *
+ *  The arrays of the calling context are only read while the threads are
+ *  running, every thread copies them into its own context since the greedy
+ *  calculation changes the arrays in place. The contexts share the timer of
+ *  the calling context, so all calculations stop at the same deadline.
+ *  The smallest result is moved into the calling context, the statistics of
+ *  all contexts are added to the calling context.
+ */
+
+#include <pthread.h>
+#include "roadcInternal.h"
+
+/* maximal number of calculations of the portfolio */
+#ifndef ROADC_PORTFOLIO_MAX_SIZE
+#define ROADC_PORTFOLIO_MAX_SIZE 256
+#endif /* ROADC_PORTFOLIO_MAX_SIZE */
+
+struct tRoadcPortfolioJobStruct{
+  /* calling context, read only while the threads are running */
+  tRoadcPtr pRoadc;
+  tRoadc context;
+  tRoadcUInt32 maxTimeInSeconds;
+  tRoadcByte mallocError;
+  tRoadcByte threadStarted;
+  pthread_t thread;
+};
+
+typedef struct tRoadcPortfolioJobStruct tRoadcPortfolioJob;
+typedef tRoadcPortfolioJob* tRoadcPortfolioJobPtr;
+
+void roadcPortfolioSetStrategy(tRoadcPtr pRoadc,
+                               tRoadcPtr pContext,
+                               tRoadcUInt32 calculation){
+  switch(calculation){
+  case 0:
+    pContext->roadcStrategy = pRoadc->roadcStrategy;
+    pContext->roadcRandomState = pRoadc->roadcRandomState;
+    break;
+  case 1:
+    pContext->roadcStrategy = ROADC_STRATEGY_RIGHT_FIRST;
+    break;
+  case 2:
+    pContext->roadcStrategy = ROADC_STRATEGY_ALIGNMENT_FIRST;
+    break;
+  case 3:
+    pContext->roadcStrategy = ROADC_STRATEGY_ALIGNMENT_FIRST | ROADC_STRATEGY_RIGHT_FIRST;
+    break;
+  default:
+    pContext->roadcStrategy = ROADC_STRATEGY_RANDOM;
+    if(calculation&1){
+      pContext->roadcStrategy |= ROADC_STRATEGY_RIGHT_FIRST;
+    }
+    pContext->roadcRandomState = pRoadc->roadcRandomState + (tRoadcUInt64)calculation;
+    break;
+  }
+}
+
+void roadcPortfolioInitJob(tRoadcPtr pRoadc,
+                           tRoadcPortfolioJobPtr pJob,
+                           tRoadcUInt32 calculation,
+                           tRoadcByte engine,
+                           tRoadcUInt32 maxTimeInSeconds){
+  pJob->pRoadc = pRoadc;
+  pJob->maxTimeInSeconds = maxTimeInSeconds;
+  pJob->mallocError = 0;
+  pJob->threadStarted = 0;
+  roadcInitialize(&pJob->context);
+  roadcPortfolioSetStrategy(pRoadc, &pJob->context, calculation);
+  pJob->context.roadcLocalSearchTimeShare = pRoadc->roadcLocalSearchTimeShare;
+  pJob->context.roadcCurrentInputSize = pRoadc->roadcCurrentInputSize;
+  pJob->context.roadcStartTime = pRoadc->roadcStartTime;
+  pJob->context.roadcLowerBound = pRoadc->roadcLowerBound;
+  pJob->context.roadcTargetGap = pRoadc->roadcTargetGap;
+  /* the exact and the cycle cover result do not depend on the strategy */
+  pJob->context.roadcExactMode = ROADC_EXACT_NEVER;
+  pJob->context.roadcEngine = ROADC_ENGINE_GREEDY;
+  if(calculation==0){
+    /* the progress of the first calculation is reported */
+    pJob->context.pRoadcProgress = pRoadc->pRoadcProgress;
+    pJob->context.roadcExactMode = pRoadc->roadcExactMode;
+    pJob->context.roadcEngine = engine;
+  } else if(engine==ROADC_ENGINE_SUFFIX){
+    /* too many arrays for the greedy, the suffix greedy depends on the order of equal sizes */
+    pJob->context.roadcEngine = ROADC_ENGINE_SUFFIX;
+  }
+}
+
+void *roadcPortfolioRun(void *pArg){
+  tRoadcPortfolioJobPtr pJob;
+  tRoadcStatisticsPtr pPreviousStatistics;
+
+  pJob = (tRoadcPortfolioJobPtr)pArg;
+  pPreviousStatistics = roadcStatisticsThreadSet(&pJob->context.roadcStatistics);
+  /* value of the span: engine of the job */
+  roadcTraceBegin("portfolio job", pJob->context.roadcEngine);
+  if(roadcCopyDataEntries(pJob->pRoadc, &pJob->context) ||
+     roadcCalculationOrder(&pJob->context, pJob->maxTimeInSeconds)){
+    pJob->mallocError = 1;
+  }
+  roadcTraceEnd("portfolio job", pJob->context.roadcEngine);
+  roadcStatisticsThreadSet(pPreviousStatistics);
+  return NULL;
+}
+
+tRoadcByte roadcPortfolioCalculation(tRoadcPtr pRoadc,
+                                     tRoadcUInt32 maxTimeInSeconds){
+  tRoadcPortfolioJobPtr pJobs;
+  tRoadcUInt32 numberJobs;
+  tRoadcUInt32 i;
+  tRoadcUInt32 best;
+  tRoadcUInt32 size;
+  tRoadcUInt32 bestSize;
+  tRoadcUInt64 dataMemory;
+  tRoadcUInt64 jobMemory;
+  tRoadcUInt64 liveEntryBytes;
+  tRoadcUInt64 peakThreads;
+  tRoadcByte engine;
+
+  numberJobs = pRoadc->roadcPortfolioSize;
+  if(numberJobs>ROADC_PORTFOLIO_MAX_SIZE){
+    numberJobs = ROADC_PORTFOLIO_MAX_SIZE;
+  }
+  jobMemory = 0;
+  if(pRoadc->roadcMaxMemory>0){
+    /* every calculation needs a copy of the arrays and about the same for the merged arrays */
+    dataMemory = roadcDataEntriesMemory(pRoadc);
+    jobMemory = 0;
+    if((dataMemory>0)&&(pRoadc->roadcMaxMemory>dataMemory)){
+      jobMemory = (pRoadc->roadcMaxMemory-dataMemory)/(2*dataMemory);
+    }
+    if(jobMemory<numberJobs){
+      ROADC_NOTIFICATION_MSG(pRoadc, "memory budget: portfolio of %lu instead of %lu calculations\n", 
+                             (tRoadcUInt32)jobMemory, numberJobs);
+      numberJobs = (tRoadcUInt32)jobMemory;
+    }
+    if(numberJobs<2){
+      /* no copy at all */
+      return roadcCalculationOrder(pRoadc, maxTimeInSeconds);
+    }
+    jobMemory = (pRoadc->roadcMaxMemory-dataMemory)/numberJobs;
+  }
+  /* the same engine for all calculations */
+  engine = pRoadc->roadcEngine;
+  if(engine==ROADC_ENGINE_AUTO){
+    engine = roadcDispatchEngine(pRoadc);
+  }
+  pJobs = (tRoadcPortfolioJobPtr)malloc(numberJobs*sizeof(tRoadcPortfolioJob));
+  if(pJobs==NULL){
+    /* malloc error */
+    return 1;
+  }
+  for(i=0;i<numberJobs;i++){
+    roadcPortfolioInitJob(pRoadc, &pJobs[i], i, engine, maxTimeInSeconds);
+    /* share of the memory budget, the copy of the arrays is part of it */
+    pJobs[i].context.roadcMaxMemory = jobMemory;
+  }
+  liveEntryBytes = pRoadc->roadcStatistics.liveEntryBytes;
+  /* calculation 0 runs in the calling thread */
+  for(i=1;i<numberJobs;i++){
+    if(pthread_create(&pJobs[i].thread, NULL, roadcPortfolioRun, &pJobs[i])==0){
+      pJobs[i].threadStarted = 1;
+    }
+  }
+  roadcPortfolioRun(&pJobs[0]);
+  for(i=1;i<numberJobs;i++){
+    if(pJobs[i].threadStarted){
+      pthread_join(pJobs[i].thread, NULL);
+    } else {
+      /* no thread available, run in the calling thread */
+      roadcPortfolioRun(&pJobs[i]);
+    }
+  }
+  peakThreads = 0;
+  for(i=0;i<numberJobs;i++){
+    roadcStatisticsAddThread(&pRoadc->roadcStatistics, &pJobs[i].context.roadcStatistics, &peakThreads);
+  }
+  roadcStatisticsPeak(&pRoadc->roadcStatistics, liveEntryBytes+peakThreads);
+
+  /* smallest result, the first one for equal sizes */
+  best = numberJobs;
+  bestSize = 0;
+  for(i=0;i<numberJobs;i++){
+    if(pJobs[i].mallocError){
+      ROADC_NOTIFICATION_MSG(pRoadc, "portfolio calculation %lu: malloc error\n", i);
+      continue;
+    }
+    size = roadcConcatenationSize(pJobs[i].context.pRoadcFirstDataEntry);
+    ROADC_NOTIFICATION_MSG(pRoadc, "portfolio calculation %lu (strategy %u): size %lu\n", 
+                           i, (unsigned int)pJobs[i].context.roadcStrategy, size);
+    if((best==numberJobs)||(size<bestSize)){
+      best = i;
+      bestSize = size;
+    }
+  }
+  if(best!=numberJobs){
+    ROADC_NOTIFICATION_MSG(pRoadc, "portfolio result: calculation %lu\n", best);
+    roadcReplaceDataEntries(pRoadc, &pJobs[best].context);
+    pRoadc->roadcStopedByTimeout = pJobs[best].context.roadcStopedByTimeout;
+  }
+  for(i=0;i<numberJobs;i++){
+    roadcDeleteEntries(&pJobs[i].context);
+  }
+  free(pJobs);
+  /* malloc error if no calculation has a result */
+  return (tRoadcByte)(best==numberJobs);
+}
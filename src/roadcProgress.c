@@ -0,0 +1,94 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcProgress.c
+ *  @brief Progress of roadcCalculation() for another thread.
+ *
+ *  The calculation stores its phase, the greedy level, the number of arrays
+ *  and their bytes with relaxed atomic stores, roadcGetProgress() reads them
+ *  with relaxed atomic loads. The values are independent of each other, a
+ *  progress report does not need a consistent snapshot. The merges of the 
+ *  greedy and the removal of multiple arrays update the arrays and the bytes,
+ *  at every phase they are counted again.
+ */
+
+#include <string.h>
+#include "roadcInternal.h"
+
+void roadcProgressInit(tRoadcPtr pRoadc){
+  memset(&pRoadc->roadcProgress, 0, sizeof(tRoadcProgress));
+  pRoadc->roadcProgress.phase = ROADC_PHASE_NONE;
+  pRoadc->pRoadcProgress = &pRoadc->roadcProgress;
+}
+
+/* phase started or ended (ROADC_PHASE_NONE), the arrays are counted again */
+void roadcProgressPhase(tRoadcPtr pRoadc,
+                        tRoadcByte phase){
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 bytes;
+
+  bytes = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    bytes += pCurrent->size;
+    pCurrent = pCurrent->pNext;
+  }
+  __atomic_store_n(&pRoadc->pRoadcProgress->bytes, bytes, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRoadc->pRoadcProgress->entries, pRoadc->roadcNumberDataEntries, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRoadc->pRoadcProgress->overlapLevel, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRoadc->pRoadcProgress->phase, phase, __ATOMIC_RELAXED);
+}
+
+void roadcProgressStart(tRoadcPtr pRoadc){
+  __atomic_store_n(&pRoadc->pRoadcProgress->maxOverlapLevel, 0, __ATOMIC_RELAXED);
+  roadcProgressPhase(pRoadc, ROADC_PHASE_NONE);
+  __atomic_store_n(&pRoadc->pRoadcProgress->inputBytes, 
+                   __atomic_load_n(&pRoadc->pRoadcProgress->bytes, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
+
+/* current and first overlap length of the greedy */
+void roadcProgressLevel(tRoadcPtr pRoadc,
+                        tRoadcUInt32 level,
+                        tRoadcUInt32 maxLevel){
+  __atomic_store_n(&pRoadc->pRoadcProgress->maxOverlapLevel, maxLevel, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRoadc->pRoadcProgress->overlapLevel, level, __ATOMIC_RELAXED);
+}
+
+void roadcGetProgress(tRoadcPtr pRoadc,
+                      tRoadcProgressPtr pProgress){
+  tRoadcProgressPtr pFrom;
+
+  if((NULL == pRoadc)||(NULL == pProgress)){
+    return;
+  }
+  pFrom = &pRoadc->roadcProgress;
+  pProgress->phase = __atomic_load_n(&pFrom->phase, __ATOMIC_RELAXED);
+  pProgress->overlapLevel = __atomic_load_n(&pFrom->overlapLevel, __ATOMIC_RELAXED);
+  pProgress->maxOverlapLevel = __atomic_load_n(&pFrom->maxOverlapLevel, __ATOMIC_RELAXED);
+  pProgress->entries = __atomic_load_n(&pFrom->entries, __ATOMIC_RELAXED);
+  pProgress->inputBytes = __atomic_load_n(&pFrom->inputBytes, __ATOMIC_RELAXED);
+  pProgress->bytes = __atomic_load_n(&pFrom->bytes, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,321 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcShard.c
+ *  @brief Sharded calculation: similar arrays are calculated in parallel.
+ *
+ *  Overlaps are found mostly between related arrays, e.g. frames of the 
+ *  same animation or strings of the same language. For many arrays the 
+ *  arrays are split into shards of similar arrays, every shard is 
+ *  calculated in its own roadC context (removal of multiple arrays, exact 
+ *  calculation, greedy, local search) in its own thread, and the merged 
+ *  arrays of all shards are calculated again in the calling context to 
+ *  find the overlaps between shards.
+ *
+ *  The similarity of arrays is estimated by MinHash: for every array and
+ *  every one of ROADC_SHARD_SIGNATURE_SIZE hash functions the minimal hash
+ *  of all k-grams (ROADC_SHARD_KGRAM_SIZE bytes, padding bits cleared) is 
+ *  the signature. Arrays with many common k-grams have equal signature 
+ *  values with high probability. The arrays are sorted by signature and 
+ *  the sorted sequence is cut into shards of about equal data size, so 
+ *  similar arrays are in the same shard and all threads have similar work.
+ */
+
+#include <pthread.h>
+#include "roadcInternal.h"
+
+/* maximal number of shards */
+#ifndef ROADC_SHARD_MAX_NUMBER
+#define ROADC_SHARD_MAX_NUMBER 256
+#endif /* ROADC_SHARD_MAX_NUMBER */
+/* bytes per k-gram */
+#define ROADC_SHARD_KGRAM_SIZE 4
+/* number of hash functions of the MinHash signature */
+#define ROADC_SHARD_SIGNATURE_SIZE 4
+
+/* array with its signature and position in the data entry list */
+struct tRoadcShardEntryStruct{
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt64 signature[ROADC_SHARD_SIGNATURE_SIZE];
+  tRoadcUInt32 position;
+};
+
+typedef struct tRoadcShardEntryStruct tRoadcShardEntry;
+typedef tRoadcShardEntry* tRoadcShardEntryPtr;
+
+struct tRoadcShardJobStruct{
+  tRoadc context;
+  tRoadcUInt32 maxTimeInSeconds;
+  tRoadcByte threadStarted;
+  pthread_t thread;
+};
+
+typedef struct tRoadcShardJobStruct tRoadcShardJob;
+typedef tRoadcShardJob* tRoadcShardJobPtr;
+
+/* hash function number i of a k-gram (finalizer of splitmix64) */
+tRoadcUInt64 roadcShardHash(tRoadcUInt64 kgram,
+                            tRoadcUInt32 i){
+  tRoadcUInt64 hash;
+
+  hash = kgram + (tRoadcUInt64)(i+1)*0x9E3779B97F4A7C15ULL;
+  hash = (hash^(hash>>30))*0xBF58476D1CE4E5B9ULL;
+  hash = (hash^(hash>>27))*0x94D049BB133111EBULL;
+  return hash^(hash>>31);
+}
+
+void roadcShardSignature(tRoadcShardEntryPtr pShardEntry){
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt64 kgram;
+  tRoadcUInt64 hash;
+  tRoadcUInt32 position;
+  tRoadcUInt32 i;
+  tRoadcByte value;
+
+  pEntry = pShardEntry->pEntry;
+  for(i=0;i<ROADC_SHARD_SIGNATURE_SIZE;i++){
+    pShardEntry->signature[i] = ~(tRoadcUInt64)0;
+  }
+  kgram = 0;
+  for(position=0;position<pEntry->size;position++){
+    /* padding bits may get any value, they do not count for the similarity */
+    value = (tRoadcByte)(pEntry->pData[position] & (~roadcPaddingByteMaskGet(pEntry, position)));
+    kgram = ((kgram<<8)|value)&0xFFFFFFFFULL;
+    /* arrays shorter than a k-gram are one k-gram */
+    if((position+1<ROADC_SHARD_KGRAM_SIZE)&&(position+1<pEntry->size)){
+      continue;
+    }
+    for(i=0;i<ROADC_SHARD_SIGNATURE_SIZE;i++){
+      hash = roadcShardHash(kgram, i);
+      if(hash<pShardEntry->signature[i]){
+        pShardEntry->signature[i] = hash;
+      }
+    }
+  }
+}
+
+int roadcShardCompareSignature(const void *pA,
+                               const void *pB){
+  const tRoadcShardEntry *pEntryA;
+  const tRoadcShardEntry *pEntryB;
+  tRoadcUInt32 i;
+
+  pEntryA = (const tRoadcShardEntry *)pA;
+  pEntryB = (const tRoadcShardEntry *)pB;
+  for(i=0;i<ROADC_SHARD_SIGNATURE_SIZE;i++){
+    if(pEntryA->signature[i]!=pEntryB->signature[i]){
+      return (pEntryA->signature[i]<pEntryB->signature[i]) ? -1 : 1;
+    }
+  }
+  return (pEntryA->position<pEntryB->position) ? -1 : ((pEntryA->position>pEntryB->position) ? 1 : 0);
+}
+
+int roadcShardCompareSize(const void *pA,
+                          const void *pB){
+  tRoadcDataEntryPtr pEntryA;
+  tRoadcDataEntryPtr pEntryB;
+
+  pEntryA = *(tRoadcDataEntryPtr const *)pA;
+  pEntryB = *(tRoadcDataEntryPtr const *)pB;
+  /* largest first, equal sizes in shard order */
+  if(pEntryA->size!=pEntryB->size){
+    return (pEntryA->size>pEntryB->size) ? -1 : 1;
+  }
+  return (pEntryA->index<pEntryB->index) ? -1 : ((pEntryA->index>pEntryB->index) ? 1 : 0);
+}
+
+/* append to the end of the list, the list stays sorted if the arrays are appended largest first */
+void roadcShardAppend(tRoadcPtr pContext,
+                      tRoadcDataEntryPtr pEntry){
+  pEntry->pPrevious = pContext->pRoadcLastDataEntry;
+  pEntry->pNext = (tRoadcDataEntryPtr)NULL;
+  if(pContext->pRoadcLastDataEntry==NULL){
+    pContext->pRoadcFirstDataEntry = pEntry;
+  } else {
+    pContext->pRoadcLastDataEntry->pNext = pEntry;
+  }
+  pContext->pRoadcLastDataEntry = pEntry;
+  pContext->roadcNumberDataEntries++;
+}
+
+void roadcShardInitJob(tRoadcPtr pRoadc,
+                       tRoadcShardJobPtr pJob,
+                       tRoadcUInt32 maxTimeInSeconds){
+  pJob->maxTimeInSeconds = maxTimeInSeconds;
+  pJob->threadStarted = 0;
+  roadcInitialize(&pJob->context);
+  pJob->context.roadcStrategy = pRoadc->roadcStrategy;
+  pJob->context.roadcRandomState = pRoadc->roadcRandomState;
+  pJob->context.roadcLocalSearchTimeShare = pRoadc->roadcLocalSearchTimeShare;
+  pJob->context.roadcExactMode = pRoadc->roadcExactMode;
+  pJob->context.roadcEngine = pRoadc->roadcEngine;
+  pJob->context.roadcCurrentInputSize = pRoadc->roadcCurrentInputSize;
+  pJob->context.roadcStartTime = pRoadc->roadcStartTime;
+}
+
+void *roadcShardRun(void *pArg){
+  tRoadcShardJobPtr pJob;
+  tRoadcStatisticsPtr pPreviousStatistics;
+
+  pJob = (tRoadcShardJobPtr)pArg;
+  pPreviousStatistics = roadcStatisticsThreadSet(&pJob->context.roadcStatistics);
+  roadcTraceBegin("shard", pJob->context.roadcNumberDataEntries);
+  if(pJob->context.roadcNumberDataEntries>1){
+    roadcCalculationMultiple(&pJob->context, pJob->maxTimeInSeconds);
+  }
+  if((pJob->context.roadcStopedByTimeout==0)&&(pJob->context.roadcNumberDataEntries>1)){
+    /* on malloc error the arrays merged so far are kept */
+    roadcCalculationOrder(&pJob->context, pJob->maxTimeInSeconds);
+  }
+  roadcTraceEnd("shard", pJob->context.roadcNumberDataEntries);
+  roadcStatisticsThreadSet(pPreviousStatistics);
+  return NULL;
+}
+
+/* return: 0: ok, 1: malloc error, the arrays are unchanged */
+tRoadcByte roadcShardCalculation(tRoadcPtr pRoadc,
+                                 tRoadcUInt32 maxTimeInSeconds){
+  tRoadcShardEntryPtr pShardEntries;
+  tRoadcShardJobPtr pJobs;
+  tRoadcDataEntryPtrPtr ppResult;
+  tRoadcUInt32 *pShard;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntryPtr pNext;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 numberShards;
+  tRoadcUInt64 totalSize;
+  tRoadcUInt64 shardSize;
+  tRoadcUInt64 peakThreads;
+  tRoadcUInt32 i, shard;
+
+  numberEntries = pRoadc->roadcNumberDataEntries;
+  numberShards = pRoadc->roadcNumberShards;
+  if(numberShards>ROADC_SHARD_MAX_NUMBER){
+    numberShards = ROADC_SHARD_MAX_NUMBER;
+  }
+  pShardEntries = (tRoadcShardEntryPtr)malloc(numberEntries*sizeof(tRoadcShardEntry));
+  pShard = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  ppResult = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  pJobs = (tRoadcShardJobPtr)malloc(numberShards*sizeof(tRoadcShardJob));
+  if((pShardEntries==NULL)||(pShard==NULL)||(ppResult==NULL)||(pJobs==NULL)){
+    free(pShardEntries);
+    free(pShard);
+    free(ppResult);
+    free(pJobs);
+    return 1;
+  }
+
+  /* similar arrays next to each other */
+  totalSize = 0;
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pShardEntries[i].pEntry = pCurrent;
+    pShardEntries[i].position = i;
+    roadcShardSignature(&pShardEntries[i]);
+    totalSize += pCurrent->size;
+    i++;
+    pCurrent = pCurrent->pNext;
+  }
+  qsort(pShardEntries, numberEntries, sizeof(tRoadcShardEntry), roadcShardCompareSignature);
+  /* shards of about equal data size */
+  shard = 0;
+  shardSize = 0;
+  for(i=0;i<numberEntries;i++){
+    if((shardSize*numberShards>=totalSize*(shard+1))&&(shard+1<numberShards)){
+      shard++;
+    }
+    shardSize += pShardEntries[i].pEntry->size;
+    pShard[pShardEntries[i].position] = shard;
+  }
+  free(pShardEntries);
+
+  /* move the arrays into the shards, largest first as in the list */
+  for(shard=0;shard<numberShards;shard++){
+    roadcShardInitJob(pRoadc, &pJobs[shard], maxTimeInSeconds);
+    /* the shards have about the same data size */
+    pJobs[shard].context.roadcMaxMemory = pRoadc->roadcMaxMemory/numberShards;
+  }
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    pNext = pCurrent->pNext;
+    roadcShardAppend(&pJobs[pShard[i]].context, pCurrent);
+    i++;
+    pCurrent = pNext;
+  }
+  pRoadc->pRoadcFirstDataEntry = (tRoadcDataEntryPtr)NULL;
+  pRoadc->pRoadcLastDataEntry = (tRoadcDataEntryPtr)NULL;
+  pRoadc->roadcNumberDataEntries = 0;
+  free(pShard);
+
+  /* shard 0 runs in the calling thread */
+  for(shard=1;shard<numberShards;shard++){
+    if(pthread_create(&pJobs[shard].thread, NULL, roadcShardRun, &pJobs[shard])==0){
+      pJobs[shard].threadStarted = 1;
+    }
+  }
+  roadcShardRun(&pJobs[0]);
+  for(shard=1;shard<numberShards;shard++){
+    if(pJobs[shard].threadStarted){
+      pthread_join(pJobs[shard].thread, NULL);
+    } else {
+      /* no thread available, run in the calling thread */
+      roadcShardRun(&pJobs[shard]);
+    }
+  }
+  /* the arrays of the shards are part of the arrays of the calling context */
+  peakThreads = 0;
+  for(shard=0;shard<numberShards;shard++){
+    roadcStatisticsAddThread(&pRoadc->roadcStatistics, &pJobs[shard].context.roadcStatistics, &peakThreads);
+  }
+  roadcStatisticsPeak(&pRoadc->roadcStatistics, pRoadc->roadcStatistics.liveEntryBytes+peakThreads);
+
+  /* merged arrays of all shards back into the calling context, largest first */
+  i = 0;
+  for(shard=0;shard<numberShards;shard++){
+    ROADC_NOTIFICATION_MSG(pRoadc, "shard %lu: %lu arrays after calculation\n", 
+                           shard, pJobs[shard].context.roadcNumberDataEntries);
+    pRoadc->roadcStopedByTimeout |= pJobs[shard].context.roadcStopedByTimeout;
+    pCurrent = pJobs[shard].context.pRoadcFirstDataEntry;
+    while(pCurrent!=NULL){
+      pCurrent->index = i;
+      ppResult[i++] = pCurrent;
+      pCurrent = pCurrent->pNext;
+    }
+    pJobs[shard].context.pRoadcFirstDataEntry = (tRoadcDataEntryPtr)NULL;
+    pJobs[shard].context.pRoadcLastDataEntry = (tRoadcDataEntryPtr)NULL;
+    pJobs[shard].context.roadcNumberDataEntries = 0;
+  }
+  numberEntries = i;
+  qsort(ppResult, numberEntries, sizeof(tRoadcDataEntryPtr), roadcShardCompareSize);
+  for(i=0;i<numberEntries;i++){
+    roadcShardAppend(pRoadc, ppResult[i]);
+  }
+  free(ppResult);
+  free(pJobs);
+  return 0;
+}
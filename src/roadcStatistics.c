@@ -0,0 +1,158 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcStatistics.c
+ *  @brief Statistics of roadcCalculation().
+ *
+ *  The times of the phases are measured by roadcCalculation(). The kernels
+ *  (compares, overlaps, alignment calculation, allocation of arrays) have no
+ *  roadC context as parameter, with ROADC_STATISTICS defined they count into
+ *  the statistics of their thread: roadcCalculation() and the threads of the
+ *  portfolio and of the shards set them to the statistics of their context.
+ *  The counters of the threads are added to the calling context after the
+ *  threads are joined. The bytes of the arrays alive are counted modulo 2^64,
+ *  a thread may free arrays allocated by another thread.
+ */
+
+#include <string.h>
+#include "roadcInternal.h"
+
+#ifdef ROADC_STATISTICS
+__thread tRoadcStatisticsPtr pRoadcStatisticsThread = (tRoadcStatisticsPtr)NULL;
+#endif /* ROADC_STATISTICS */
+
+/* bytes counted modulo 2^64 above this value are negative */
+#define ROADC_STATISTICS_NEGATIVE 0x8000000000000000ULL
+
+void roadcStatisticsInit(tRoadcStatisticsPtr pStatistics){
+  memset(pStatistics, 0, sizeof(tRoadcStatistics));
+#ifdef ROADC_STATISTICS
+  pStatistics->counters = 1;
+#endif /* ROADC_STATISTICS */
+}
+
+/* statistics of the context for the calling thread, return: statistics set before */
+tRoadcStatisticsPtr roadcStatisticsStart(tRoadcPtr pRoadc){
+  roadcStatisticsInit(&pRoadc->roadcStatistics);
+#ifdef ROADC_STATISTICS
+  /* the arrays added before */
+  pRoadc->roadcStatistics.liveEntryBytes = roadcDataEntriesMemory(pRoadc);
+  pRoadc->roadcStatistics.peakEntryBytes = pRoadc->roadcStatistics.liveEntryBytes;
+#endif /* ROADC_STATISTICS */
+  return roadcStatisticsThreadSet(&pRoadc->roadcStatistics);
+}
+
+void roadcStatisticsStop(tRoadcStatisticsPtr pPrevious){
+  roadcStatisticsThreadSet(pPrevious);
+}
+
+/* statistics of the calling thread, return: statistics set before */
+tRoadcStatisticsPtr roadcStatisticsThreadSet(tRoadcStatisticsPtr pStatistics){
+#ifdef ROADC_STATISTICS
+  tRoadcStatisticsPtr pPrevious;
+
+  pPrevious = pRoadcStatisticsThread;
+  pRoadcStatisticsThread = pStatistics;
+  return pPrevious;
+#else
+  return pStatistics;
+#endif /* ROADC_STATISTICS */
+}
+
+/* counters of a thread running in parallel to other threads,
+   the peaks of the threads are summed up in *pPeakThreads */
+void roadcStatisticsAddThread(tRoadcStatisticsPtr pTo,
+                              tRoadcStatisticsPtr pFrom,
+                              tRoadcUInt64 *pPeakThreads){
+  tRoadcUInt32 i;
+
+  pTo->compares += pFrom->compares;
+  pTo->comparesRejected += pFrom->comparesRejected;
+  pTo->comparedBytes += pFrom->comparedBytes;
+  for(i=0;i<ROADC_NUMBER_OVERLAP_LEVELS;i++){
+    pTo->overlapHits[i] += pFrom->overlapHits[i];
+  }
+  pTo->alignmentCalls += pFrom->alignmentCalls;
+  pTo->merges += pFrom->merges;
+  pTo->allocations += pFrom->allocations;
+  pTo->allocatedBytes += pFrom->allocatedBytes;
+  pTo->liveEntryBytes += pFrom->liveEntryBytes;
+  *pPeakThreads += pFrom->peakEntryBytes;
+}
+
+void roadcStatisticsPeak(tRoadcStatisticsPtr pStatistics,
+                         tRoadcUInt64 bytes){
+  if((bytes<ROADC_STATISTICS_NEGATIVE)&&(bytes>pStatistics->peakEntryBytes)){
+    pStatistics->peakEntryBytes = bytes;
+  }
+}
+
+void roadcStatisticsPhase(tRoadcStatisticsPtr pStatistics,
+                          tRoadcByte phase,
+                          tRoadcFloat64 wallTime,
+                          tRoadcFloat64 cpuTime){
+  pStatistics->wallTime[phase] += wallTime;
+  pStatistics->cpuTime[phase] += cpuTime;
+}
+
+/* one compare of bytes, failed at the first byte if not equal after one byte */
+void roadcStatisticsCompare(tRoadcStatisticsPtr pStatistics,
+                            tRoadcUInt32 bytes,
+                            tRoadcByte equal){
+  pStatistics->compares++;
+  pStatistics->comparedBytes += bytes;
+  if((!equal)&&(bytes==1)){
+    pStatistics->comparesRejected++;
+  }
+}
+
+void roadcStatisticsOverlapHit(tRoadcStatisticsPtr pStatistics,
+                               tRoadcUInt32 overlap){
+  tRoadcUInt32 level;
+
+  level = 0;
+  while((overlap>1)&&(level+1<ROADC_NUMBER_OVERLAP_LEVELS)){
+    overlap = overlap>>1;
+    level++;
+  }
+  pStatistics->overlapHits[level]++;
+}
+
+void roadcStatisticsAllocation(tRoadcStatisticsPtr pStatistics,
+                               tRoadcUInt64 bytes){
+  pStatistics->allocations++;
+  pStatistics->allocatedBytes += bytes;
+  pStatistics->liveEntryBytes += bytes;
+  roadcStatisticsPeak(pStatistics, pStatistics->liveEntryBytes);
+}
+
+void roadcGetStatistics(tRoadcPtr pRoadc,
+                        tRoadcStatisticsPtr pStatistics){
+  if((NULL == pRoadc)||(NULL == pStatistics)){
+    return;
+  }
+  *pStatistics = pRoadc->roadcStatistics;
+}
@@ -0,0 +1,456 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcSuffixGreedy.c
+ *  @brief Greedy calculation in near linear time for many arrays.
+ *
+ *  The greedy calculation compares pairs of arrays, which is O(n^2) for n 
+ *  arrays even with the overlap memo. For arrays without padding bits and 
+ *  with alignment 1 the greedy merge order can be found without comparing 
+ *  pairs: all overlap lengths L are visited from the largest possible 
+ *  length down to 1. For every L the prefixes of length L of all arrays 
+ *  without predecessor are put into a hash table, and the suffix of length 
+ *  L of every array without successor is looked up in it. A found prefix 
+ *  is verified by comparing the bytes and linked as successor, unless the 
+ *  link closes a cycle of the merge chains.
+ *
+ *  The hashes are polynomial hashes mod 2^64 with an odd base. The prefix 
+ *  hash of length L is calculated from the one of length L+1 by the inverse
+ *  of the base, the suffix hash by subtracting the first byte. An array 
+ *  takes part for the lengths below its size only, so the time is 
+ *  O(total size of all arrays) expected plus sorting.
+ *
+ *  Arrays are included in no other array after removing multiple arrays,
+ *  so the overlap of a merged chain with another array is the overlap of 
+ *  the last array of the chain, and the pairs of the original arrays are 
+ *  sufficient. Arrays with padding bits or alignment are not part of this
+ *  calculation, they are merged by the greedy calculation afterwards.
+ */
+
+#include <string.h>
+#include "roadcInternal.h"
+
+/* odd base of the polynomial hash, invertible mod 2^64 */
+#define ROADC_SUFFIX_HASH_BASE 0x100000001B3ULL
+/* no array */
+#define ROADC_SUFFIX_NONE 0xFFFFFFFFUL
+
+struct tRoadcSuffixStruct{
+  tRoadcUInt32 numberEntries;
+  /* arrays without padding bits and alignment, largest first */
+  tRoadcDataEntryPtrPtr ppEntries;
+  /* hash of the prefix and of the suffix of the current length */
+  tRoadcUInt64 *pPrefixHash;
+  tRoadcUInt64 *pSuffixHash;
+  /* powers of the hash base up to the largest size */
+  tRoadcUInt64 *pPower;
+  /* merge links: successor, predecessor, and overlap to the successor */
+  tRoadcUInt32 *pSuccessor;
+  tRoadcUInt32 *pPredecessor;
+  tRoadcUInt32 *pOverlap;
+  /* for the first array of a chain the last one and vice versa */
+  tRoadcUInt32 *pChainEnd;
+  /* hash table of the prefixes, bucket valid if its stamp is the current length */
+  tRoadcUInt32 numberBuckets;
+  tRoadcUInt32 *pBucketFirst;
+  tRoadcUInt32 *pBucketStamp;
+  tRoadcUInt32 *pBucketNext;
+};
+
+typedef struct tRoadcSuffixStruct tRoadcSuffix;
+typedef tRoadcSuffix* tRoadcSuffixPtr;
+
+/* entry of the new data entry list, sorted by size and by position in the old list */
+struct tRoadcSuffixResultStruct{
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt32 position;
+};
+
+typedef struct tRoadcSuffixResultStruct tRoadcSuffixResult;
+typedef tRoadcSuffixResult* tRoadcSuffixResultPtr;
+
+tRoadcByte roadcSuffixIsPossible(tRoadcDataEntryPtr pEntry){
+  return (tRoadcByte)((pEntry->ppPaddingByteMaskBlocks==NULL)&&
+                      (pEntry->alignment==1)&&(pEntry->alignmentOffset==0));
+}
+
+void roadcSuffixFree(tRoadcSuffixPtr pSuffix){
+  free(pSuffix->ppEntries);
+  free(pSuffix->pPrefixHash);
+  free(pSuffix->pSuffixHash);
+  free(pSuffix->pPower);
+  free(pSuffix->pSuccessor);
+  free(pSuffix->pPredecessor);
+  free(pSuffix->pOverlap);
+  free(pSuffix->pChainEnd);
+  free(pSuffix->pBucketFirst);
+  free(pSuffix->pBucketStamp);
+  free(pSuffix->pBucketNext);
+}
+
+/* return: 0: ok, 1: malloc error */
+tRoadcByte roadcSuffixAlloc(tRoadcSuffixPtr pSuffix,
+                            tRoadcUInt32 numberEntries,
+                            tRoadcUInt32 maxSize){
+  tRoadcUInt32 i;
+
+  pSuffix->numberEntries = numberEntries;
+  pSuffix->numberBuckets = 1;
+  while(pSuffix->numberBuckets<2*numberEntries){
+    pSuffix->numberBuckets <<= 1;
+  }
+  pSuffix->ppEntries = (tRoadcDataEntryPtrPtr)malloc(numberEntries*sizeof(tRoadcDataEntryPtr));
+  pSuffix->pPrefixHash = (tRoadcUInt64 *)malloc(numberEntries*sizeof(tRoadcUInt64));
+  pSuffix->pSuffixHash = (tRoadcUInt64 *)malloc(numberEntries*sizeof(tRoadcUInt64));
+  pSuffix->pPower = (tRoadcUInt64 *)malloc((maxSize+1)*sizeof(tRoadcUInt64));
+  pSuffix->pSuccessor = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pSuffix->pPredecessor = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pSuffix->pOverlap = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pSuffix->pChainEnd = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  pSuffix->pBucketFirst = (tRoadcUInt32 *)malloc(pSuffix->numberBuckets*sizeof(tRoadcUInt32));
+  /* stamp 0: no length, all buckets empty */
+  pSuffix->pBucketStamp = (tRoadcUInt32 *)calloc(pSuffix->numberBuckets, sizeof(tRoadcUInt32));
+  pSuffix->pBucketNext = (tRoadcUInt32 *)malloc(numberEntries*sizeof(tRoadcUInt32));
+  if((pSuffix->ppEntries==NULL)||(pSuffix->pPrefixHash==NULL)||(pSuffix->pSuffixHash==NULL)||
+     (pSuffix->pPower==NULL)||(pSuffix->pSuccessor==NULL)||(pSuffix->pPredecessor==NULL)||
+     (pSuffix->pOverlap==NULL)||(pSuffix->pChainEnd==NULL)||(pSuffix->pBucketFirst==NULL)||
+     (pSuffix->pBucketStamp==NULL)||(pSuffix->pBucketNext==NULL)){
+    roadcSuffixFree(pSuffix);
+    return 1;
+  }
+  pSuffix->pPower[0] = 1;
+  for(i=1;i<=maxSize;i++){
+    pSuffix->pPower[i] = pSuffix->pPower[i-1]*ROADC_SUFFIX_HASH_BASE;
+  }
+  for(i=0;i<numberEntries;i++){
+    pSuffix->pSuccessor[i] = ROADC_SUFFIX_NONE;
+    pSuffix->pPredecessor[i] = ROADC_SUFFIX_NONE;
+    pSuffix->pOverlap[i] = 0;
+    pSuffix->pChainEnd[i] = i;
+  }
+  return 0;
+}
+
+/* inverse of the odd hash base mod 2^64 by Newton iteration */
+tRoadcUInt64 roadcSuffixHashBaseInverse(void){
+  tRoadcUInt64 inverse;
+  tRoadcUInt32 i;
+
+  inverse = ROADC_SUFFIX_HASH_BASE;
+  for(i=0;i<6;i++){
+    inverse *= 2-ROADC_SUFFIX_HASH_BASE*inverse;
+  }
+  return inverse;
+}
+
+/* hashes of the prefix and the suffix of the given length, used when the array takes part first */
+void roadcSuffixHashInit(tRoadcSuffixPtr pSuffix,
+                         tRoadcUInt32 i,
+                         tRoadcUInt32 length){
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt64 prefixHash;
+  tRoadcUInt64 suffixHash;
+  tRoadcUInt32 k;
+
+  pEntry = pSuffix->ppEntries[i];
+  prefixHash = 0;
+  suffixHash = 0;
+  for(k=0;k<length;k++){
+    prefixHash = prefixHash*ROADC_SUFFIX_HASH_BASE + pEntry->pData[k];
+    suffixHash = suffixHash*ROADC_SUFFIX_HASH_BASE + pEntry->pData[pEntry->size-length+k];
+  }
+  pSuffix->pPrefixHash[i] = prefixHash;
+  pSuffix->pSuffixHash[i] = suffixHash;
+}
+
+/* link the arrays with overlap of the given length, the arrays taking part are 0..numberActive-1 */
+void roadcSuffixLinkLength(tRoadcSuffixPtr pSuffix,
+                           tRoadcUInt32 numberActive,
+                           tRoadcUInt32 length){
+  tRoadcDataEntryPtr pLeft;
+  tRoadcUInt32 mask;
+  tRoadcUInt32 bucket;
+  tRoadcUInt32 i, j;
+  tRoadcUInt32 first, last;
+
+  mask = pSuffix->numberBuckets-1;
+  for(j=0;j<numberActive;j++){
+    if(pSuffix->pPredecessor[j]==ROADC_SUFFIX_NONE){
+      bucket = (tRoadcUInt32)(pSuffix->pPrefixHash[j]&mask);
+      if(pSuffix->pBucketStamp[bucket]!=length){
+        pSuffix->pBucketStamp[bucket] = length;
+        pSuffix->pBucketFirst[bucket] = ROADC_SUFFIX_NONE;
+      }
+      pSuffix->pBucketNext[j] = pSuffix->pBucketFirst[bucket];
+      pSuffix->pBucketFirst[bucket] = j;
+    }
+  }
+  for(i=0;i<numberActive;i++){
+    if(pSuffix->pSuccessor[i]!=ROADC_SUFFIX_NONE){
+      continue;
+    }
+    bucket = (tRoadcUInt32)(pSuffix->pSuffixHash[i]&mask);
+    if(pSuffix->pBucketStamp[bucket]!=length){
+      continue;
+    }
+    pLeft = pSuffix->ppEntries[i];
+    /* the first array of the chain ending with i closes a cycle */
+    first = pSuffix->pChainEnd[i];
+    for(j=pSuffix->pBucketFirst[bucket];j!=ROADC_SUFFIX_NONE;j=pSuffix->pBucketNext[j]){
+      if((pSuffix->pPredecessor[j]==ROADC_SUFFIX_NONE)&&(j!=first)&&
+         (pSuffix->pPrefixHash[j]==pSuffix->pSuffixHash[i])&&
+         (memcmp(&pLeft->pData[pLeft->size-length], pSuffix->ppEntries[j]->pData, length)==0)){
+        last = pSuffix->pChainEnd[j];
+        pSuffix->pSuccessor[i] = j;
+        pSuffix->pPredecessor[j] = i;
+        pSuffix->pOverlap[i] = length;
+        pSuffix->pChainEnd[first] = last;
+        pSuffix->pChainEnd[last] = first;
+        break;
+      }
+    }
+  }
+}
+
+/* return: 0: ok, 1: timeout */
+tRoadcByte roadcSuffixLink(tRoadcPtr pRoadc,
+                           tRoadcUInt32 maxTimeInSeconds,
+                           tRoadcSuffixPtr pSuffix){
+  tRoadcDataEntryPtr pEntry;
+  tRoadcUInt64 inverse;
+  tRoadcUInt32 numberActive;
+  tRoadcUInt32 length;
+  tRoadcUInt32 i;
+
+  inverse = roadcSuffixHashBaseInverse();
+  numberActive = 0;
+  for(length=pSuffix->ppEntries[0]->size-1;length>0;length--){
+    /* shorten the hashes of the arrays taking part already */
+    for(i=0;i<numberActive;i++){
+      pEntry = pSuffix->ppEntries[i];
+      pSuffix->pPrefixHash[i] = (pSuffix->pPrefixHash[i]-pEntry->pData[length])*inverse;
+      pSuffix->pSuffixHash[i] -= pEntry->pData[pEntry->size-length-1]*pSuffix->pPower[length];
+    }
+    /* an array takes part for overlaps below its size */
+    while((numberActive<pSuffix->numberEntries)&&
+          (pSuffix->ppEntries[numberActive]->size>length)){
+      roadcSuffixHashInit(pSuffix, numberActive, length);
+      numberActive++;
+    }
+    roadcSuffixLinkLength(pSuffix, numberActive, length);
+    if((maxTimeInSeconds!=ROADC_NO_TIMEOUT)&&
+       (roadcTimerRead(pRoadc)>=maxTimeInSeconds)){
+      pRoadc->roadcStopedByTimeout=1;
+      ROADC_NOTIFICATION_MSG(pRoadc, "Suffix greedy stop due to elapsed time\n");
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* new data entry of the chain starting with i, NULL on malloc error */
+tRoadcDataEntryPtr roadcSuffixMergeChain(tRoadcSuffixPtr pSuffix,
+                                         tRoadcUInt32 i){
+  tRoadcDataEntryPtr pElem;
+  tRoadcUInt32 size;
+  tRoadcUInt32 position;
+  tRoadcUInt32 j;
+
+  size = 0;
+  for(j=i;j!=ROADC_SUFFIX_NONE;j=pSuffix->pSuccessor[j]){
+    size += pSuffix->ppEntries[j]->size-pSuffix->pOverlap[j];
+  }
+  pElem = (tRoadcDataEntryPtr)malloc(sizeof(tRoadcDataEntry));
+  if(pElem==NULL){
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  roadcInitDataEntry(pElem);
+  pElem->pData = (tRoadcBytePtr)malloc(size*sizeof(tRoadcByte));
+  if(pElem->pData==NULL){
+    free(pElem);
+    return (tRoadcDataEntryPtr)NULL;
+  }
+  ROADC_STATISTICS_ALLOCATION(sizeof(tRoadcDataEntry));
+  ROADC_STATISTICS_ALLOCATION(size);
+  pElem->size = size;
+  position = 0;
+  for(j=i;j!=ROADC_SUFFIX_NONE;j=pSuffix->pSuccessor[j]){
+    if(j!=i){
+      ROADC_STATISTICS_ADD(merges, 1);
+      roadcTraceInstant("merge", pSuffix->pOverlap[j]);
+    }
+    if(pSuffix->pOverlap[j]>0){
+      ROADC_STATISTICS_OVERLAP_HIT(pSuffix->pOverlap[j]);
+    }
+    memcpy(&pElem->pData[position], pSuffix->ppEntries[j]->pData, 
+           pSuffix->ppEntries[j]->size-pSuffix->pOverlap[j]);
+    position += pSuffix->ppEntries[j]->size-pSuffix->pOverlap[j];
+  }
+  return pElem;
+}
+
+int roadcSuffixCompareResult(const void *pA,
+                             const void *pB){
+  const tRoadcSuffixResult *pResultA;
+  const tRoadcSuffixResult *pResultB;
+
+  pResultA = (const tRoadcSuffixResult *)pA;
+  pResultB = (const tRoadcSuffixResult *)pB;
+  if(pResultA->pEntry->size!=pResultB->pEntry->size){
+    return (pResultA->pEntry->size>pResultB->pEntry->size) ? -1 : 1;
+  }
+  return (pResultA->position<pResultB->position) ? -1 : ((pResultA->position>pResultB->position) ? 1 : 0);
+}
+
+/* replace the data entry list by the merged chains and the other arrays, 
+   return: 0: ok, 1: malloc error */
+tRoadcByte roadcSuffixReplace(tRoadcPtr pRoadc,
+                              tRoadcSuffixPtr pSuffix){
+  tRoadcSuffixResultPtr pResult;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcDataEntryPtr pElem;
+  tRoadcUInt32 numberResults;
+  tRoadcUInt32 i, j;
+
+  pResult = (tRoadcSuffixResultPtr)malloc(pRoadc->roadcNumberDataEntries*sizeof(tRoadcSuffixResult));
+  if(pResult==NULL){
+    return 1;
+  }
+  /* the merged chains take the position of their first array */
+  numberResults = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    if(!roadcSuffixIsPossible(pCurrent)){
+      pResult[numberResults].pEntry = pCurrent;
+      pResult[numberResults].position = numberResults;
+      numberResults++;
+    } else {
+      i = pCurrent->index;
+      if(pSuffix->pPredecessor[i]==ROADC_SUFFIX_NONE){
+        pElem = pCurrent;
+        if(pSuffix->pSuccessor[i]!=ROADC_SUFFIX_NONE){
+          pElem = roadcSuffixMergeChain(pSuffix, i);
+          if(pElem==NULL){
+            for(j=0;j<numberResults;j++){
+              if(roadcSuffixIsPossible(pResult[j].pEntry)&&
+                 (pSuffix->ppEntries[pResult[j].pEntry->index]!=pResult[j].pEntry)){
+                roadcFreeRoadcDataEntry(pResult[j].pEntry);
+              }
+            }
+            free(pResult);
+            return 1;
+          }
+          /* index of the first array, needed until the old arrays are freed */
+          pElem->index = i;
+        }
+        pResult[numberResults].pEntry = pElem;
+        pResult[numberResults].position = numberResults;
+        numberResults++;
+      }
+    }
+    pCurrent = pCurrent->pNext;
+  }
+  /* free the merged arrays */
+  for(i=0;i<pSuffix->numberEntries;i++){
+    if((pSuffix->pPredecessor[i]!=ROADC_SUFFIX_NONE)||(pSuffix->pSuccessor[i]!=ROADC_SUFFIX_NONE)){
+      roadcFreeRoadcDataEntry(pSuffix->ppEntries[i]);
+    }
+  }
+  qsort(pResult, numberResults, sizeof(tRoadcSuffixResult), roadcSuffixCompareResult);
+  for(i=0;i<numberResults;i++){
+    pElem = pResult[i].pEntry;
+    pElem->index = i;
+    pElem->pPrevious = (i>0) ? pResult[i-1].pEntry : (tRoadcDataEntryPtr)NULL;
+    pElem->pNext = (i+1<numberResults) ? pResult[i+1].pEntry : (tRoadcDataEntryPtr)NULL;
+  }
+  pRoadc->pRoadcFirstDataEntry = pResult[0].pEntry;
+  pRoadc->pRoadcLastDataEntry = pResult[numberResults-1].pEntry;
+  pRoadc->roadcNumberDataEntries = numberResults;
+  free(pResult);
+  return 0;
+}
+
+/* return: 0: all arrays are merged, 1: arrays with padding bits or alignment are left 
+   for the greedy calculation (or malloc error, the arrays are unchanged) */
+tRoadcByte roadcSuffixGreedyCalculation(tRoadcPtr pRoadc,
+                                        tRoadcUInt32 maxTimeInSeconds){
+  tRoadcSuffix suffix;
+  tRoadcDataEntryPtr pCurrent;
+  tRoadcUInt32 numberAllEntries;
+  tRoadcUInt32 numberEntries;
+  tRoadcUInt32 maxSize;
+  tRoadcUInt64 totalSize;
+  tRoadcUInt32 i;
+
+  numberAllEntries = pRoadc->roadcNumberDataEntries;
+  numberEntries = 0;
+  maxSize = 0;
+  totalSize = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    if(roadcSuffixIsPossible(pCurrent)){
+      numberEntries++;
+      totalSize += pCurrent->size;
+      if(pCurrent->size>maxSize){
+        maxSize = pCurrent->size;
+      }
+    }
+    pCurrent = pCurrent->pNext;
+  }
+  ROADC_NOTIFICATION_MSG(pRoadc, "suffix greedy: %lu of %lu arrays without padding bits and alignment\n", 
+                         numberEntries, numberAllEntries);
+  if((numberEntries<2)||(maxSize<2)){
+    return 1;
+  }
+  /* hashes, links and buckets, and the merged arrays before the arrays are freed */
+  if(!roadcMemoryAvailable(pRoadc, (tRoadcUInt64)numberEntries*96+(tRoadcUInt64)(maxSize+1)*sizeof(tRoadcUInt64)+totalSize,
+                           "suffix greedy")){
+    return 1;
+  }
+  if(roadcSuffixAlloc(&suffix, numberEntries, maxSize)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "suffix greedy skipped: malloc error\n");
+    return 1;
+  }
+  i = 0;
+  pCurrent = pRoadc->pRoadcFirstDataEntry;
+  while(pCurrent!=NULL){
+    /* the list is sorted by size, largest first */
+    if(roadcSuffixIsPossible(pCurrent)){
+      pCurrent->index = i;
+      suffix.ppEntries[i++] = pCurrent;
+    }
+    pCurrent = pCurrent->pNext;
+  }
+  /* on timeout the chains linked so far are merged */
+  roadcSuffixLink(pRoadc, maxTimeInSeconds, &suffix);
+  if(roadcSuffixReplace(pRoadc, &suffix)){
+    ROADC_NOTIFICATION_MSG(pRoadc, "suffix greedy skipped: malloc error\n");
+    roadcSuffixFree(&suffix);
+    return 1;
+  }
+  roadcSuffixFree(&suffix);
+  return (tRoadcByte)(numberEntries<numberAllEntries);
+}
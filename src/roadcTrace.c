@@ -0,0 +1,177 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcTrace.c
+ *  @brief Trace events of the phases of roadC and of the application.
+ *
+ *  The events of all threads and all contexts are recorded into one 
+ *  process-wide array protected by a mutex, the events are rare compared to the work between them (phases,
+ *  greedy levels, merges). Every thread gets its own number at its first 
+ *  event. With <sys/sdt.h> (Linux, systemtap-sdt-dev) every event is also a
+ *  USDT probe, e.g. bpftrace -e 'usdt:./compactor:roadc:begin { ... }'.
+ *  A probe not attached is a single no operation instruction.
+ */
+
+#include <pthread.h>
+#include "roadcInternal.h"
+
+#if defined(__linux__) && defined(__has_include) && !defined(ROADC_NO_USDT)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define ROADC_USDT
+#endif
+#endif
+
+/* initial number of events, doubled if full */
+#define ROADC_TRACE_INITIAL_EVENTS 4096
+
+/* the trace is process-wide, shared by all roadC contexts */
+static pthread_mutex_t roadcTraceMutex = PTHREAD_MUTEX_INITIALIZER;
+/* changed with the mutex, read without it by atomic loads */
+static tRoadcByte roadcTraceRecording = 0;
+static tRoadcByte roadcTraceComplete = 1;
+static tRoadcTraceEventPtr pRoadcTraceEvents = (tRoadcTraceEventPtr)NULL;
+static tRoadcUInt32 roadcTraceNumberEvents = 0;
+static tRoadcUInt32 roadcTraceMaxEvents = 0;
+static tRoadcFloat64 roadcTraceStartTime = 0.0;
+/* numbers of the threads are unique in the process, also over several traces */
+static tRoadcUInt32 roadcTraceNumberThreads = 0;
+static __thread tRoadcUInt32 roadcTraceThread = 0;
+
+void roadcTraceStart(void){
+  pthread_mutex_lock(&roadcTraceMutex);
+  if(pRoadcTraceEvents!=NULL){
+    free(pRoadcTraceEvents);
+  }
+  pRoadcTraceEvents = (tRoadcTraceEventPtr)NULL;
+  roadcTraceNumberEvents = 0;
+  roadcTraceMaxEvents = 0;
+  roadcTraceComplete = 1;
+  roadcTraceStartTime = roadcTimerNow();
+  __atomic_store_n(&roadcTraceRecording, 1, __ATOMIC_RELAXED);
+  pthread_mutex_unlock(&roadcTraceMutex);
+}
+
+void roadcTraceStop(void){
+  pthread_mutex_lock(&roadcTraceMutex);
+  __atomic_store_n(&roadcTraceRecording, 0, __ATOMIC_RELAXED);
+  if(pRoadcTraceEvents!=NULL){
+    free(pRoadcTraceEvents);
+  }
+  pRoadcTraceEvents = (tRoadcTraceEventPtr)NULL;
+  roadcTraceNumberEvents = 0;
+  roadcTraceMaxEvents = 0;
+  pthread_mutex_unlock(&roadcTraceMutex);
+}
+
+void roadcTraceRecord(char type,
+                      const char *pName,
+                      tRoadcUInt32 value){
+  tRoadcTraceEventPtr pTmp;
+  tRoadcFloat64 time;
+
+  time = roadcTimerNow();
+  pthread_mutex_lock(&roadcTraceMutex);
+  if(!roadcTraceRecording){
+    pthread_mutex_unlock(&roadcTraceMutex);
+    return;
+  }
+  if(roadcTraceNumberEvents==roadcTraceMaxEvents){
+    if(roadcTraceMaxEvents==0){
+      roadcTraceMaxEvents = ROADC_TRACE_INITIAL_EVENTS;
+    } else {
+      roadcTraceMaxEvents = 2*roadcTraceMaxEvents;
+    }
+    pTmp = (tRoadcTraceEventPtr)realloc(pRoadcTraceEvents, roadcTraceMaxEvents*sizeof(tRoadcTraceEvent));
+    if(pTmp==NULL){
+      /* the events so far are kept */
+      roadcTraceMaxEvents = roadcTraceNumberEvents;
+      roadcTraceComplete = 0;
+      __atomic_store_n(&roadcTraceRecording, 0, __ATOMIC_RELAXED);
+      pthread_mutex_unlock(&roadcTraceMutex);
+      return;
+    }
+    pRoadcTraceEvents = pTmp;
+  }
+  if(roadcTraceThread==0){
+    roadcTraceNumberThreads++;
+    roadcTraceThread = roadcTraceNumberThreads;
+  }
+  pRoadcTraceEvents[roadcTraceNumberEvents].pName = pName;
+  pRoadcTraceEvents[roadcTraceNumberEvents].value = value;
+  pRoadcTraceEvents[roadcTraceNumberEvents].thread = roadcTraceThread;
+  pRoadcTraceEvents[roadcTraceNumberEvents].time = time-roadcTraceStartTime;
+  pRoadcTraceEvents[roadcTraceNumberEvents].type = type;
+  roadcTraceNumberEvents++;
+  pthread_mutex_unlock(&roadcTraceMutex);
+}
+
+void roadcTraceBegin(const char *pName,
+                     tRoadcUInt32 value){
+#ifdef ROADC_USDT
+  DTRACE_PROBE2(roadc, begin, pName, value);
+#endif /* ROADC_USDT */
+  /* the flag is only changed with the mutex, checked again with it */
+  if(__atomic_load_n(&roadcTraceRecording, __ATOMIC_RELAXED)){
+    roadcTraceRecord(ROADC_TRACE_BEGIN, pName, value);
+  }
+}
+
+void roadcTraceEnd(const char *pName,
+                   tRoadcUInt32 value){
+#ifdef ROADC_USDT
+  DTRACE_PROBE2(roadc, end, pName, value);
+#endif /* ROADC_USDT */
+  if(__atomic_load_n(&roadcTraceRecording, __ATOMIC_RELAXED)){
+    roadcTraceRecord(ROADC_TRACE_END, pName, value);
+  }
+}
+
+void roadcTraceInstant(const char *pName,
+                       tRoadcUInt32 value){
+#ifdef ROADC_USDT
+  DTRACE_PROBE2(roadc, instant, pName, value);
+#endif /* ROADC_USDT */
+  if(__atomic_load_n(&roadcTraceRecording, __ATOMIC_RELAXED)){
+    roadcTraceRecord(ROADC_TRACE_INSTANT, pName, value);
+  }
+}
+
+tRoadcTraceEventPtr roadcTraceGetEvents(tRoadcUInt32 *pNumberEvents,
+                                        tRoadcByte *pComplete){
+  tRoadcTraceEventPtr pEvents;
+
+  pthread_mutex_lock(&roadcTraceMutex);
+  pEvents = pRoadcTraceEvents;
+  if(pNumberEvents!=NULL){
+    *pNumberEvents = roadcTraceNumberEvents;
+  }
+  if(pComplete!=NULL){
+    *pComplete = roadcTraceComplete;
+  }
+  pthread_mutex_unlock(&roadcTraceMutex);
+  return pEvents;
+}
@@ -0,0 +1,382 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/** @file roadcWildcardMatch.c
+ *  @brief Containment search for arrays with padding bits.
+ *
+ *  Padding bits are wildcards, so arrays with padding byte masks can not be
+ *  searched by exact string matching. Instead the number of mismatching bits 
+ *  for all positions of an array (pattern) in another array (text) is 
+ *  calculated by correlations of the bit planes of both arrays:
+ *
+ *    mismatch(i) = sum over bits b, j: P1b(j)*T0b(i+j) + P0b(j)*T1b(i+j)
+ *
+ *  with X1b(j)=1 for bit b of byte j set and no padding bit, 
+ *       X0b(j)=1 for bit b of byte j not set and no padding bit, else 0.
+ *  The correlations are calculated by a number theoretic transform (NTT),
+ *  i.e. O(n log n) for a text of n bytes instead of O(n*m) for a pattern
+ *  of m bytes. Long texts are processed in chunks of two times the pattern size.
+ */
+
+#include "roadcInternal.h"
+
+/* NTT prime 119*2^23+1 with primitive root 3, supports transform sizes up to 2^23 */
+#define ROADC_NTT_MODULUS 998244353ULL
+#define ROADC_NTT_PRIMITIVE_ROOT 3ULL
+#define ROADC_NTT_MAX_SIZE (1UL<<23)
+
+#define ROADC_WILDCARD_MATCH_BITS 8
+
+/* minimal pattern size for the NTT based search */
+#ifndef ROADC_WILDCARD_MATCH_MIN_SIZE
+#define ROADC_WILDCARD_MATCH_MIN_SIZE 256
+#endif /* ROADC_WILDCARD_MATCH_MIN_SIZE */
+/* number of sampled positions to estimate the cost of the compare based search */
+#define ROADC_WILDCARD_MATCH_SAMPLES 16
+/* estimated cost of a NTT butterfly relative to a single byte compare */
+#define ROADC_WILDCARD_MATCH_BUTTERFLY_COST 4
+
+tRoadcUInt64 roadcNttPower(tRoadcUInt64 base,
+                           tRoadcUInt64 exponent){
+  tRoadcUInt64 result;
+  result = 1;
+  base = base % ROADC_NTT_MODULUS;
+  while(exponent>0){
+    if(exponent&1){
+      result = (result*base) % ROADC_NTT_MODULUS;
+    }
+    base = (base*base) % ROADC_NTT_MODULUS;
+    exponent = exponent>>1;
+  }
+  return result;
+}
+
+/* in place transform, size has to be a power of two */
+void roadcNtt(tRoadcUInt32 *pValues,
+              tRoadcUInt32 size,
+              tRoadcByte inverse){
+  tRoadcUInt32 i, j, k, bit, length;
+  tRoadcUInt32 tmp;
+  tRoadcUInt64 root, rootStep, u, v, sizeInverse;
+
+  /* bit reversal permutation */
+  j = 0;
+  for(i=1;i<size;i++){
+    bit = size>>1;
+    while(j&bit){
+      j = j^bit;
+      bit = bit>>1;
+    }
+    j = j^bit;
+    if(i<j){
+      tmp = pValues[i];
+      pValues[i] = pValues[j];
+      pValues[j] = tmp;
+    }
+  }
+  for(length=2;length<=size;length=length<<1){
+    rootStep = roadcNttPower(ROADC_NTT_PRIMITIVE_ROOT, (ROADC_NTT_MODULUS-1)/length);
+    if(inverse){
+      rootStep = roadcNttPower(rootStep, ROADC_NTT_MODULUS-2);
+    }
+    for(i=0;i<size;i=i+length){
+      root = 1;
+      for(k=0;k<(length>>1);k++){
+        u = pValues[i+k];
+        v = (pValues[i+k+(length>>1)]*root) % ROADC_NTT_MODULUS;
+        pValues[i+k] = (tRoadcUInt32)((u+v) % ROADC_NTT_MODULUS);
+        pValues[i+k+(length>>1)] = (tRoadcUInt32)((u+ROADC_NTT_MODULUS-v) % ROADC_NTT_MODULUS);
+        root = (root*rootStep) % ROADC_NTT_MODULUS;
+      }
+    }
+  }
+  if(inverse){
+    sizeInverse = roadcNttPower(size, ROADC_NTT_MODULUS-2);
+    for(i=0;i<size;i++){
+      pValues[i] = (tRoadcUInt32)((pValues[i]*sizeInverse) % ROADC_NTT_MODULUS);
+    }
+  }
+}
+
+tRoadcUInt32 roadcWildcardMatchTransformSize(tRoadcUInt32 patternSize){
+  tRoadcUInt32 size;
+  size = 1;
+  while(size<(2*patternSize)){
+    size = size<<1;
+  }
+  return size;
+}
+
+tRoadcUInt32 roadcWildcardMatchLog2(tRoadcUInt32 value){
+  tRoadcUInt32 result;
+  result = 0;
+  while(value>1){
+    value = value>>1;
+    result++;
+  }
+  return result;
+}
+
+/* number of equal bytes (taking padding bits into account) from the start, at most maxLength */
+tRoadcUInt32 roadcWildcardMatchPrefixLength(tRoadcDataEntryPtr pThisArray,
+                                            tRoadcDataEntryPtr pInThisArray,
+                                            tRoadcUInt32 position,
+                                            tRoadcUInt32 maxLength){
+  tRoadcUInt32 i;
+  tRoadcByte mask;
+  for(i=0;i<maxLength;i++){
+    mask = roadcPaddingByteMaskGet(pThisArray, i) | roadcPaddingByteMaskGet(pInThisArray, position+i);
+    if((pThisArray->pData[i]|mask)!=(pInThisArray->pData[position+i]|mask)){
+      return i;
+    }
+  }
+  return maxLength;
+}
+
+/* The compare based search needs about (number of positions * mean prefix length) byte compares,
+   the mean prefix length is estimated by sampling some positions.
+   return: 1: NTT based search is expected to be faster
+           0: use compare based search */
+tRoadcByte roadcWildcardMatchIsFaster(tRoadcDataEntryPtr pThisArray,
+                                      tRoadcDataEntryPtr pInThisArray){
+  tRoadcUInt32 numberOfPositions;
+  tRoadcUInt32 transformSize;
+  tRoadcUInt32 numberOfChunks;
+  tRoadcUInt64 costNtt;
+  tRoadcUInt64 costCompare;
+  tRoadcUInt32 maxPrefixLength;
+  tRoadcUInt32 i;
+
+  if((pThisArray->ppPaddingByteMaskBlocks==NULL) &&
+     (pInThisArray->ppPaddingByteMaskBlocks==NULL)){
+    /* no wildcards at all */
+    return 0;
+  }
+  if((pThisArray->size<ROADC_WILDCARD_MATCH_MIN_SIZE) ||
+     (pThisArray->size>pInThisArray->size)){
+    return 0;
+  }
+  transformSize = roadcWildcardMatchTransformSize(pThisArray->size);
+  if(transformSize>ROADC_NTT_MAX_SIZE){
+    return 0;
+  }
+  numberOfPositions = (pInThisArray->size-pThisArray->size) + 1;
+  numberOfChunks = (numberOfPositions + (transformSize-pThisArray->size)) / 
+    (transformSize-pThisArray->size+1);
+  /* per chunk: 2 transforms per bit for the text and one inverse transform,
+     plus 2 transforms per bit once for the pattern */
+  costNtt = (tRoadcUInt64)ROADC_WILDCARD_MATCH_BUTTERFLY_COST *
+    (tRoadcUInt64)(transformSize/2) * (tRoadcUInt64)roadcWildcardMatchLog2(transformSize) *
+    (tRoadcUInt64)((numberOfChunks*(2*ROADC_WILDCARD_MATCH_BITS+1)) + (2*ROADC_WILDCARD_MATCH_BITS));
+  /* prefixes longer than this make the NTT cheaper anyway */
+  maxPrefixLength = pThisArray->size;
+  if((costNtt/numberOfPositions)<(tRoadcUInt64)maxPrefixLength){
+    maxPrefixLength = (tRoadcUInt32)(costNtt/numberOfPositions);
+  }
+  costCompare = 0;
+  for(i=0;i<ROADC_WILDCARD_MATCH_SAMPLES;i++){
+    costCompare = costCompare + 1 +
+      roadcWildcardMatchPrefixLength(pThisArray, pInThisArray, 
+                                     (tRoadcUInt32)(((tRoadcUInt64)i*numberOfPositions)/ROADC_WILDCARD_MATCH_SAMPLES),
+                                     maxPrefixLength);
+  }
+  costCompare = (costCompare*numberOfPositions)/ROADC_WILDCARD_MATCH_SAMPLES;
+  if(costCompare>costNtt){
+    return 1;
+  }
+  return 0;
+}
+
+/* copy size bytes of pEntry starting at index (bytes beyond the entry are all padding bits) */
+void roadcWildcardMatchGetBytes(tRoadcDataEntryPtr pEntry,
+                                tRoadcUInt32 index,
+                                tRoadcUInt32 size,
+                                tRoadcBytePtr pData,
+                                tRoadcBytePtr pPaddingByteMask){
+  tRoadcUInt32 i;
+  tRoadcUInt32 segmentLength;
+  tRoadcBytePtr pMask;
+  i = 0;
+  while((i<size) && ((index+i)<pEntry->size)){
+    pMask = roadcPaddingByteMaskSegment(pEntry, index+i, &segmentLength);
+    if(segmentLength>(pEntry->size-(index+i))){
+      segmentLength = pEntry->size-(index+i);
+    }
+    if(segmentLength>(size-i)){
+      segmentLength = size-i;
+    }
+    while(segmentLength>0){
+      pData[i] = pEntry->pData[index+i];
+      if(pMask==NULL){
+        pPaddingByteMask[i] = ROADC_NO_PADDING_BITS;
+      } else {
+        pPaddingByteMask[i] = *pMask;
+        pMask++;
+      }
+      i++;
+      segmentLength--;
+    }
+  }
+  while(i<size){
+    pData[i] = 0;
+    pPaddingByteMask[i] = ROADC_ALL_PADDING_BITS;
+    i++;
+  }
+}
+
+/* pValues[i] = 1 for each byte i with bit set to value and no padding bit, else 0 */
+void roadcWildcardMatchBitPlane(tRoadcBytePtr pData,
+                                tRoadcBytePtr pPaddingByteMask,
+                                tRoadcUInt32 size,
+                                tRoadcUInt32 bit,
+                                tRoadcByte value,
+                                tRoadcUInt32 *pValues){
+  tRoadcUInt32 i;
+  for(i=0;i<size;i++){
+    if(((pPaddingByteMask[i]>>bit)&1)==0){
+      pValues[i] = (((pData[i]>>bit)&1)==value) ? 1 : 0;
+    } else {
+      pValues[i] = 0;
+    }
+  }
+}
+
+/* Search first position of pThisArray in pInThisArray taking padding bits and alignment into account.
+   return: 0: *pPosition is valid (pInThisArray->size: not found)
+           1: search not possible (e.g. malloc error), *pPosition not changed */
+tRoadcByte roadcWildcardMatchGetPosition(tRoadcDataEntryPtr pThisArray,
+                                         tRoadcDataEntryPtr pInThisArray,
+                                         tRoadcUInt32 *pPosition){
+  tRoadcUInt32 transformSize;
+  tRoadcUInt32 chunkStep;
+  tRoadcUInt32 chunkStart;
+  tRoadcUInt32 lastPosition;
+  tRoadcUInt32 m;
+  tRoadcUInt32 i, b;
+  tRoadcByte value;
+  tRoadcBytePtr pBuffer;
+  tRoadcBytePtr pData;
+  tRoadcBytePtr pPaddingByteMask;
+  tRoadcUInt32 *pPattern;
+  tRoadcUInt32 *pText;
+  tRoadcUInt32 *pMismatch;
+  tRoadcUInt32 *pPatternPlane;
+  tRoadcByte planeUsed[2*ROADC_WILDCARD_MATCH_BITS];
+
+  m = pThisArray->size;
+  if((m==0) || (m>pInThisArray->size)){
+    *pPosition = pInThisArray->size;
+    return 0;
+  }
+  transformSize = roadcWildcardMatchTransformSize(m);
+  if(transformSize>ROADC_NTT_MAX_SIZE){
+    return 1;
+  }
+  pBuffer = (tRoadcBytePtr)malloc(2*transformSize);
+  pPattern = (tRoadcUInt32 *)malloc((2*ROADC_WILDCARD_MATCH_BITS)*transformSize*sizeof(tRoadcUInt32));
+  pText = (tRoadcUInt32 *)malloc(transformSize*sizeof(tRoadcUInt32));
+  pMismatch = (tRoadcUInt32 *)malloc(transformSize*sizeof(tRoadcUInt32));
+  if((pBuffer==NULL) || (pPattern==NULL) || (pText==NULL) || (pMismatch==NULL)){
+    free(pBuffer);
+    free(pPattern);
+    free(pText);
+    free(pMismatch);
+    return 1;
+  }
+  pData = pBuffer;
+  pPaddingByteMask = &pBuffer[transformSize];
+
+  /* transformed bit planes of the reversed pattern, 
+     plane 2*b+value has a 1 for each byte with bit b equal to value */
+  roadcWildcardMatchGetBytes(pThisArray, 0, m, pData, pPaddingByteMask);
+  for(i=0;i<(m/2);i++){
+    value = pData[i];
+    pData[i] = pData[m-1-i];
+    pData[m-1-i] = value;
+    value = pPaddingByteMask[i];
+    pPaddingByteMask[i] = pPaddingByteMask[m-1-i];
+    pPaddingByteMask[m-1-i] = value;
+  }
+  for(b=0;b<(2*ROADC_WILDCARD_MATCH_BITS);b++){
+    pPatternPlane = &pPattern[b*transformSize];
+    roadcWildcardMatchBitPlane(pData, pPaddingByteMask, m, b/2, (tRoadcByte)(b%2), pPatternPlane);
+    planeUsed[b] = 0;
+    for(i=0;i<m;i++){
+      if(pPatternPlane[i]!=0){
+        planeUsed[b] = 1;
+      }
+    }
+    for(i=m;i<transformSize;i++){
+      pPatternPlane[i] = 0;
+    }
+    if(planeUsed[b]){
+      roadcNtt(pPatternPlane, transformSize, 0);
+    }
+  }
+
+  lastPosition = pInThisArray->size-m;
+  chunkStep = transformSize-m+1;
+  *pPosition = pInThisArray->size;
+  for(chunkStart=0;chunkStart<=lastPosition;chunkStart=chunkStart+chunkStep){
+    roadcWildcardMatchGetBytes(pInThisArray, chunkStart, transformSize, pData, pPaddingByteMask);
+    for(i=0;i<transformSize;i++){
+      pMismatch[i] = 0;
+    }
+    for(b=0;b<(2*ROADC_WILDCARD_MATCH_BITS);b++){
+      if(planeUsed[b]){
+        /* pattern bit == value has to meet text bit != value */
+        roadcWildcardMatchBitPlane(pData, pPaddingByteMask, transformSize, b/2, (tRoadcByte)(1-(b%2)), pText);
+        roadcNtt(pText, transformSize, 0);
+        pPatternPlane = &pPattern[b*transformSize];
+        for(i=0;i<transformSize;i++){
+          pMismatch[i] = (tRoadcUInt32)((pMismatch[i] + 
+                                         ((tRoadcUInt64)pText[i]*(tRoadcUInt64)pPatternPlane[i])) % ROADC_NTT_MODULUS);
+        }
+      }
+    }
+    roadcNtt(pMismatch, transformSize, 1);
+    /* correlation for position chunkStart+i is at index i+m-1 */
+    for(i=0;(i<chunkStep) && ((chunkStart+i)<=lastPosition);i++){
+      if(pMismatch[i+m-1]==0){
+        if(roadcAlignmentPositionInResultCheck(pInThisArray->alignment,
+                                               pThisArray->alignment,
+                                               chunkStart+i)){
+          *pPosition = chunkStart+i;
+          break;
+        }
+      }
+    }
+    if(*pPosition!=pInThisArray->size){
+      break;
+    }
+  }
+
+  free(pBuffer);
+  free(pPattern);
+  free(pText);
+  free(pMismatch);
+  return 0;
+}
@@ -0,0 +1,350 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/* printf() */
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "compactor.h"
+#include "commandLineParameter.h"
+#include "readInput.h"
+#include "readInputFile.h"
+#include "writeOutputFile.h"
+#include "serverMode.h"
+
+#define SERVER_MAX_LINE_SIZE 4096
+#define SERVER_MAX_CACHE_ENTRIES 64
+#define SERVER_FNV_OFFSET 0xCBF29CE484222325ULL
+#define SERVER_FNV_PRIME 0x100000001B3ULL
+
+/* calculated roadC context of an input, found by the hash of the input arrays */
+struct tServerCacheEntryStruct{
+  tRoadcPtr pRoadc;
+  tRoadcUInt32 *pPositions;
+  tRoadcUInt64 hash;
+  tRoadcUInt32 numArrays;
+  tRoadcUInt32 numBytes;
+  tRoadcUInt32 lastUse;
+};
+
+typedef struct tServerCacheEntryStruct tServerCacheEntry;
+typedef tServerCacheEntry* tServerCacheEntryPtr;
+
+static tServerCacheEntry serverCache[SERVER_MAX_CACHE_ENTRIES];
+static tRoadcUInt32 numberServerCacheEntries = 0;
+static tRoadcUInt32 serverRequestCounter = 0;
+
+tRoadcUInt64 serverHashBytes(tRoadcUInt64 hash, const tRoadcByte *pData, tRoadcUInt32 size){
+  tRoadcUInt32 i;
+
+  for(i=0; i<size; i++){
+    hash = (hash^pData[i])*SERVER_FNV_PRIME;
+  }
+  return hash;
+}
+
+tRoadcUInt64 serverHashValue(tRoadcUInt64 hash, tRoadcUInt32 value){
+  tRoadcByte bytes[4];
+
+  bytes[0] = (tRoadcByte)value;
+  bytes[1] = (tRoadcByte)(value>>8);
+  bytes[2] = (tRoadcByte)(value>>16);
+  bytes[3] = (tRoadcByte)(value>>24);
+  return serverHashBytes(hash, bytes, 4);
+}
+
+/* hash of everything the calculation depends on, array names are not part of it */
+tRoadcUInt64 serverHashInput(tInputDataPtr pInput){
+  tRoadcUInt64 hash;
+  tRoadcBytePtr pMask;
+  tRoadcUInt32 size;
+  tRoadcUInt32 i;
+
+  hash = serverHashValue(SERVER_FNV_OFFSET, getInputNumArrays(pInput));
+  for(i=0; i<getInputNumArrays(pInput); i++){
+    size = getInputArraySize(pInput, i);
+    pMask = getInputPaddingByteMaskArray(pInput, i);
+    hash = serverHashValue(hash, size);
+    hash = serverHashValue(hash, getInputArrayAlignment(pInput, i));
+    hash = serverHashBytes(hash, getInputArray(pInput, i), size);
+    hash = serverHashValue(hash, (pMask!=NULL)?1:0);
+    if(pMask!=NULL){
+      hash = serverHashBytes(hash, pMask, size);
+    }
+  }
+  return hash;
+}
+
+tServerCacheEntryPtr serverFindCacheEntry(tRoadcUInt64 hash, tInputDataPtr pInput){
+  tRoadcUInt32 i;
+
+  for(i=0; i<numberServerCacheEntries; i++){
+    if((serverCache[i].hash==hash) &&
+       (serverCache[i].numArrays==getInputNumArrays(pInput)) &&
+       (serverCache[i].numBytes==getInputNumBytes(pInput))){
+      return &serverCache[i];
+    }
+  }
+  return (tServerCacheEntryPtr)NULL;
+}
+
+/* new cache entry, the least recently used entry is replaced if the cache is full */
+tServerCacheEntryPtr serverNewCacheEntry(void){
+  tServerCacheEntryPtr pEntry;
+  tRoadcUInt32 i;
+
+  if(numberServerCacheEntries<SERVER_MAX_CACHE_ENTRIES){
+    return &serverCache[numberServerCacheEntries++];
+  }
+  pEntry = &serverCache[0];
+  for(i=1; i<numberServerCacheEntries; i++){
+    if(serverCache[i].lastUse<pEntry->lastUse){
+      pEntry = &serverCache[i];
+    }
+  }
+  roadcDelete(pEntry->pRoadc);
+  free(pEntry->pPositions);
+  return pEntry;
+}
+
+void serverSendResponse(int connection, const char *pResponse){
+  size_t remaining;
+  ssize_t numWritten;
+
+  remaining = strlen(pResponse);
+  while(remaining>0){
+    numWritten = write(connection, pResponse, remaining);
+    if(numWritten<=0){
+      /* client is gone, the next request is read from the next connection */
+      return;
+    }
+    pResponse += numWritten;
+    remaining -= (size_t)numWritten;
+  }
+}
+
+/* request: <input file> [<output file> [<binary output file>]], response: OK <original size> <compacted size> <cached> */
+void serverRequest(int connection, char *pLine){
+  char fileOut[SERVER_MAX_LINE_SIZE+8];
+  char fileOutBinary[SERVER_MAX_LINE_SIZE+8];
+  char response[SERVER_MAX_LINE_SIZE+64];
+  char *pToken[3];
+  tCompactorJob job;
+  tServerCacheEntryPtr pEntry;
+  tRoadcUInt32 *pPositions;
+  tRoadcUInt64 hash;
+  tRoadcUInt32 i;
+  FILE *fp;
+  const char *pMessage;
+  int numberTokens;
+  int cached;
+
+  pToken[0] = strtok(pLine, " \t\r\n");
+  numberTokens = 1;
+  while(numberTokens<3){
+    pToken[numberTokens] = strtok(NULL, " \t\r\n");
+    if(pToken[numberTokens]==NULL){
+      break;
+    }
+    numberTokens++;
+  }
+  if(strtok(NULL, " \t\r\n")!=NULL){
+    serverSendResponse(connection, "ERROR more than 3 file names\n");
+    return;
+  }
+  fp = fopen(pToken[0], "r");
+  if(fp==NULL){
+    snprintf(response, sizeof(response), "ERROR can not open input file %s\n", pToken[0]);
+    serverSendResponse(connection, response);
+    return;
+  }
+  fclose(fp);
+
+  job.pFileIn = pToken[0];
+  if(numberTokens>1){
+    strcpy(fileOut, pToken[1]);
+  } else {
+    sprintf(fileOut, "%s.out", pToken[0]);
+  }
+  if(numberTokens>2){
+    strcpy(fileOutBinary, pToken[2]);
+  } else {
+    sprintf(fileOutBinary, "%s.bin", pToken[0]);
+  }
+  job.pFileOut = fileOut;
+  job.pFileOutBinary = fileOutBinary;
+  job.verbose = 0;
+  job.pPositions = (tRoadcUInt32 *)NULL;
+
+  /* the input file is read for every request, binary files used by it may have changed */
+  if(readInputChecked(&job.input, job.pFileIn)!=0){
+    /* the server keeps running after an error in the input file */
+    pMessage = getReadInputErrorMessage();
+    snprintf(response, sizeof(response), "ERROR %.*s\n", (int)strcspn(pMessage, "\n"), pMessage);
+    serverSendResponse(connection, response);
+    return;
+  }
+  hash = serverHashInput(&job.input);
+  serverRequestCounter++;
+  pEntry = serverFindCacheEntry(hash, &job.input);
+  if(pEntry!=NULL){
+    cached = 1;
+    job.pRoadc = pEntry->pRoadc;
+    job.compactedDataSize = roadcGetCompactedDataSize(job.pRoadc);
+    job.compactedData = roadcGetCompactedData(job.pRoadc);
+    job.pPositions = pEntry->pPositions;
+  } else {
+    cached = 0;
+    pPositions = (tRoadcUInt32 *)malloc((getInputNumArrays(&job.input)+1)*sizeof(tRoadcUInt32));
+    if(pPositions==NULL){
+      readInputFreeArrays(&job.input);
+      serverSendResponse(connection, "ERROR not enough memory\n");
+      return;
+    }
+    compactorCalculation(&job);
+    /* the search of the array positions is kept for repeated requests */
+    for(i=0; i<getInputNumArrays(&job.input); i++){
+      pPositions[i] = getCompactedArrayPosition(&job, i);
+    }
+    job.pPositions = pPositions;
+    pEntry = serverNewCacheEntry();
+    pEntry->pRoadc = job.pRoadc;
+    pEntry->pPositions = pPositions;
+    pEntry->hash = hash;
+    pEntry->numArrays = getInputNumArrays(&job.input);
+    pEntry->numBytes = getInputNumBytes(&job.input);
+  }
+  pEntry->lastUse = serverRequestCounter;
+  writeOutputFile(&job);
+
+  snprintf(response, sizeof(response), "OK %lu %lu %d\n",
+	   getInputNumBytes(&job.input), job.compactedDataSize, cached);
+  serverSendResponse(connection, response);
+  if(clVerbose){
+    printf("%s: original data size %lu, compacted data size %lu%s\n",
+	   job.pFileIn, getInputNumBytes(&job.input), job.compactedDataSize,
+	   cached?" (cached)":"");
+    fflush(stdout);
+  }
+  readInputFreeArrays(&job.input);
+}
+
+/* one request per line until the client closes the connection, returns 1 for shutdown */
+int serverConnection(int connection){
+  char line[SERVER_MAX_LINE_SIZE];
+  FILE *fp;
+  char *pCommand;
+  int shutdown;
+
+  fp = fdopen(connection, "r");
+  if(fp==NULL){
+    close(connection);
+    return 0;
+  }
+  shutdown = 0;
+  while(fgets(line, SERVER_MAX_LINE_SIZE, fp)!=NULL){
+    if(strchr(line, '\n')==NULL){
+      serverSendResponse(connection, "ERROR request line too long\n");
+      break;
+    }
+    pCommand = line+strspn(line, " \t\r\n");
+    if(*pCommand=='\0'){
+      continue;
+    }
+    if(strncmp(pCommand, "SHUTDOWN", 8)==0){
+      serverSendResponse(connection, "OK\n");
+      shutdown = 1;
+      break;
+    }
+    serverRequest(connection, pCommand);
+  }
+  fclose(fp);
+  return shutdown;
+}
+
+void runServer(void){
+  struct sockaddr_un address;
+  int listener;
+  int connection;
+  tRoadcUInt32 i;
+
+  if(strlen(clFileServer)>=sizeof(address.sun_path)){
+    fprintf (stderr, "Socket file name %s too long.\n", clFileServer);
+    exit(0);
+  }
+  /* a client closing the connection early must not stop the server */
+  signal(SIGPIPE, SIG_IGN);
+
+  listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(listener<0){
+    fprintf (stderr, "Can not create socket %s.\n", clFileServer);
+    exit(0);
+  }
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, clFileServer);
+  unlink(clFileServer);
+  if((bind(listener, (struct sockaddr *)&address, sizeof(address))<0) ||
+     (listen(listener, 16)<0)){
+    fprintf (stderr, "Can not bind socket %s.\n", clFileServer);
+    exit(0);
+  }
+  if(clVerbose){
+    printf("compactor version 2.0\n");
+    printf("Server waiting for requests on %s...\n", clFileServer);
+    fflush(stdout);
+  }
+
+  for(;;){
+    connection = accept(listener, NULL, NULL);
+    if(connection<0){
+      continue;
+    }
+    if(serverConnection(connection)){
+      break;
+    }
+  }
+
+  close(listener);
+  unlink(clFileServer);
+  for(i=0; i<numberServerCacheEntries; i++){
+    roadcDelete(serverCache[i].pRoadc);
+    free(serverCache[i].pPositions);
+  }
+  numberServerCacheEntries = 0;
+  if(clVerbose){
+    printf("...server stopped.\n");
+  }
+}
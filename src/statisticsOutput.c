@@ -0,0 +1,100 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/* statistics report of option --stats: times of the phases of compactor and
+   of roadC, counters of the roadC kernels if roadC is compiled with them */
+
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <time.h>
+#include "statisticsOutput.h"
+#include "readInput.h"
+
+static const char *statisticsRoadcPhaseNames[ROADC_NUMBER_PHASES] = {
+  "shards", "multiple", "lower_bound", "order", "concatenation"
+};
+
+double statisticsWallTime(void){
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec/1.0e9;
+}
+
+/* processor time of all threads */
+double statisticsCpuTime(void){
+  struct timespec now;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec/1.0e9;
+}
+
+void writeStatisticsPhase(const char *pName, double wallTime, double cpuTime, int last){
+  printf("    { \"name\": \"%s\", \"wall_s\": %f, \"cpu_s\": %f }%s\n",
+	 pName, wallTime, cpuTime, last ? "" : ",");
+}
+
+void writeStatistics(tCompactorJobPtr pJob){
+  tRoadcStatistics statistics;
+  int i;
+
+  roadcGetStatistics(pJob->pRoadc, &statistics);
+  printf("{\n");
+  printf("  \"input_arrays\": %lu,\n", getInputNumArrays(&pJob->input));
+  printf("  \"input_bytes\": %lu,\n", getInputNumBytes(&pJob->input));
+  printf("  \"compacted_bytes\": %lu,\n", pJob->compactedDataSize);
+  printf("  \"phases\": [\n");
+  writeStatisticsPhase("read", pJob->wallTime[COMPACTOR_PHASE_READ], pJob->cpuTime[COMPACTOR_PHASE_READ], 0);
+  for(i=0;i<ROADC_NUMBER_PHASES;i++){
+    writeStatisticsPhase(statisticsRoadcPhaseNames[i], statistics.wallTime[i], statistics.cpuTime[i], 0);
+  }
+  writeStatisticsPhase("write", pJob->wallTime[COMPACTOR_PHASE_WRITE], pJob->cpuTime[COMPACTOR_PHASE_WRITE], 1);
+  printf("  ],\n");
+  if(!statistics.counters){
+    /* roadC compiled without ROADC_STATISTICS */
+    printf("  \"counters\": null\n");
+    printf("}\n");
+    return;
+  }
+  printf("  \"counters\": {\n");
+  printf("    \"compares\": %llu,\n", statistics.compares);
+  printf("    \"compares_rejected_first_byte\": %llu,\n", statistics.comparesRejected);
+  printf("    \"compared_bytes\": %llu,\n", statistics.comparedBytes);
+  printf("    \"overlap_hits_by_level\": [");
+  for(i=0;i<ROADC_NUMBER_OVERLAP_LEVELS;i++){
+    printf("%s%llu", (i>0) ? ", " : "", statistics.overlapHits[i]);
+  }
+  printf("],\n");
+  printf("    \"alignment_calls\": %llu,\n", statistics.alignmentCalls);
+  printf("    \"merges\": %llu,\n", statistics.merges);
+  printf("    \"allocations\": %llu,\n", statistics.allocations);
+  printf("    \"allocated_bytes\": %llu,\n", statistics.allocatedBytes);
+  printf("    \"peak_entry_bytes\": %llu\n", statistics.peakEntryBytes);
+  printf("  }\n");
+  printf("}\n");
+}
@@ -32,75 +32,102 @@ THE SOFTWARE.
 
 #include <string.h>
 #include <stdlib.h>
-#include <errno.h>
 #include "stringHandling.h"
 #include "readInputFile.h"
 
-int convertPositiveDecimal(char *str){
-  char *endPtr = NULL;
+/* value of a digit of the bases 2, 8, 10, and 16, CHAR_NO_DIGIT: no digit */
+const unsigned char charDigitValue[256] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+/* classes of the chars: CHAR_CLASS_SEPARATOR, CHAR_CLASS_VALUE_END */
+const unsigned char charClass[256] = {
+  2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 2, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  3, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 2,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* number in base 2, 8, 10, or 16 from pStart up to pEnd, like strtol(): 
+   optional sign, for base 16 optional 0x, the digits up to the first char
+   not a digit of the base; no digit: 0. Values larger than 
+   CONVERT_MAX_VALUE are not converted exactly, they are out of range anyway. */
+int convertNumber(const char *pStart, const char *pEnd, int base){
+  const unsigned char *p;
+  const unsigned char *pStop;
+  unsigned char digit;
+  int negative;
   int value;
-  
-  value = (int)strtol(str, &endPtr, 10);
-  if((value==0) &&
-     ((errno==EINVAL) || (errno==ERANGE))){
-    return -1;
-  }
-  return value;
-}
 
-int convertNegativeDecimal(char *str){
-  char *endPtr = NULL;
-  int value;
-  
-  value = (int)strtol(str, &endPtr, 10);
-  if((value==0) &&
-     ((errno==EINVAL) || (errno==ERANGE))){
-    return -1;
+  p = (const unsigned char *)pStart;
+  pStop = (const unsigned char *)pEnd;
+  negative = 0;
+  if((p<pStop)&&((*p=='+')||(*p=='-'))){
+    negative = (*p=='-');
+    p++;
   }
-  if(value>128){
-    fprintf (stderr, "Line: %d Column: %d: negative value out of range [-1..-128]: -%d.\n", getCurrentLine(), getCurrentColumn(), value);
-    exit(0);
+  if((base==16)&&(pStop-p>2)&&(p[0]=='0')&&((p[1]=='x')||(p[1]=='X'))&&
+     (charDigitValue[p[2]]!=CHAR_NO_DIGIT)){
+    p += 2;
   }
-  /* calculate two's-complement */
-  value = 256 - value;
-  return value;
-}
-
-
-
-int convertHexadecimal(char *str){
-  char *endPtr = NULL;
-  int value;
-  
-  value = (int)strtol(str, &endPtr, 16);
-  if((value==0) &&
-     ((errno==EINVAL) || (errno==ERANGE))){
-    return -1;
+  value = 0;
+  while(p<pStop){
+    digit = charDigitValue[*p];
+    if(digit>=base){
+      break;
+    }
+    if(value<=CONVERT_MAX_VALUE){
+      value = value*base + digit;
+    }
+    p++;
+  }
+  if(negative){
+    return -value;
   }
   return value;
 }
 
-int convertBinary(char *str){
-  char *endPtr = NULL;
-  int value;
-  
-  value = (int)strtol(str, &endPtr, 2);
-  if((value==0) &&
-     ((errno==EINVAL) || (errno==ERANGE))){
-    return -1;
-  }
-  return value;
+int convertPositiveDecimal(char *str){
+  return convertNumber(str, &str[strlen(str)], 10);
 }
 
-int convertOctal(char *str){
-  char *endPtr = NULL;
+/* the digits after the minus sign, return: two's-complement */
+int convertNegativeDecimal(const char *pStart, const char *pEnd){
   int value;
   
-  value = (int)strtol(str, &endPtr, 8);
-  if((value==0) &&
-     ((errno==EINVAL) || (errno==ERANGE))){
-    return -1;
+  value = convertNumber(pStart, pEnd, 10);
+  if(value>128){
+    readInputError("Line: %d Column: %d: negative value out of range [-1..-128]: -%d.\n", getCurrentLine(), getCurrentColumn(), value);
   }
+  /* calculate two's-complement */
+  value = 256 - value;
   return value;
 }
 
@@ -113,8 +140,7 @@ int convertChar(char *str){
 
   /* small a-z are not part of the charset 1  */
   if((c>='a') && (c<='z')){
-      fprintf (stderr, "Line: %d Column: %d: only charset 1 supported. Can not convert small char:%c.\n", getCurrentLine(), getCurrentColumn(), c);
-      exit(0);
+      readInputError("Line: %d Column: %d: only charset 1 supported. Can not convert small char:%c.\n", getCurrentLine(), getCurrentColumn(), c);
   }
   if((c>='A') && (c<='Z')){
     return (1 + ((int)c - (int)'A'));
@@ -203,8 +229,7 @@ int convertChar(char *str){
       break;
 
     default:
-      fprintf (stderr, "Line: %d Column: %d: can not convert char '%c'.\n", getCurrentLine(), getCurrentColumn(), c);
-      exit(0);
+      readInputError("Line: %d Column: %d: can not convert char '%c'.\n", getCurrentLine(), getCurrentColumn(), c);
       break;
   }
   return value;
@@ -0,0 +1,83 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/* trace file of option --trace: the events recorded by roadC in the Chrome
+   trace event format, open it with chrome://tracing or ui.perfetto.dev,
+   one track per thread */
+
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include "traceOutput.h"
+
+void writeTrace(char *pFileName){
+  FILE *fp;
+  tRoadcTraceEventPtr pEvents;
+  tRoadcUInt32 numberEvents;
+  tRoadcUInt32 maxThread;
+  tRoadcUInt32 i;
+  tRoadcByte complete;
+
+  pEvents = roadcTraceGetEvents(&numberEvents, &complete);
+  if(!complete){
+    fprintf (stderr, "WARNING: not enough memory for all trace events, the trace file %s is incomplete.\n", pFileName);
+  }
+
+  fp = fopen(pFileName, "w");
+  if (fp == NULL){
+    fprintf (stderr, "Can not open trace file %s.\n", pFileName);
+    exit(0);
+  }
+
+  fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  fprintf(fp, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"compactor\"}}");
+  maxThread = 0;
+  for(i=0; i<numberEvents; i++){
+    if(pEvents[i].thread>maxThread){
+      maxThread = pEvents[i].thread;
+    }
+    /* time stamps in microseconds, instant events on their thread */
+    fprintf(fp, ",\n{\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": 1, \"tid\": %lu, %s\"args\": {\"value\": %lu}}",
+	    pEvents[i].pName, pEvents[i].type, pEvents[i].time*1.0e6, pEvents[i].thread,
+	    (pEvents[i].type==ROADC_TRACE_INSTANT) ? "\"s\": \"t\", " : "", 
+	    pEvents[i].value);
+  }
+  for(i=1; i<=maxThread; i++){
+    fprintf(fp, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %lu, \"args\": {\"name\": \"thread %lu\"}}",
+	    i, i);
+  }
+  fprintf(fp, "\n]}\n");
+
+  if(fclose(fp)>0){
+    fprintf (stderr, "Can not close trace file %s.\n", pFileName);
+    exit(0);
+  }
+  roadcTraceStop();
+}
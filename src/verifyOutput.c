@@ -0,0 +1,175 @@
+/*
+The MIT License
+
+Copyright (c) 2021 MBition GmbH
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/* SPDX-License-Identifier: MIT */
+
+/* printf() */
+#ifdef __cplusplus
+#include <cstdio>
+#else
+#include <stdio.h>
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "compactor.h"
+#include "readInput.h"
+#include "verifyOutput.h"
+
+/* arrays checked by one thread at least */
+#define VERIFY_MIN_ARRAYS_PER_THREAD 1024
+
+struct tVerifyWorkerStruct{
+  tCompactorJobPtr pJob;
+  tRoadcUInt32 firstIndex;
+  tRoadcUInt32 lastIndex;
+  /* number of wrong positions and the first one */
+  tRoadcUInt32 numberErrors;
+  tRoadcUInt32 errorIndex;
+  int threadStarted;
+  pthread_t thread;
+};
+
+typedef struct tVerifyWorkerStruct tVerifyWorker;
+typedef tVerifyWorker* tVerifyWorkerPtr;
+
+/* 1 if the input array is found at its position: inside the compacted data,
+   aligned, and equal except for its padding bits */
+int verifyArray(tCompactorJobPtr pJob, tRoadcUInt32 index, tRoadcUInt32 compactedAlignment){
+  tRoadcBytePtr pData;
+  tRoadcBytePtr pPaddingByteMask;
+  tRoadcUInt32 size;
+  tRoadcUInt32 alignment;
+  tRoadcUInt32 pos;
+  tRoadcUInt32 i;
+
+  pData = getInputArray(&pJob->input, index);
+  pPaddingByteMask = getInputPaddingByteMaskArray(&pJob->input, index);
+  size = getInputArraySize(&pJob->input, index);
+  alignment = getInputArrayAlignment(&pJob->input, index);
+  pos = pJob->pPositions[index];
+  if((pos>pJob->compactedDataSize) || (size>pJob->compactedDataSize-pos)){
+    return 0;
+  }
+  /* the compacted data is placed at a multiple of its alignment */
+  if((alignment==0) || ((compactedAlignment%alignment)!=0) || ((pos%alignment)!=0)){
+    return 0;
+  }
+  if(pPaddingByteMask==NULL){
+    for(i=0; i<size; i++){
+      if(pJob->compactedData[pos+i]!=pData[i]){
+        return 0;
+      }
+    }
+  } else {
+    for(i=0; i<size; i++){
+      if(((pJob->compactedData[pos+i]^pData[i])&(tRoadcByte)~pPaddingByteMask[i])!=0){
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+void *verifyWorker(void *pArg){
+  tVerifyWorkerPtr pWorker;
+  tRoadcUInt32 compactedAlignment;
+  tRoadcUInt32 i;
+
+  pWorker = (tVerifyWorkerPtr)pArg;
+  compactedAlignment = roadcGetCompactedDataAlignment(pWorker->pJob->pRoadc);
+  for(i=pWorker->firstIndex; i<pWorker->lastIndex; i++){
+    if(!verifyArray(pWorker->pJob, i, compactedAlignment)){
+      if(pWorker->numberErrors==0){
+        pWorker->errorIndex = i;
+      }
+      pWorker->numberErrors++;
+    }
+  }
+  return NULL;
+}
+
+void verifyOutput(tCompactorJobPtr pJob){
+  tVerifyWorkerPtr pWorkers;
+  tRoadcUInt32 numArrays;
+  tRoadcUInt32 numberWorkers;
+  tRoadcUInt32 numberErrors;
+  tRoadcUInt32 errorIndex;
+  tRoadcUInt32 i;
+  long numberProcessors;
+
+  numArrays = getInputNumArrays(&pJob->input);
+  numberProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+  numberWorkers = (numberProcessors>0)?(tRoadcUInt32)numberProcessors:1;
+  if(numberWorkers>numArrays/VERIFY_MIN_ARRAYS_PER_THREAD){
+    numberWorkers = numArrays/VERIFY_MIN_ARRAYS_PER_THREAD;
+  }
+  if(numberWorkers<1){
+    numberWorkers = 1;
+  }
+  pWorkers = (tVerifyWorkerPtr)calloc(numberWorkers, sizeof(tVerifyWorker));
+  if(pWorkers==(tVerifyWorkerPtr)NULL){
+    fprintf (stderr, "Can not allocate memory for verification.\n");
+    exit(0);
+  }
+  for(i=0; i<numberWorkers; i++){
+    pWorkers[i].pJob = pJob;
+    pWorkers[i].firstIndex = (tRoadcUInt32)(((tRoadcUInt64)numArrays*i)/numberWorkers);
+    pWorkers[i].lastIndex = (tRoadcUInt32)(((tRoadcUInt64)numArrays*(i+1))/numberWorkers);
+  }
+  /* worker 0 is the calling thread, also for the workers not started */
+  for(i=1; i<numberWorkers; i++){
+    if(pthread_create(&pWorkers[i].thread, NULL, verifyWorker, &pWorkers[i])==0){
+      pWorkers[i].threadStarted = 1;
+    }
+  }
+  for(i=0; i<numberWorkers; i++){
+    if(!pWorkers[i].threadStarted){
+      verifyWorker(&pWorkers[i]);
+    }
+  }
+  numberErrors = 0;
+  errorIndex = 0;
+  for(i=0; i<numberWorkers; i++){
+    if(pWorkers[i].threadStarted){
+      pthread_join(pWorkers[i].thread, NULL);
+    }
+    if((numberErrors==0)&&(pWorkers[i].numberErrors>0)){
+      errorIndex = pWorkers[i].errorIndex;
+    }
+    numberErrors += pWorkers[i].numberErrors;
+  }
+  free(pWorkers);
+
+  if(numberErrors>0){
+    fprintf (stderr, "Verification failed: %lu of %lu input arrays not found at their position, first: %s at %lu.\n",
+             numberErrors, numArrays, getInputArrayName(&pJob->input, errorIndex),
+             (unsigned long)pJob->pPositions[errorIndex]);
+    exit(0);
+  }
+  if(pJob->verbose){
+    printf("Verification of %lu input array positions with %lu threads done.\n", numArrays, numberWorkers);
+  }
+}
@@ -36,12 +36,9 @@ THE SOFTWARE.
 #include "readInput.h"
 #include "commandLineParameter.h"
 #include "compactor.h"
+#include "verifyOutput.h"
 
-
-static tRoadcByte val;
-static FILE *fp;
-
-void writeSingleValue(void){
+void writeSingleValue(FILE *fp, tRoadcByte val){
   if(clCompressedDataFormat==CL_FORMAT_HEX){
     fprintf(fp,"$%02x", val);
   } else {
@@ -53,125 +50,174 @@ void writeSingleValue(void){
   }
 }
 
-void writeCompactedArrayBinary(void){
+void writeCompactedArrayBinary(FILE *fp, tCompactorJobPtr pJob){
   FILE *fpBin;
   size_t numWritten;
   size_t numBytes;
 
-  fprintf(fp, "!binary %c%s%c\n", '"', clFileOutBinary, '"');
+  fprintf(fp, "!binary %c%s%c\n", '"', pJob->pFileOutBinary, '"');
 
-  fpBin = fopen(clFileOutBinary, "wb");
+  fpBin = fopen(pJob->pFileOutBinary, "wb");
   if (fpBin == NULL){
-    fprintf (stderr, "Can not open binary output file %s.\n", clFileOutBinary);
+    fprintf (stderr, "Can not open binary output file %s.\n", pJob->pFileOutBinary);
     exit(0);
   }
 
-  if(compactedDataSize>1){
-    numBytes=(size_t)compactedDataSize;
-    numWritten = fwrite((void *)compactedData, 1, numBytes,fpBin);
+  if(pJob->compactedDataSize>1){
+    numBytes=(size_t)pJob->compactedDataSize;
+    numWritten = fwrite((void *)pJob->compactedData, 1, numBytes,fpBin);
     if(numWritten!=numBytes){
-      fprintf (stderr, "Write data to binary output file %s failed. %u of %u data written\n", clFileOutBinary, (unsigned int)numWritten, (unsigned int)numBytes);
+      fprintf (stderr, "Write data to binary output file %s failed. %u of %u data written\n", pJob->pFileOutBinary, (unsigned int)numWritten, (unsigned int)numBytes);
       exit(0);
     }
   }
   
   if(fclose(fpBin)>0){
-    fprintf (stderr, "Can not close binary output file %s.\n", clFileOutBinary);
+    fprintf (stderr, "Can not close binary output file %s.\n", pJob->pFileOutBinary);
     exit(0);
   }
 }
 
-void writeCompactedArrayAscii(void){
+void writeCompactedArrayAscii(FILE *fp, tCompactorJobPtr pJob){
   tRoadcUInt32 i;
 
   fprintf(fp, "!byte ");
 
-  val = compactedData[0];
-  writeSingleValue();
-  if(compactedDataSize>1){
-    for (i=1; i<compactedDataSize; i++){
+  writeSingleValue(fp, pJob->compactedData[0]);
+  if(pJob->compactedDataSize>1){
+    for (i=1; i<pJob->compactedDataSize; i++){
       fprintf(fp,", ");
-      val = compactedData[i];
-      writeSingleValue();
+      writeSingleValue(fp, pJob->compactedData[i]);
     }
   }
   fprintf(fp,"\n");
 }
 
-void writeCompactedArray(void){
+void writeCompactedArray(FILE *fp, tCompactorJobPtr pJob){
   fprintf(fp, "%s\n", clCompressedDataName);
   if(clCompressedDataFormat==CL_FORMAT_BIN){
-    writeCompactedArrayBinary();
+    writeCompactedArrayBinary(fp, pJob);
   } else {
-    writeCompactedArrayAscii();
+    writeCompactedArrayAscii(fp, pJob);
+  }
+}
+
+/* position of input array index in the compacted data */
+tRoadcUInt32 getCompactedArrayPosition(tCompactorJobPtr pJob, tRoadcUInt32 index){
+  tRoadcUInt32 pos;
+
+  if(pJob->pPositions!=NULL){
+    return pJob->pPositions[index];
   }
+  pos = roadcGetPositionInCompactedData(pJob->pRoadc, 
+					getInputArray(&pJob->input, index), 
+					getInputPaddingByteMaskArray(&pJob->input, index),
+					getInputArraySize(&pJob->input, index), 
+					getInputArrayAlignment(&pJob->input, index));
+  if(pos>=roadcGetCompactedDataSize(pJob->pRoadc)){
+    fprintf (stderr, "input array not found in compacted data - this should not happen...\n");
+    exit(0);
+  }
+  return pos;
 }
 
-void writeDataAcme(void){
+void writeDataAcme(FILE *fp, tCompactorJobPtr pJob){
   tRoadcUInt32 numArrays;
   tRoadcUInt32 pos;
   tRoadcUInt32 i;
 
-  if(clVerbose){
+  if(pJob->verbose){
     printf("Write compacted array...");
   }
-  writeCompactedArray();
-  if(clVerbose){
+  writeCompactedArray(fp, pJob);
+  if(pJob->verbose){
     printf("done.\n");
   }
 
-  numArrays = getInputNumArrays();
+  if(pJob->verbose){
+    printf("Write input array positions...");
+  }
+  numArrays = getInputNumArrays(&pJob->input);
   for(i=0; i<numArrays; i++){
-    if(clVerbose){
-      printf("\rFind and write input array position in compacted array: %lu/%lu.",i+1, numArrays);
-      fflush(stdout);
-    }
-
-    pos = roadcGetPositionInCompactedData(pRoadc, 
-					  getInputArray(i), 
-					  getInputPaddingByteMaskArray(i),
-					  getInputArraySize(i), 
-					  1);
-    if(pos==roadcGetCompactedDataSize(pRoadc)){
-      fprintf (stderr, "input array not found in compacted data - this should not happen...\n");
-      exit(0);
-    }
+    pos = pJob->pPositions[i];
 
     fprintf(fp, "%s = %s + %lu\n", 
-	    getInputArrayName(i),
+	    getInputArrayName(&pJob->input, i),
 	    clCompressedDataName, 
 	    (unsigned long)pos);
     if(strcmp((const char *)clArraySizePrefix, "")!=0){
       fprintf(fp, "%s%s = %lu\n",
-	      getInputArrayName(i),
+	      getInputArrayName(&pJob->input, i),
 	      clArraySizePrefix,
-	      getInputArraySize(i));
+	      getInputArraySize(&pJob->input, i));
     }
 	    
   }
-  if(clVerbose){
-    printf("\n");
+  if(pJob->verbose){
+    printf("done.\n");
   }
 }
 
-void writeOutputFile(void){
-  if (compactedDataSize<=0){
+void writeOutputFile(tCompactorJobPtr pJob){
+  FILE *fp;
+  tRoadcUInt32 *pPositions;
+  tRoadcUInt32 numArrays;
+  tRoadcUInt32 i;
+
+  if (pJob->compactedDataSize<=0){
     fprintf (stderr, "no compacted data given\n");
     exit(0);
   }
 
-  fp = fopen(clFileOut, "w");
+  numArrays = getInputNumArrays(&pJob->input);
+  pPositions = (tRoadcUInt32 *)NULL;
+  if(pJob->pPositions==NULL){
+    /* the positions written are searched before, also for the check */
+    pPositions = (tRoadcUInt32 *)malloc((numArrays+1)*sizeof(tRoadcUInt32));
+    if(pPositions==NULL){
+      fprintf (stderr, "Can not allocate memory for the positions of the input arrays.\n");
+      exit(0);
+    }
+    if(pJob->verbose){
+      printf("Find input array positions in compacted array...");
+    }
+    __atomic_store_n(&pJob->progressStep, COMPACTOR_STEP_POSITIONS, __ATOMIC_RELEASE);
+    roadcTraceBegin("positions", numArrays);
+    for(i=0; i<numArrays; i++){
+      pPositions[i] = getCompactedArrayPosition(pJob, i);
+      __atomic_store_n(&pJob->progressPositions, i+1, __ATOMIC_RELAXED);
+    }
+    roadcTraceEnd("positions", numArrays);
+    if(pJob->verbose){
+      printf("done.\n");
+    }
+    pJob->pPositions = pPositions;
+  }
+  if(clVerify){
+    roadcTraceBegin("verify", numArrays);
+    verifyOutput(pJob);
+    roadcTraceEnd("verify", numArrays);
+  }
+
+  fp = fopen(pJob->pFileOut, "w");
   if (fp == NULL){
-    fprintf (stderr, "Can not open output file %s.\n", clFileOut);
+    fprintf (stderr, "Can not open output file %s.\n", pJob->pFileOut);
     exit(0);
   }
 
+  __atomic_store_n(&pJob->progressStep, COMPACTOR_STEP_WRITE, __ATOMIC_RELEASE);
+  roadcTraceBegin("write", (tRoadcUInt32)pJob->compactedDataSize);
   if(clCompilerType==CL_COMPILER_ACME){
-    writeDataAcme();
+    writeDataAcme(fp, pJob);
+  }
+  roadcTraceEnd("write", (tRoadcUInt32)pJob->compactedDataSize);
+  if(pPositions!=NULL){
+    free(pPositions);
+    pJob->pPositions = (tRoadcUInt32 *)NULL;
   }
 
   if(fclose(fp)>0){
-    fprintf (stderr, "Can not close output file %s.\n", clFileOut);
+    fprintf (stderr, "Can not close output file %s.\n", pJob->pFileOut);
     exit(0);
   }
 }